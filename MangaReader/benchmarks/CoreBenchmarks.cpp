@@ -0,0 +1,453 @@
+#include "MangaReaderCore.h"
+
+#include <benchmark/benchmark.h>
+
+// Google Benchmark cases for what a page turn, a library scan and a settings change go through.
+// With --data-dir=<dir> they run on real data: the archive and conversions cases use the first
+// archive in dir, decode and scale use its first page or the first image in dir. Without it a
+// generated page and a generated 100k file directory are used and the archive cases are skipped.
+class BenchmarkData {
+public:
+	static void setDataDir(const std::wstring& dir) {
+		dataDir = dir;
+		LibraryIndex::DirectoryRecord record;
+		std::error_code ec = LibraryScanner::listDirectory(dir, record);
+		if (ec)
+		{
+			throw std::runtime_error("Could not list " + UnicodeUtils::wstringToString(dir) + ": " + ec.message());
+		}
+
+		if (!record.archives.empty())
+		{
+			archivePath = record.archives.front();
+		}
+		else if (!record.hasImages)
+		{
+			throw std::runtime_error(UnicodeUtils::wstringToString(dir) + " has no archives or images");
+		}
+	}
+
+	static const std::wstring& getDataDir() { return dataDir; }
+	static const std::wstring& getArchivePath() { return archivePath; }
+
+	// First page of the archive, else the first image of the data dir, else a generated page
+	static const std::vector<uint8_t>& getPageData() {
+		if (!pageData.empty()) return pageData;
+
+		if (!archivePath.empty())
+		{
+			ArchiveHandler archive;
+			if (!archive.openArchive(archivePath) || archive.getImageEntries().empty() || !archive.extractImageToMemory(0, pageData))
+			{
+				throw std::runtime_error("Could not read the first page of " + UnicodeUtils::wstringToString(archivePath));
+			}
+		}
+		else if (!dataDir.empty())
+		{
+			PageList pages = FileSystemHelper::listImageFiles(dataDir);
+			if (pages.empty() || !ImageLoader::readFileToMemory(pages.getFullPath(0), pageData))
+			{
+				throw std::runtime_error("Could not read the first image of " + UnicodeUtils::wstringToString(dataDir));
+			}
+		}
+		else
+		{
+			generatePage();
+		}
+		return pageData;
+	}
+
+	// The data dir, or a temporary one with 100k files that cleanUp removes
+	static const std::filesystem::path& getEnumerationDir() {
+		if (!enumerationDir.empty()) return enumerationDir;
+
+		if (!dataDir.empty())
+		{
+			enumerationDir = dataDir;
+			return enumerationDir;
+		}
+
+		std::filesystem::path target = std::filesystem::temp_directory_path() / L"manga_reader_enum_bench";
+		std::filesystem::create_directories(target);
+		for (int i = 0; i < 100000; ++i)
+		{
+			std::ofstream(target / (L"page_" + std::to_wstring(i) + (i % 10 == 0 ? L".cbz" : L".jpg")));
+		}
+		enumerationDir = target;
+		enumerationDirGenerated = true;
+		return enumerationDir;
+	}
+
+	static void cleanUp() {
+		if (enumerationDirGenerated)
+		{
+			std::error_code ec;
+			std::filesystem::remove_all(enumerationDir, ec);
+			enumerationDirGenerated = false;
+		}
+	}
+
+private:
+	static inline std::wstring dataDir;
+	static inline std::wstring archivePath;
+	static inline std::vector<uint8_t> pageData;
+	static inline std::filesystem::path enumerationDir;
+	static inline bool enumerationDirGenerated = false;
+
+	static void generatePage() {
+		// A gradient compresses about as poorly as a scanned page
+		sf::Image generated(sf::Vector2u(1600, 2400));
+		for (unsigned int y = 0; y < 2400; ++y)
+		{
+			for (unsigned int x = 0; x < 1600; ++x)
+			{
+				generated.setPixel(sf::Vector2u(x, y), sf::Color(x % 256, y % 256, (x ^ y) % 256));
+			}
+		}
+
+		std::filesystem::path generatedPath = std::filesystem::temp_directory_path() / L"manga_reader_bench_page.png";
+		bool written = generated.saveToFile(generatedPath) && ImageLoader::readFileToMemory(generatedPath.wstring(), pageData);
+		std::error_code ec;
+		std::filesystem::remove(generatedPath, ec);
+		if (!written)
+		{
+			throw std::runtime_error("Could not generate a test page");
+		}
+	}
+};
+
+// Runs a case and reports anything it throws as that case's error instead of ending the run
+template<typename Body>
+static void runGuarded(benchmark::State& state, Body&& body) {
+	try
+	{
+		body();
+	} catch (const std::exception& e)
+	{
+		state.SkipWithError(e.what());
+	}
+}
+
+static void BM_ArchiveOpen(benchmark::State& state) {
+	runGuarded(state, [&]() {
+		const std::wstring& archivePath = BenchmarkData::getArchivePath();
+		if (archivePath.empty())
+		{
+			state.SkipWithError("Needs an archive in --data-dir");
+			return;
+		}
+
+		for (auto _ : state)
+		{
+			ArchiveHandler archive;
+			if (!archive.openArchive(archivePath))
+			{
+				state.SkipWithError("Could not open the archive");
+				break;
+			}
+		}
+		});
+}
+BENCHMARK(BM_ArchiveOpen)->Unit(benchmark::kMillisecond);
+
+static void BM_ArchiveExtract(benchmark::State& state) {
+	runGuarded(state, [&]() {
+		ArchiveHandler archive;
+		if (BenchmarkData::getArchivePath().empty() || !archive.openArchive(BenchmarkData::getArchivePath()) || archive.getImageEntries().empty())
+		{
+			state.SkipWithError("Needs an archive with images in --data-dir");
+			return;
+		}
+
+		int entryCount = static_cast<int>(archive.getImageEntries().size());
+		int entry = 0;
+		std::vector<uint8_t> buffer;
+		for (auto _ : state)
+		{
+			bool extracted = archive.extractImageToMemory(entry, buffer);
+			archive.clearCache(entry);
+			if (!extracted)
+			{
+				state.SkipWithError("Could not extract an entry");
+				break;
+			}
+			entry = (entry + 1) % entryCount;
+		}
+		});
+}
+BENCHMARK(BM_ArchiveExtract)->Unit(benchmark::kMicrosecond);
+
+static void BM_Decode(benchmark::State& state) {
+	runGuarded(state, [&]() {
+		const std::vector<uint8_t>& page = BenchmarkData::getPageData();
+		for (auto _ : state)
+		{
+			if (!ImageLoader::decodeFromMemory(page.data(), page.size()).success)
+			{
+				state.SkipWithError("Could not decode the page");
+				break;
+			}
+		}
+		});
+}
+BENCHMARK(BM_Decode)->Unit(benchmark::kMillisecond);
+
+// Scales the page to half its size
+static void BM_Scale(benchmark::State& state, bool smooth) {
+	runGuarded(state, [&]() {
+		const std::vector<uint8_t>& data = BenchmarkData::getPageData();
+		ImageLoader::LoadResult page = ImageLoader::decodeFromMemory(data.data(), data.size());
+		if (!page.success || page.isStriped())
+		{
+			state.SkipWithError("Needs a page that decodes to a single image");
+			return;
+		}
+
+		sf::Vector2u half(std::max(1u, page.sourceSize.x / 2), std::max(1u, page.sourceSize.y / 2));
+		for (auto _ : state)
+		{
+			sf::Image scaled = ImageScaler::scaleImage(page.image, half, smooth);
+			benchmark::DoNotOptimize(scaled);
+		}
+		});
+}
+BENCHMARK_CAPTURE(BM_Scale, Bilinear, true)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Scale, Nearest, false)->Unit(benchmark::kMillisecond);
+
+// A config about the size of a real one, written or read synchronously
+static void BM_Config(benchmark::State& state, bool save) {
+	std::filesystem::path configPath = std::filesystem::temp_directory_path() / L"manga_reader_bench_config.ini";
+	runGuarded(state, [&]() {
+		ConfigManager config(configPath.wstring());
+		for (int i = 0; i < 100; ++i)
+		{
+			config.setString("Settings.key" + std::to_string(i), "value " + std::to_string(i));
+		}
+		if (!config.saveConfig())
+		{
+			state.SkipWithError("Could not write the config");
+			return;
+		}
+
+		for (auto _ : state)
+		{
+			if (!(save ? config.saveConfig() : config.loadConfig()))
+			{
+				state.SkipWithError(save ? "Could not write the config" : "Could not read the config");
+				break;
+			}
+		}
+		});
+	std::error_code ec;
+	std::filesystem::remove(configPath, ec);
+}
+BENCHMARK_CAPTURE(BM_Config, Save, true)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_Config, Load, false)->Unit(benchmark::kMicrosecond);
+
+static void BM_EnumerateFilesystem(benchmark::State& state) {
+	runGuarded(state, [&]() {
+		const std::filesystem::path& dir = BenchmarkData::getEnumerationDir();
+		size_t images = 0;
+		for (auto _ : state)
+		{
+			images = 0;
+			for (const auto& entry : std::filesystem::directory_iterator(dir))
+			{
+				if (entry.is_regular_file() && IsImgExtValid(entry.path().extension().native()))
+				{
+					images++;
+				}
+			}
+		}
+		state.counters["images"] = static_cast<double>(images);
+		});
+}
+BENCHMARK(BM_EnumerateFilesystem)->Unit(benchmark::kMillisecond);
+
+static void BM_EnumerateDirectoryEnumerator(benchmark::State& state) {
+	runGuarded(state, [&]() {
+		std::wstring dir = BenchmarkData::getEnumerationDir().wstring();
+		size_t images = 0;
+		for (auto _ : state)
+		{
+			images = 0;
+			std::error_code ec = DirectoryEnumerator::forEach(dir, [&](std::wstring_view name, DirectoryEnumerator::EntryType type) {
+				if (type == DirectoryEnumerator::EntryType::FILE && IsImgExtValid(DirectoryEnumerator::getExtension(name)))
+				{
+					images++;
+				}
+				});
+			if (ec)
+			{
+				state.SkipWithError(ec.message().c_str());
+				break;
+			}
+		}
+		state.counters["images"] = static_cast<double>(images);
+		});
+}
+BENCHMARK(BM_EnumerateDirectoryEnumerator)->Unit(benchmark::kMillisecond);
+
+// 100k library-like paths in scrambled order
+static std::vector<FoldersIdent> makeLibraryNames() {
+	std::vector<FoldersIdent> names;
+	names.reserve(100000);
+	for (int i = 0; i < 100000; ++i)
+	{
+		// 64-bit products, i * 104729 overflows an int
+		int series = static_cast<int>((i * 7919LL) % 2000);
+		int chapter = static_cast<int>((i * 104729LL) % 50);
+		names.emplace_back(L"D:\\Manga\\Series " + std::to_wstring(series) + L"\\Chapter " + std::to_wstring(chapter) + L".cbz", true);
+	}
+	return names;
+}
+
+static void BM_SortPlain(benchmark::State& state) {
+	std::vector<FoldersIdent> names = makeLibraryNames();
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		auto sorted = names;
+		state.ResumeTiming();
+		std::sort(sorted.begin(), sorted.end(), [](const FoldersIdent& a, const FoldersIdent& b) { return a.dir < b.dir; });
+	}
+}
+BENCHMARK(BM_SortPlain)->Unit(benchmark::kMillisecond);
+
+// Natural order parsing both names on every comparison
+static void BM_SortNaturalParsed(benchmark::State& state) {
+	std::vector<FoldersIdent> names = makeLibraryNames();
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		auto sorted = names;
+		state.ResumeTiming();
+		std::sort(sorted.begin(), sorted.end(), [](const FoldersIdent& a, const FoldersIdent& b) {
+			return NaturalSort::makeKey(a.dir) < NaturalSort::makeKey(b.dir);
+			});
+	}
+}
+BENCHMARK(BM_SortNaturalParsed)->Unit(benchmark::kMillisecond);
+
+// Natural order through precomputed keys. Keys are part of FoldersIdent, so building them counts
+// towards this one.
+static void BM_SortNaturalKeyed(benchmark::State& state) {
+	std::vector<FoldersIdent> names = makeLibraryNames();
+	for (auto _ : state)
+	{
+		std::vector<FoldersIdent> keyed;
+		keyed.reserve(names.size());
+		for (const auto& name : names)
+		{
+			keyed.emplace_back(name.dir, name.isArchieve);
+		}
+		std::sort(keyed.begin(), keyed.end());
+	}
+}
+BENCHMARK(BM_SortNaturalKeyed)->Unit(benchmark::kMillisecond);
+
+#ifdef MANGAREADER_COUNT_CONVERSIONS
+// Loads the pages of the archive, or of the data dir itself when it has no archives, the way a
+// page turn's decode does (load, file name and file size), and reports the UTF-8/UTF-16
+// conversions per page. The reader's own share of a turn (title, status and detailed info) is
+// shown as "Conversions Last Turn" in the detailed info of a counting build.
+static void BM_PageConversions(benchmark::State& state) {
+	runGuarded(state, [&]() {
+		if (BenchmarkData::getDataDir().empty())
+		{
+			state.SkipWithError("Needs --data-dir");
+			return;
+		}
+
+		ArchiveHandler archive;
+		PageList pages;
+		bool isArchive = !BenchmarkData::getArchivePath().empty();
+		if (isArchive)
+		{
+			if (!archive.openArchive(BenchmarkData::getArchivePath()))
+			{
+				state.SkipWithError("Could not open the archive");
+				return;
+			}
+			pages = FileSystemHelper::listArchivePages(BenchmarkData::getArchivePath(), archive.getImageEntries());
+		}
+		else
+		{
+			pages = FileSystemHelper::listImageFiles(BenchmarkData::getDataDir());
+		}
+		if (pages.empty())
+		{
+			state.SkipWithError("No pages to load");
+			return;
+		}
+
+		int pageCount = static_cast<int>(pages.size());
+		int page = 0;
+		size_t conversions = 0;
+		for (auto _ : state)
+		{
+			size_t before = UnicodeUtils::conversionCount;
+			ImageLoadingDispatcher::LoadContext context(isArchive, &archive, &pages, page);
+			ImageLoader::LoadResult result = ImageLoadingDispatcher::loadImageAtIndex(context);
+			std::string fileName(pages.getFileName(page));
+			std::error_code ec;
+			uintmax_t fileSize = isArchive ? archive.getImageEntries()[page].size : std::filesystem::file_size(pages.getFullPath(page), ec);
+			benchmark::DoNotOptimize(fileName);
+			benchmark::DoNotOptimize(fileSize);
+			conversions += UnicodeUtils::conversionCount - before;
+			archive.clearCache(page);
+
+			if (!result.success)
+			{
+				state.SkipWithError("Could not load a page");
+				break;
+			}
+			page = (page + 1) % pageCount;
+		}
+		state.counters["conversions"] = benchmark::Counter(static_cast<double>(conversions), benchmark::Counter::kAvgIterations);
+		});
+}
+BENCHMARK(BM_PageConversions)->Unit(benchmark::kMillisecond);
+#endif
+
+int main(int argc, char* argv[]) {
+	int exitCode = 0;
+	try
+	{
+#ifndef _WIN32
+		// libarchive converts entry names through the locale, the default C one fails on non-ASCII names
+		std::setlocale(LC_ALL, "");
+#endif
+		benchmark::Initialize(&argc, argv);
+
+		// Google Benchmark takes out its own flags, what is left is ours
+		for (int i = 1; i < argc; ++i)
+		{
+			std::string_view arg = argv[i];
+			if (!arg.starts_with("--data-dir="))
+			{
+				std::cerr << "Unknown argument " << arg << "\n"
+					<< "Usage: " << argv[0] << " [--benchmark_filter=<regex>] [--data-dir=<directory with an archive or images>]\n";
+				return 1;
+			}
+			std::string dir(arg.substr(std::string_view("--data-dir=").size()));
+#ifdef _WIN32
+			// argv is in the ANSI code page here
+			BenchmarkData::setDataDir(std::filesystem::path(dir).wstring());
+#else
+			BenchmarkData::setDataDir(UnicodeUtils::stringToWstring(dir));
+#endif
+		}
+
+		LockedMessageBox::SilentScope silent;
+		benchmark::RunSpecifiedBenchmarks();
+		benchmark::Shutdown();
+	} catch (const std::exception& e)
+	{
+		std::cerr << "Benchmark error: " << e.what() << "\n";
+		exitCode = 1;
+	}
+
+	BenchmarkData::cleanUp();
+	return exitCode;
+}
@@ -1,34 +1,6 @@
-﻿#include <SFML/Graphics.hpp>
-#include <SFML/Window.hpp>
-#include <SFML/System.hpp>
-
-#include <iostream>
-#include <filesystem>
-#include <vector>
-#include <string>
-#include <algorithm>
-#include <set>
-#include <windows.h>
-#include <commdlg.h>
-#include <shlobj.h>
-#include <objbase.h>
-#include <codecvt>
-#include <locale>
-#include <future>
-#include <fstream>
-#include <map>
-#include <shared_mutex>
-#include <psapi.h>
-
-// Define SFML_STATIC if not already defined (for static linking)
-#ifndef SFML_STATIC
-#define SFML_STATIC
-#endif
+﻿#include "MangaReaderCore.h"
 
-#include <archive.h>
-#include <archive_entry.h>
-
-#include <webp/decode.h>
+#include <SFML/Window.hpp>
 #include <CLI/CLI.hpp>
 
 class ImageSizeMismatchHandler {
@@ -135,227 +107,6 @@ public:
 	}
 };
 
-class LockedMessageBox {
-private:
-	static HWND mainWindowHandle;
-	static bool isMessageBoxActive;
-	static LONG originalWindowStyle;
-	static bool wasMaximized;
-	static RECT originalWindowRect;
-
-public:
-	// Set the main window handle (call this in your constructor)
-	static void setMainWindow(HWND hwnd) {
-		mainWindowHandle = hwnd;
-	}
-
-	// Check if message box is currently active
-	static bool isActive() {
-		return isMessageBoxActive;
-	}
-
-	// Lock the main window completely (disable moving, resizing, etc.)
-	static void lockMainWindow() {
-		if (!mainWindowHandle) return;
-
-		// Store original window state
-		wasMaximized = IsZoomed(mainWindowHandle);
-		GetWindowRect(mainWindowHandle, &originalWindowRect);
-
-		// Get current window style and store it
-		originalWindowStyle = GetWindowLongW(mainWindowHandle, GWL_STYLE);
-
-		// Remove resizing, moving, and system menu capabilities
-		LONG newStyle = originalWindowStyle;
-		newStyle &= ~(WS_SIZEBOX | WS_MAXIMIZEBOX | WS_MINIMIZEBOX);
-		newStyle &= ~WS_SYSMENU; // Remove system menu (prevents moving via title bar)
-
-		SetWindowLongW(mainWindowHandle, GWL_STYLE, newStyle);
-
-		// Disable the window completely
-		EnableWindow(mainWindowHandle, FALSE);
-
-		// Force window to stay in place
-		SetWindowPos(mainWindowHandle, HWND_NOTOPMOST,
-			originalWindowRect.left, originalWindowRect.top,
-			originalWindowRect.right - originalWindowRect.left,
-			originalWindowRect.bottom - originalWindowRect.top,
-			SWP_NOSIZE | SWP_NOMOVE | SWP_FRAMECHANGED);
-	}
-
-	// Unlock the main window and restore original state
-	static void unlockMainWindow() {
-		if (!mainWindowHandle) return;
-
-		// Restore original window style
-		SetWindowLongW(mainWindowHandle, GWL_STYLE, originalWindowStyle);
-
-		// Re-enable the window
-		EnableWindow(mainWindowHandle, TRUE);
-
-		// Restore window position and size
-		if (wasMaximized)
-		{
-			ShowWindow(mainWindowHandle, SW_MAXIMIZE);
-		}
-		else
-		{
-			SetWindowPos(mainWindowHandle, HWND_NOTOPMOST,
-				originalWindowRect.left, originalWindowRect.top,
-				originalWindowRect.right - originalWindowRect.left,
-				originalWindowRect.bottom - originalWindowRect.top,
-				SWP_FRAMECHANGED);
-		}
-
-		// Bring window back to front
-		SetForegroundWindow(mainWindowHandle);
-		SetActiveWindow(mainWindowHandle);
-	}
-
-	// Enhanced MessageBox that locks everything and stays on top
-	static int showMessageBox(const std::wstring& message, const std::wstring& title, UINT type = MB_OK | MB_ICONINFORMATION) {
-		isMessageBoxActive = true;
-
-		// Completely lock the main window
-		lockMainWindow();
-
-		int result;
-
-		// Force message box to stay on top with all possible flags
-		UINT flags = type | MB_TASKMODAL | MB_TOPMOST | MB_SETFOREGROUND | MB_SYSTEMMODAL;
-
-		if (mainWindowHandle)
-		{
-			// Show message box as modal to main window but force it to top
-			result = MessageBoxW(mainWindowHandle, message.c_str(), title.c_str(), flags);
-		}
-		else
-		{
-			// Fallback with maximum priority
-			result = MessageBoxW(NULL, message.c_str(), title.c_str(), flags);
-		}
-
-		// Unlock the main window and restore state
-		unlockMainWindow();
-
-		isMessageBoxActive = false;
-		return result;
-	}
-
-	// Convenience methods for different message types
-	static int showError(const std::wstring& message, const std::wstring& title = L"Error") {
-		return showMessageBox(message, title, MB_OK | MB_ICONERROR);
-	}
-
-	static int showWarning(const std::wstring& message, const std::wstring& title = L"Warning") {
-		return showMessageBox(message, title, MB_OK | MB_ICONWARNING);
-	}
-
-	static int showInfo(const std::wstring& message, const std::wstring& title = L"Information") {
-		return showMessageBox(message, title, MB_OK | MB_ICONINFORMATION);
-	}
-
-	static int showQuestion(const std::wstring& message, const std::wstring& title = L"Question") {
-		return showMessageBox(message, title, MB_YESNO | MB_ICONQUESTION);
-	}
-};
-
-class NavigationLockManager {
-private:
-	std::atomic<bool> isLocked;
-	std::string currentOperation;
-	std::mutex lockMutex;
-
-public:
-	NavigationLockManager() : isLocked(false), currentOperation("") { }
-
-	// Lock navigation with operation description
-	void lock(const std::string& operation = "Loading") {
-		std::lock_guard<std::mutex> guard(lockMutex);
-		isLocked = true;
-		currentOperation = operation;
-	}
-
-	// Unlock navigation
-	void unlock() {
-		std::lock_guard<std::mutex> guard(lockMutex);
-		isLocked = false;
-		currentOperation = "";
-	}
-
-	// Check if navigation is currently locked
-	bool isNavigationLocked() const {
-		return isLocked.load();
-	}
-
-	// Check if navigation is allowed (includes message box check)
-	bool isNavigationAllowed() const {
-		return !isLocked.load() && !LockedMessageBox::isActive();
-	}
-
-	// Get current operation description
-	std::string getCurrentOperation() const {
-		std::lock_guard<std::mutex> guard(const_cast<std::mutex&>(lockMutex));
-		return currentOperation;
-	}
-
-	// Force unlock (emergency use)
-	void forceUnlock() {
-		isLocked = false;
-		currentOperation = "";
-	}
-};
-
-HWND LockedMessageBox::mainWindowHandle = NULL;
-bool LockedMessageBox::isMessageBoxActive = false;
-LONG LockedMessageBox::originalWindowStyle = 0;
-bool LockedMessageBox::wasMaximized = false;
-RECT LockedMessageBox::originalWindowRect = { 0, 0, 0, 0 };
-
-// Unicode utility functions
-class UnicodeUtils {
-public:
-
-	static std::string trim(const std::string& str) {
-		size_t first = str.find_first_not_of(' ');
-		if (first == std::string::npos) return "";
-		size_t last = str.find_last_not_of(' ');
-		return str.substr(first, (last - first + 1));
-	}
-
-	static std::wstring stringToWstring(const std::string& str) {
-		if (str.empty()) return std::wstring();
-
-		int sizeNeeded = MultiByteToWideChar(CP_UTF8, 0, str.c_str(), -1, NULL, 0);
-		if (sizeNeeded <= 0) return std::wstring();
-
-		std::wstring result(sizeNeeded - 1, 0);
-		MultiByteToWideChar(CP_UTF8, 0, str.c_str(), -1, &result[0], sizeNeeded);
-		return result;
-	}
-
-	static std::string wstringToString(const std::wstring& wstr) {
-		if (wstr.empty()) return std::string();
-
-		int sizeNeeded = WideCharToMultiByte(CP_UTF8, 0, wstr.c_str(), -1, NULL, 0, NULL, NULL);
-		if (sizeNeeded <= 0) return std::string();
-
-		std::string result(sizeNeeded - 1, 0);
-		WideCharToMultiByte(CP_UTF8, 0, wstr.c_str(), -1, &result[0], sizeNeeded, NULL, NULL);
-		return result;
-	}
-
-	static sf::String stringToSFString(const std::string& str) {
-		std::wstring wstr = stringToWstring(str);
-		return sf::String(wstr);
-	}
-
-	static std::string getFilenameOnly(const std::string& path) {
-		std::filesystem::path p(stringToWstring(path));
-		return wstringToString(p.filename().wstring());
-	}
-};
-
 class sf_text_wrapper {
 private:
 	std::unique_ptr<sf::Text> text;
@@ -426,2239 +177,1558 @@ public:
 	sf::Font* get() { return this->font.get(); };
 };
 
-std::string wrapText(const std::string& str, const sf::Font& font, unsigned int charSize, float maxWidth) {
-	std::istringstream words(str);
-	std::string word;
-	std::string wrapped;
-	sf_text_wrapper temp;
-	temp.initialize(font, charSize);
-
-	float lineWidth = 0.f;
-
-	while (words >> word)
-	{
-		std::string testLine = word + " ";
-		temp.get()->setString(testLine);
-
-		float wordWidth = temp.get()->getLocalBounds().size.x;
-
-		if (lineWidth + wordWidth > maxWidth)
-		{
-			wrapped += "\n";  // start new line
-			lineWidth = 0.f;
-		}
-
-		wrapped += word + " ";
-		lineWidth += wordWidth;
-	}
-
-	return wrapped;
-}
-
-struct ArchiveEntry {
-	std::string name;
-	size_t size;
-	int index; // Index in archive
-};
+// Word-wraps UTF-8 text using cached glyph advances instead of measuring through sf::Text.
+// Finished layouts are memoized, so re-wrapping an unchanged path or file name is a lookup.
+// Glyph tables are keyed by font address, which is stable: the reader loads its one font once.
+// UI thread only.
+class TextLayoutCache {
+private:
+	struct GlyphTable {
+		std::array<float, 128> asciiAdvances;
+		std::unordered_map<uint32_t, float> otherAdvances;
+	};
 
-//TODO : L".tif", L".tiff"
-static constexpr std::array<const char*, 7u> supportedExtensions = {
-	".jpg", ".jpeg", ".png", ".bmp", ".tga", ".gif", ".webp"
-};
+	struct CachedLayout {
+		std::string key;
+		std::string wrapped;
+	};
 
-static constexpr std::array<const char*, 8u> supportedArchives = {
-	 ".zip", ".cbz", ".rar", ".cbr", ".7z", ".cb7", ".tar", ".gz"
-};
+	std::map<std::pair<const sf::Font*, unsigned int>, GlyphTable> glyphTables;
+	// Most recently used first; the index keys view into the list nodes, which never move
+	std::list<CachedLayout> layouts;
+	std::unordered_map<std::string_view, std::list<CachedLayout>::iterator> layoutIndex;
+	size_t hits;
+	size_t misses;
 
-bool IsImgExtValid(const std::string& ext) {
-	std::string cpy = ext;
-	std::transform(cpy.begin(), cpy.end(), cpy.begin(), ::tolower);
-	for (auto& supp : supportedExtensions)
-	{
-		if (cpy == supp)
-		{
-			return true;
-		}
-	}
+	// Cheap bound; the detailed info panel only ever has a handful of live strings
+	static constexpr size_t MAX_CACHED_LAYOUTS = 512;
 
-	return false;
-}
+	TextLayoutCache() : glyphTables(), layouts(), layoutIndex(), hits(0), misses(0) { }
 
-class ErrorDisplayHelper {
 public:
-	enum class ErrorType {
-		CRITICAL,
-		WARNING,
-		INFO,
-		MEMORY,
-		CORRUPTION
-	};
-
-	struct ErrorContext {
-		std::wstring archivePath;
-		std::string operation;
-		std::string details;
-		size_t memorySize = 0;
-		int entryIndex = -1;
-		std::string fileName;
-
-		ErrorContext& setArchive(const std::wstring& path) { archivePath = path; return *this; }
-		ErrorContext& setOperation(const std::string& op) { operation = op; return *this; }
-		ErrorContext& setDetails(const std::string& det) { details = det; return *this; }
-		ErrorContext& setMemorySize(size_t size) { memorySize = size; return *this; }
-		ErrorContext& setEntry(int index, const std::string& file) {
-			entryIndex = index;
-			fileName = file;
-			return *this;
-		}
-	};
+	static TextLayoutCache& instance() {
+		static TextLayoutCache cache;
+		return cache;
+	}
 
-	static void showError(ErrorType type, const ErrorContext& context) {
-		std::wstring message;
-		std::wstring title;
+	std::string wrap(const std::string& str, const sf::Font& font, unsigned int charSize, float maxWidth) {
+		std::string key = std::to_string(reinterpret_cast<uintptr_t>(&font)) + ':' + std::to_string(charSize) + ':' +
+			std::to_string(static_cast<int>(maxWidth)) + ':' + str;
 
-		switch (type)
+		auto it = layoutIndex.find(key);
+		if (it != layoutIndex.end())
 		{
-		case ErrorType::CRITICAL:
-			message = L"CRITICAL ARCHIVE ERROR\n\n";
-			title = L"Archive Error";
-			break;
-		case ErrorType::WARNING:
-			message = L"ARCHIVE ERROR (Skipping):\n\n";
-			title = L"Archive Skipped";
-			break;
-		case ErrorType::MEMORY:
-			message = L"MEMORY ERROR\n\n";
-			title = L"Memory Error";
-			appendMemoryInfo(message, context);
-			break;
-		case ErrorType::CORRUPTION:
-			message = L"IMAGE CORRUPTION DETECTED\n\n";
-			title = L"Image Corruption";
-			appendCorruptionInfo(message, context);
-			break;
+			++hits;
+			layouts.splice(layouts.begin(), layouts, it->second);
+			return it->second->wrapped;
 		}
 
-		// Common fields
-		if (!context.archivePath.empty())
-		{
-			message += L"Archive: " + context.archivePath + L"\n";
-		}
-		if (!context.operation.empty())
-		{
-			message += L"Operation: " + UnicodeUtils::stringToWstring(context.operation) + L"\n";
-		}
-		if (!context.details.empty())
+		++misses;
+		if (layouts.size() >= MAX_CACHED_LAYOUTS)
 		{
-			message += L"Error: " + UnicodeUtils::stringToWstring(context.details) + L"\n\n";
+			layoutIndex.erase(layouts.back().key);
+			layouts.pop_back();
 		}
 
-		// Type-specific suffixes
-		switch (type)
-		{
-		case ErrorType::CRITICAL:
-			message += L"This archive may be corrupted or incompatible.";
-			LockedMessageBox::showError(message, title);
-			break;
-		case ErrorType::WARNING:
-			message += L"This archive will be skipped and the next one will be tried.";
-			LockedMessageBox::showWarning(message, title);
-			break;
-		default:
-			LockedMessageBox::showWarning(message, title);
-			break;
-		}
+		std::string wrapped = layout(str, getGlyphTable(font, charSize), font, charSize, maxWidth);
+		layouts.push_front(CachedLayout{ std::move(key), wrapped });
+		layoutIndex.emplace(layouts.front().key, layouts.begin());
+		return wrapped;
 	}
 
-private:
-	static void appendMemoryInfo(std::wstring& message, const ErrorContext& context) {
-		if (context.memorySize > 0)
-		{
-			message += L"Requested Size: " + std::to_wstring(context.memorySize / 1024 / 1024) + L" MB\n\n";
-		}
-
-		MEMORYSTATUSEX memInfo;
-		memInfo.dwLength = sizeof(MEMORYSTATUSEX);
-		if (GlobalMemoryStatusEx(&memInfo))
-		{
-			message += L"Available Memory: " + std::to_wstring(memInfo.ullAvailPhys / 1024 / 1024) + L" MB\n";
-			message += L"Total Memory: " + std::to_wstring(memInfo.ullTotalPhys / 1024 / 1024) + L" MB\n\n";
-		}
+	size_t getHitCount() const { return hits; }
+	size_t getMissCount() const { return misses; }
 
-		message += L"The image is too large or system is low on memory.\n";
-		message += L"Try closing other applications or skip this image.";
+private:
+	static bool isSpace(char c) {
+		return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
 	}
 
-	static void appendCorruptionInfo(std::wstring& message, const ErrorContext& context) {
-		if (!context.fileName.empty())
+	GlyphTable& getGlyphTable(const sf::Font& font, unsigned int charSize) {
+		auto key = std::make_pair(&font, charSize);
+		auto it = glyphTables.find(key);
+		if (it != glyphTables.end())
 		{
-			message += L"Image: " + UnicodeUtils::stringToWstring(context.fileName) + L"\n";
+			return it->second;
 		}
-		if (context.entryIndex >= 0)
+
+		GlyphTable table;
+		for (uint32_t c = 0; c < table.asciiAdvances.size(); ++c)
 		{
-			message += L"Entry Index: " + std::to_wstring(context.entryIndex) + L"\n\n";
+			table.asciiAdvances[c] = font.getGlyph(c, charSize, false).advance;
 		}
-		message += L"This image appears to be corrupted and will be skipped.";
+		return glyphTables.emplace(key, std::move(table)).first->second;
 	}
-};
-
-class ImageLoader {
-public:
-	struct LoadResult {
-		sf::Image image;
-		bool success;
-		std::string errorMessage;
-
-		LoadResult() : image() , success(false) { }
-		LoadResult(sf::Image img) : image(std::move(img)), success(true) { }
-		LoadResult(const std::string& error) : image(), success(false), errorMessage(error) { }
-	};
 
-	// Unified image loading from file or memory
-	static LoadResult loadImage(const std::wstring& filePath) {
-		try
+	static float advance(GlyphTable& table, const sf::Font& font, unsigned int charSize, uint32_t codepoint) {
+		if (codepoint < table.asciiAdvances.size())
 		{
-			sf::Image image;
-			std::string filename = UnicodeUtils::wstringToString(filePath);
+			return table.asciiAdvances[codepoint];
+		}
 
-			if (isWebPFile(filename))
-			{
-				if (loadWebPFromFile(filePath, image))
-				{
-					return LoadResult(std::move(image));
-				}
-			}
-			else
-			{
-				if (image.loadFromFile(filePath))
-				{
-					return LoadResult(std::move(image));
-				}
-			}
-			return LoadResult("Failed to load image: " + filename);
-		} catch (const std::exception& e)
+		auto it = table.otherAdvances.find(codepoint);
+		if (it != table.otherAdvances.end())
 		{
-			return LoadResult("Exception loading image: " + std::string(e.what()));
+			return it->second;
 		}
+
+		float width = font.getGlyph(codepoint, charSize, false).advance;
+		table.otherAdvances.emplace(codepoint, width);
+		return width;
 	}
 
-	static LoadResult loadImageFromMemory(const std::vector<uint8_t>& data, const std::string& filename) {
-		try
-		{
-			sf::Image image;
+	// Decodes one UTF-8 sequence starting at pos and advances pos past it
+	static uint32_t nextCodepoint(const std::string& str, size_t& pos) {
+		uint8_t lead = static_cast<uint8_t>(str[pos++]);
+		int extra = lead >= 0xF0 ? 3 : lead >= 0xE0 ? 2 : lead >= 0xC0 ? 1 : 0;
+		uint32_t codepoint = extra == 3 ? (lead & 0x07) : extra == 2 ? (lead & 0x0F) : extra == 1 ? (lead & 0x1F) : lead;
 
-			if (isWebPFile(filename))
-			{
-				if (loadWebPFromMemory(data, image))
-				{
-					return LoadResult(std::move(image));
-				}
-			}
-			else
-			{
-				if (image.loadFromMemory(data.data(), data.size()))
-				{
-					return LoadResult(std::move(image));
-				}
-			}
-			return LoadResult("Failed to decode image data: " + filename);
-		} catch (const std::exception& e)
+		for (int i = 0; i < extra && pos < str.size(); ++i)
 		{
-			return LoadResult("Exception decoding image: " + std::string(e.what()));
+			codepoint = (codepoint << 6) | (static_cast<uint8_t>(str[pos++]) & 0x3F);
 		}
+		return codepoint;
 	}
 
-	static bool isWebPFile(const std::string& filename) {
-		std::filesystem::path path(filename);
-		std::string extension = path.extension().string();
-		std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
-		return extension == ".webp";
-	}
-
-	// These would be your existing WebP loading functions - kept here for completeness
-	static bool loadWebPFromFile(const std::wstring& filePath, sf::Image& image, int sizeLimit = 100 * 1024 * 1024) {
+	// Same rules as before: words separated by whitespace, each followed by one space,
+	// and a line break inserted before a word that would overflow maxWidth
+	static std::string layout(const std::string& str, GlyphTable& table, const sf::Font& font, unsigned int charSize, float maxWidth) {
+		const float spaceWidth = advance(table, font, charSize, ' ');
+		std::string wrapped;
+		wrapped.reserve(str.size() + str.size() / 16);
 
-		try
+		float lineWidth = 0.f;
+		size_t pos = 0;
+		while (pos < str.size())
 		{
-			std::ifstream file(filePath, std::ios::binary | std::ios::ate);
-
-			if (!file.is_open() || !file.good())
-			{
-				throw std::runtime_error("Failed to open WebP file: " + UnicodeUtils::wstringToString(filePath));
-			}
+			while (pos < str.size() && isSpace(str[pos])) ++pos;
+			if (pos >= str.size()) break;
 
-			std::streamsize size = file.tellg();
-			if (size <= 0)
+			size_t wordStart = pos;
+			float wordWidth = spaceWidth;
+			while (pos < str.size() && !isSpace(str[pos]))
 			{
-				file.close();
-				throw std::runtime_error("WebP file is empty or invalid size: " + UnicodeUtils::wstringToString(filePath));
+				wordWidth += advance(table, font, charSize, nextCodepoint(str, pos));
 			}
 
-			if (size >= sizeLimit)
+			if (lineWidth + wordWidth > maxWidth)
 			{
-				file.close();
-				throw std::runtime_error("WebP file too large (>100MB): " + UnicodeUtils::wstringToString(filePath));
+				wrapped += "\n";  // start new line
+				lineWidth = 0.f;
 			}
 
-			file.seekg(0, std::ios::beg);
-			if (!file.good())
-			{
-				file.close();
-				throw std::runtime_error("Failed to seek in WebP file: " + UnicodeUtils::wstringToString(filePath));
-			}
+			wrapped.append(str, wordStart, pos - wordStart);
+			wrapped += ' ';
+			lineWidth += wordWidth;
+		}
 
-			std::vector<uint8_t> buffer(static_cast<size_t>(size));
-			if (!file.read(reinterpret_cast<char*>(buffer.data()), size) || file.gcount() != size)
-			{
-				file.close();
-				throw std::runtime_error("Failed to read WebP file completely: " + UnicodeUtils::wstringToString(filePath));
-			}
+		return wrapped;
+	}
+};
 
-			file.close();
+std::string wrapText(const std::string& str, const sf::Font& font, unsigned int charSize, float maxWidth) {
+	return TextLayoutCache::instance().wrap(str, font, charSize, maxWidth);
+}
 
-			if (!loadWebPFromMemory(buffer, image))
-			{
-				throw std::runtime_error("Failed to decode WebP data: " + UnicodeUtils::wstringToString(filePath));
-			}
+enum class ButtonID {
+	INFO_BUTTON,
+	PREVIOUS_FOLDER,
+	NEXT_FOLDER,
+	SETTINGS_BUTTON,
+	HELP_BUTTON,
+	DELETE_BUTTON,
+	COUNT
+};
 
-			return true;
+// Retained overlay elements, drawn back to front in this order
+enum class OverlayPanel {
+	STATUS,
+	DETAILED_INFO,
+	HELP,
+	MEMORY_WARNING,
+	MEMORY_HOVER,
+	NAVIGATION_LOCK,
+	LOADING,
+	COUNT
+};
 
-		} catch (const std::exception& e)
-		{
-			throw std::runtime_error("WebP loading error: " + std::string(e.what()));
-		}
-	}
+enum class SessionChoice {
+	RESTORE_SESSION,
+	NEW_SESSION,
+	CANCELLED
+};
 
-	static bool loadWebPFromMemory(const std::vector<uint8_t>& data, sf::Image& image) {
-		int width, height;
+// Solid-colour UI geometry kept in one vertex array; rebuilt only when its content changes
+class OverlayGeometry {
+private:
+	sf::VertexArray vertices;
 
-		uint8_t* decoded = WebPDecodeRGBA(data.data(), data.size(), &width, &height);
+public:
+	OverlayGeometry() : vertices(sf::PrimitiveType::Triangles) { }
 
-		if (!decoded)
-		{
-			return false;
-		}
+	void clear() { vertices.clear(); }
 
-		image = sf::Image(sf::Vector2u(width, height), decoded);
-		WebPFree(decoded);
+	bool isEmpty() const { return vertices.getVertexCount() == 0; }
 
-		return true;
+	void addRect(const sf::FloatRect& rect, sf::Color color) {
+		sf::Vector2f topLeft = rect.position;
+		sf::Vector2f bottomRight = rect.position + rect.size;
+		addTriangle(topLeft, sf::Vector2f(bottomRight.x, topLeft.y), bottomRight, color);
+		addTriangle(topLeft, bottomRight, sf::Vector2f(topLeft.x, bottomRight.y), color);
 	}
 
-};
-
-class NavigationHelper {
-public:
-	static bool canNavigate(const NavigationLockManager& navLock) {
-		return navLock.isNavigationAllowed() && !LockedMessageBox::isActive();
-	}
+	// The outline sits outside the rectangle, like sf::RectangleShape
+	void addOutlinedRect(const sf::FloatRect& rect, sf::Color fill, float thickness, sf::Color outline) {
+		addRect(rect, fill);
+		if (thickness <= 0.0f) return;
 
-	static bool executeIfNavigationAllowed(const NavigationLockManager& navLock,
-		const std::function<void()>& action) {
-		if (canNavigate(navLock))
-		{
-			action();
-			return true;
-		}
-		return false;
+		const float x = rect.position.x;
+		const float y = rect.position.y;
+		const float w = rect.size.x;
+		const float h = rect.size.y;
+		addRect(sf::FloatRect({ x - thickness, y - thickness }, { w + thickness * 2, thickness }), outline);
+		addRect(sf::FloatRect({ x - thickness, y + h }, { w + thickness * 2, thickness }), outline);
+		addRect(sf::FloatRect({ x - thickness, y }, { thickness, h }), outline);
+		addRect(sf::FloatRect({ x + w, y }, { thickness, h }), outline);
 	}
-};
 
-class FileSystemHelper {
-public:
-	static std::string getFileSizeString(size_t fileSize) {
-		if (fileSize < 1024)
+	void addCircle(sf::Vector2f center, float radius, sf::Color color, int segments = 30) {
+		const float step = 2.0f * 3.14159265f / static_cast<float>(segments);
+		for (int i = 0; i < segments; ++i)
 		{
-			return std::to_string(fileSize) + " B";
-		}
-		else if (fileSize < 1024 * 1024)
-		{
-			return std::to_string(fileSize / 1024) + " KB";
-		}
-		else
-		{
-			return std::to_string(fileSize / (1024 * 1024)) + " MB";
+			sf::Vector2f a(center.x + radius * std::cos(step * i), center.y + radius * std::sin(step * i));
+			sf::Vector2f b(center.x + radius * std::cos(step * (i + 1)), center.y + radius * std::sin(step * (i + 1)));
+			addTriangle(center, a, b, color);
 		}
 	}
 
-	static std::string getFileSizeString(const std::wstring& filePath) {
-		try
-		{
-			auto fileSize = std::filesystem::file_size(filePath);
-			return getFileSizeString(static_cast<size_t>(fileSize));
-		} catch (...)
+	void draw(sf::RenderWindow& window) const {
+		if (!isEmpty())
 		{
-			return "Unknown";
+			window.draw(vertices);
 		}
 	}
 
-	static std::string extractFilenameFromPath(const std::wstring& path, bool isArchive = false) {
-		if (isArchive)
-		{
-			std::string filename = UnicodeUtils::wstringToString(path);
-			size_t hashPos = filename.find('#');
-			if (hashPos != std::string::npos)
-			{
-				filename = filename.substr(hashPos + 1);
-			}
-			std::filesystem::path p(filename);
-			return p.filename().string();
-		}
-		else
-		{
-			return UnicodeUtils::getFilenameOnly(UnicodeUtils::wstringToString(path));
-		}
+private:
+	void addTriangle(sf::Vector2f a, sf::Vector2f b, sf::Vector2f c, sf::Color color) {
+		vertices.append(sf::Vertex{ a, color });
+		vertices.append(sf::Vertex{ b, color });
+		vertices.append(sf::Vertex{ c, color });
 	}
 };
 
-struct PathLimitChecker {
-
-	static bool isRunningAsAdmin() {
-		BOOL isAdmin = FALSE;
-		HANDLE hToken = NULL;
-
-		if (OpenProcessToken(GetCurrentProcess(), TOKEN_QUERY, &hToken))
-		{
-			TOKEN_ELEVATION elevation;
-			DWORD cbSize = sizeof(TOKEN_ELEVATION);
+class UIButton {
+public:
+	struct ButtonConfig {
+		std::string text = "?";
+		sf::Color backgroundColor = sf::Color(100, 100, 100, 200);
+		sf::Color textColor = sf::Color::White;
+		sf::Color outlineColor = sf::Color::White;
+		sf::Color disabledBgColor = sf::Color(60, 60, 60, 150);
+		sf::Color disabledTextColor = sf::Color(150, 150, 150);
+		bool hasCircularBg = true;
+		unsigned int fontSize = 18;
+	};
 
-			if (GetTokenInformation(hToken, TokenElevation, &elevation, sizeof(elevation), &cbSize))
-			{
-				isAdmin = elevation.TokenIsElevated;
-			}
-			CloseHandle(hToken);
-		}
-
-		return isAdmin == TRUE;
-	}
-
-	static bool enableLongPathSupport() {
-		if (!isRunningAsAdmin())
-		{
-			return false; // Need admin privileges
-		}
-
-		HKEY hKey;
-		LONG result = RegOpenKeyExW(
-			HKEY_LOCAL_MACHINE,
-			L"SYSTEM\\CurrentControlSet\\Control\\FileSystem",
-			0,
-			KEY_SET_VALUE,
-			&hKey
-		);
-
-		if (result == ERROR_SUCCESS)
-		{
-			DWORD value = 1;
-			result = RegSetValueExW(
-				hKey,
-				L"LongPathsEnabled",
-				0,
-				REG_DWORD,
-				reinterpret_cast<const BYTE*>(&value),
-				sizeof(DWORD)
-			);
-
-			RegCloseKey(hKey);
-			return (result == ERROR_SUCCESS);
-		}
-
-		return false;
-	}
-
-	static bool isLongPathSupportEnabled() {
-		HKEY hKey;
-		DWORD dwValue = 0;
-		DWORD dwSize = sizeof(DWORD);
-
-		// Open the registry key
-		LONG result = RegOpenKeyExW(
-			HKEY_LOCAL_MACHINE,
-			L"SYSTEM\\CurrentControlSet\\Control\\FileSystem",
-			0,
-			KEY_READ,
-			&hKey
-		);
-
-		if (result == ERROR_SUCCESS)
-		{
-			// Query the LongPathsEnabled value
-			result = RegQueryValueExW(
-				hKey,
-				L"LongPathsEnabled",
-				nullptr,
-				nullptr,
-				reinterpret_cast<LPBYTE>(&dwValue),
-				&dwSize
-			);
-
-			RegCloseKey(hKey);
-
-			if (result == ERROR_SUCCESS)
-			{
-				return (dwValue == 1);
-			}
-		}
-
-		return false; // Default to disabled if can't read
-	}
-
-	static void showPathLimitInfo() {
-		bool longPathsEnabled = PathLimitChecker::isLongPathSupportEnabled();
-		bool isAdmin = PathLimitChecker::getIsRunningAsAdmin();
-
-		std::wstring message = L"PATH LENGTH INFORMATION:\n\n";
-		message += L"Current Path Limit: " + std::to_wstring(PathLimitChecker::getMaxPathLength()) + L" characters\n";
-		message += L"Long Path Support: " + std::wstring(longPathsEnabled ? L"ENABLED" : L"DISABLED") + L"\n";
-		message += L"Running as Administrator: " + std::wstring(isAdmin ? L"YES" : L"NO") + L"\n\n";
-
-		if (!longPathsEnabled)
-		{
-			if (isAdmin)
-			{
-				message += L"Long path support can be enabled automatically.\n";
-				message += L"Click 'YES' to enable it now, or 'NO' for manual instructions.";
-
-				int result = LockedMessageBox::showQuestion(message, L"Enable Long Path Support?");
+private:
+	ButtonID buttonID;
+	sf::Color fillColor;
+	sf::Color outlineColor;
+	sf::Color circleColor;
+	sf_text_wrapper buttonText;
+	sf::Vector2f position;
+	float size;
+	bool isEnabled;
+	bool hasToggleState;
+	bool isToggled;
+	ButtonConfig config;
 
-				if (result == IDYES)
-				{
-					if (PathLimitChecker::tryEnableLongPaths())
-					{
-						LockedMessageBox::showInfo(
-							L"Long path support has been enabled successfully!\n\n"
-							L"Note: You may need to restart the application for changes to take full effect.",
-							L"Success"
-						);
-					}
-					else
-					{
-						LockedMessageBox::showError(
-							L"Failed to enable long path support.\n"
-							L"Please enable it manually using the instructions below.",
-							L"Enable Failed"
-						);
-						showManualInstructions();
-					}
-				}
-				else
-				{
-					showManualInstructions();
-				}
-			}
-			else
-			{
-				message += L"To enable long path support, administrator privileges are required.\n";
-				message += L"Click 'YES' to restart as administrator, or 'NO' for manual instructions.";
+public:
 
-				int result = LockedMessageBox::showQuestion(message, L"Restart as Administrator?");
+	UIButton() : buttonID(ButtonID::INFO_BUTTON), fillColor(), outlineColor(), circleColor(), buttonText(),
+		position(0, 0), size(30.0f), isEnabled(true), hasToggleState(false),
+		isToggled(false), config() { }
 
-				if (result == IDYES)
-				{
-					if (PathLimitChecker::restartAsAdmin())
-					{
-						// Application will restart with elevation
-						std::exit(0);
-					}
-					else
-					{
-						LockedMessageBox::showError(
-							L"Failed to restart with administrator privileges.\n"
-							L"Please run the application as administrator manually.",
-							L"Elevation Failed"
-						);
-					}
-				}
-				else
-				{
-					showManualInstructions();
-				}
-			}
-		}
-		else
-		{
-			LockedMessageBox::showInfo(message, L"Path Length Settings");
-		}
-	}
+	// Delete copy constructor and copy assignment
+	UIButton(const UIButton&) = delete;
+	UIButton& operator=(const UIButton&) = delete;
 
-	static void showManualInstructions() {
-		std::wstring message = L"MANUAL SETUP INSTRUCTIONS:\n\n";
-		message += L"Method 1 - Group Policy Editor:\n";
-		message += L"1. Press Win+R, type 'gpedit.msc', press Enter\n";
-		message += L"2. Navigate to: Computer Configuration > Administrative Templates > System > Filesystem\n";
-		message += L"3. Double-click 'Enable NTFS long paths'\n";
-		message += L"4. Select 'Enabled', click OK\n";
-		message += L"5. Restart this application\n\n";
+	// Add move constructor and move assignment
+	UIButton(UIButton&&) = default;
+	UIButton& operator=(UIButton&&) = default;
 
-		message += L"Method 2 - Registry Editor:\n";
-		message += L"1. Press Win+R, type 'regedit', press Enter\n";
-		message += L"2. Navigate to: HKEY_LOCAL_MACHINE\\SYSTEM\\CurrentControlSet\\Control\\FileSystem\n";
-		message += L"3. Create or modify DWORD: LongPathsEnabled\n";
-		message += L"4. Set value to: 1\n";
-		message += L"5. Restart this application\n\n";
+	void initialize(const sf::Font& font, ButtonID id, float x, float y,
+		const ButtonConfig& buttonConfig, float buttonSize = 30.0f) {
+		buttonID = id;
+		config = buttonConfig;
+		size = buttonSize;
+		position = sf::Vector2f(x, y);
 
-		message += L"Method 3 - Command Line (Run as Administrator):\n";
-		message += L"reg add \"HKLM\\SYSTEM\\CurrentControlSet\\Control\\FileSystem\" /v LongPathsEnabled /t REG_DWORD /d 1";
+		// Setup text
+		buttonText.initialize(font, config.fontSize);
+		buttonText.get()->setString(config.text);
+		buttonText.get()->setStyle(sf::Text::Bold);
 
-		LockedMessageBox::showInfo(message, L"Manual Setup Instructions");
+		// Set initial appearance
+		updateAppearance();
+		centerText();
 	}
 
-	static size_t getMaxComponentLength() {
-		// Component length limit doesn't change
-		return 255;
+	void updatePosition(float x, float y) {
+		position = sf::Vector2f(x, y);
+		centerText();
 	}
 
-	static size_t getMaxPathLength() {
-		if (isLongPathSupportEnabled())
-		{
-			return 32767;
-		}
-		else
-		{
-			return 260;
-		}
+	void setEnabled(bool enabled) {
+		isEnabled = enabled;
+		updateAppearance();
 	}
 
-	static size_t getSafePathLength() {
-		size_t maxPath = getMaxPathLength();
-		return maxPath > 260 ? maxPath - 50 : 240;
+	void setToggleState(bool canToggle, bool initialState = false) {
+		hasToggleState = canToggle;
+		isToggled = initialState;
+		updateAppearance();
 	}
 
-	// Try to enable long path support
-	static bool tryEnableLongPaths() {
-		if (isLongPathSupportEnabled())
-		{
-			return true; // Already enabled
-		}
-
-		if (isRunningAsAdmin())
+	void toggle() {
+		if (hasToggleState)
 		{
-			return enableLongPathSupport();
+			isToggled = !isToggled;
+			updateAppearance();
 		}
-
-		return false; // Need elevation
 	}
 
-	// Restart application with admin privileges
-	static bool restartAsAdmin() {
-		wchar_t exePath[MAX_PATH];
-		GetModuleFileNameW(NULL, exePath, MAX_PATH);
-
-		// Preserve current command line arguments and add --enable-long-paths
-		std::wstring params = L"--enable-long-paths";
-
-		// Add other relevant arguments if needed
-		// You could store original argc/argv to reconstruct them here
+	bool isClicked(sf::Vector2f mousePos, float expandBy = 5.0f) const {
+		if (!isEnabled) return false;
 
-		SHELLEXECUTEINFOW sei = {};
-		sei.cbSize = sizeof(SHELLEXECUTEINFOW);
-		sei.lpVerb = L"runas";
-		sei.lpFile = exePath;
-		sei.lpParameters = params.c_str();
-		sei.nShow = SW_NORMAL;
-		sei.fMask = SEE_MASK_NOCLOSEPROCESS;
+		sf::FloatRect bounds = getBounds();
+		bounds.position.x -= expandBy;
+		bounds.position.y -= expandBy;
+		bounds.size.x += expandBy * 2;
+		bounds.size.y += expandBy * 2;
 
-		return ShellExecuteExW(&sei) == TRUE;
+		return bounds.contains(mousePos);
 	}
 
-	static bool getIsRunningAsAdmin() {
-		return isRunningAsAdmin();
+	// Getters
+	ButtonID getID() const { return buttonID; }
+	bool getIsEnabled() const { return isEnabled; }
+	bool getIsToggled() const { return isToggled; }
+	sf::Vector2f getPosition() const { return position; }
+	float getSize() const { return size; }
+	// Includes the 1px outline
+	sf::FloatRect getBounds() const {
+		return sf::FloatRect(position - sf::Vector2f(OUTLINE_THICKNESS, OUTLINE_THICKNESS),
+			sf::Vector2f(size + OUTLINE_THICKNESS * 2, size + OUTLINE_THICKNESS * 2));
 	}
 
-
-	static void handleEnableLongPaths() {
-
-		if (PathLimitChecker::isLongPathSupportEnabled())
-		{
-			LockedMessageBox::showInfo(
-				L"Long path support is already enabled.\n"
-				L"Maximum path length: " + std::to_wstring(PathLimitChecker::getMaxPathLength()) + L" characters",
-				L"Already Enabled"
-			);
-			return;
-		}
-
-		if (!PathLimitChecker::getIsRunningAsAdmin())
-		{
-			LockedMessageBox::showError(
-				L"Administrator privileges required to enable long path support.\n"
-				L"Please run the application as administrator with --enable-long-paths flag.",
-				L"Admin Required"
-			);
-			return;
-		}
-
-		if (PathLimitChecker::tryEnableLongPaths())
+	// Background and circle go into the manager's shared batch, the label is drawn on top
+	void appendGeometry(OverlayGeometry& geometry) const {
+		geometry.addOutlinedRect(sf::FloatRect(position, sf::Vector2f(size, size)), fillColor, OUTLINE_THICKNESS, outlineColor);
+		if (config.hasCircularBg)
 		{
-			LockedMessageBox::showInfo(
-				L"Long path support has been enabled successfully!\n\n"
-				L"New maximum path length: " + std::to_wstring(PathLimitChecker::getMaxPathLength()) + L" characters\n"
-				L"The application will now start with long path support.",
-				L"Long Paths Enabled"
-			);
-		}
-		else
-		{
-			LockedMessageBox::showError(
-				L"Failed to enable long path support.\n"
-				L"Please try enabling it manually through Group Policy or Registry Editor.",
-				L"Enable Failed"
-			);
+			float radius = size / 2 - 3;
+			geometry.addCircle(sf::Vector2f(position.x + 3 + radius, position.y + 3 + radius), radius, circleColor);
 		}
 	}
 
-	static void showPathInfoConsole() {
-		// For console output (useful for command line usage)
-		std::wcout << L"Path Length Information:\n";
-		std::wcout << L"Current Limit: " << PathLimitChecker::getMaxPathLength() << L" characters\n";
-		std::wcout << L"Long Path Support: " << (PathLimitChecker::isLongPathSupportEnabled() ? L"ENABLED" : L"DISABLED") << L"\n";
-		std::wcout << L"Running as Admin: " << (PathLimitChecker::getIsRunningAsAdmin() ? L"YES" : L"NO") << L"\n";
-
-		if (!PathLimitChecker::isLongPathSupportEnabled())
-		{
-			std::wcout << L"\nTo enable long path support, run with administrator privileges:\n";
-			std::wcout << L"manga_reader.exe --enable-long-paths\n";
-		}
+	void drawText(sf::RenderWindow& window) {
+		window.draw(*buttonText.get());
 	}
 
-};
-
-class ArchiveHandler {
 private:
-	struct archive* archive;
-	std::string archivePath;
-	std::wstring archivePathW;
-	std::vector<ArchiveEntry> imageEntries;
-	std::vector<std::vector<uint8_t>> cachedImages; // Cache extracted images
-	bool isArchiveOpen;  // Add state tracking
-	std::mutex archiveMutex;
-	std::set<int> corruptedEntries;
-
-public:
-	ArchiveHandler() : archive(nullptr), archivePath(), archivePathW(), imageEntries(), cachedImages(), isArchiveOpen(false), archiveMutex(), corruptedEntries() { }
-
-	~ArchiveHandler() {
-		closeArchive();
-	}
-
-	bool openArchive(const std::wstring& path) {
-		std::lock_guard<std::mutex> lock(archiveMutex);
+	static constexpr float OUTLINE_THICKNESS = 1.0f;
 
-		archivePathW = path;
-
-		// Run compatibility test first - if fails, return false to skip
-		if (!testArchiveCompatibility())
-		{
-			return false; // This will cause the caller to skip to next archive
-		}
-
-		try
+	void updateAppearance() {
+		if (isEnabled)
 		{
-			// Always close existing archive first
-			closeArchiveInternal();
-
-			archivePath = UnicodeUtils::wstringToString(path);
-
-			// Check if file exists and is readable
-			if (!std::filesystem::exists(path))
-			{
-				ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
-					ErrorDisplayHelper::ErrorContext()
-					.setArchive(archivePathW)
-					.setOperation("File Check")
-					.setDetails("Archive file does not exist: " + archivePath));
-				return false;
-			}
-
-			// Check file size
-			auto fileSize = std::filesystem::file_size(path);
-			if (fileSize == 0)
-			{
-				ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
-					ErrorDisplayHelper::ErrorContext()
-					.setArchive(archivePathW)
-					.setOperation("File Check")
-					.setDetails("Archive file is empty"));
-				return false;
-			}
-
-			archive = archive_read_new();
-			if (!archive)
-			{
-				ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
-					ErrorDisplayHelper::ErrorContext()
-					.setArchive(archivePathW)
-					.setOperation("Archive Creation")
-					.setDetails("Failed to create archive object"));
-				return false;
-			}
-
-			// Enable all supported formats and filters
-			archive_read_support_filter_all(archive);
-			archive_read_support_format_all(archive);
-			archive_read_set_option(archive, NULL, "hdrcharset", "UTF-8");
-
-			std::string pathStr = UnicodeUtils::wstringToString(path);
-			std::string ext = std::filesystem::path(pathStr).extension().string();
-			std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
-
-			// Format-specific optimizations
-			if (ext == ".rar" || ext == ".cbr")
-			{
-				archive_read_set_option(archive, "rar", "hdrcharset", "UTF-8");
-				archive_read_set_option(archive, "rar", "pwdfile", NULL);
-			}
-			else if (ext == ".7z" || ext == ".cb7")
-			{
-				archive_read_set_option(archive, "7zip", "hdrcharset", "UTF-8");
-			}
-			else if (ext == ".tar" || ext == ".gz")
-			{
-				archive_read_set_option(archive, "tar", "hdrcharset", "UTF-8");
-			}
-
-			int result = archive_read_open_filename_w(archive, path.c_str(), 10240);
-			if (result != ARCHIVE_OK)
-			{
-				std::string errorMsg = "Failed to open archive";
-				if (archive_error_string(archive))
-				{
-					errorMsg += "\nLibarchive error: " + std::string(archive_error_string(archive));
-				}
-				ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
-					ErrorDisplayHelper::ErrorContext()
-					.setArchive(archivePathW)
-					.setOperation("Archive Opening")
-					.setDetails(errorMsg));
-				closeArchiveInternal();
-				return false;
-			}
-
-			isArchiveOpen = true;
-
-			if (!loadImageEntries())
+			if (hasToggleState && isToggled)
 			{
-				closeArchiveInternal();
-				return false;
+				// Toggled state (brighter/different color)
+				fillColor = sf::Color(100, 160, 210, 220);
+				outlineColor = sf::Color::Cyan;
+				circleColor = sf::Color(200, 230, 255, 180);
+				buttonText.get()->setFillColor(sf::Color(70, 130, 180));
 			}
-
-			return true;
-
-		} catch (const std::filesystem::filesystem_error& e)
-		{
-			ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
-				ErrorDisplayHelper::ErrorContext()
-				.setArchive(archivePathW)
-				.setOperation("Filesystem Error")
-				.setDetails(e.what()));
-			closeArchiveInternal();
-			return false;
-		} catch (const std::exception& e)
-		{
-			ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
-				ErrorDisplayHelper::ErrorContext()
-				.setArchive(archivePathW)
-				.setOperation("Exception in openArchive")
-				.setDetails(e.what()));
-			closeArchiveInternal();
-			return false;
-		} catch (...)
-		{
-			ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
-				ErrorDisplayHelper::ErrorContext()
-				.setArchive(archivePathW)
-				.setOperation("Unknown Exception")
-				.setDetails("Unknown exception occurred in openArchive"));
-			closeArchiveInternal();
-			return false;
-		}
-	}
-
-	void closeArchive() {
-		std::lock_guard<std::mutex> lock(archiveMutex);
-		closeArchiveInternal();
-	}
-
-	// Add method to preload next few images for smoother navigation
-	void preloadImages(int currentIndex, int preloadCount = 2) {
-		for (int i = 1; i <= preloadCount && (currentIndex + i) < imageEntries.size(); ++i)
-		{
-			int nextIndex = currentIndex + i;
-			if (nextIndex < cachedImages.size() && cachedImages[nextIndex].empty())
+			else
 			{
-				std::vector<uint8_t> dummy;
-				extractImageToMemory(nextIndex, dummy);
+				// Normal enabled state
+				fillColor = config.backgroundColor;
+				outlineColor = config.outlineColor;
+				circleColor = sf::Color(255, 255, 255, 180);
+				buttonText.get()->setFillColor(config.textColor);
 			}
 		}
-	}
-
-	bool hasKnownIssues() const {
-		return !corruptedEntries.empty();
-	}
-
-	std::string getCorruptionReport() const {
-		if (corruptedEntries.empty()) return "";
-
-		std::string report = "Corrupted entries in " + archivePath + ":\n";
-		for (int index : corruptedEntries)
+		else
 		{
-			if (index < imageEntries.size())
-			{
-				report += "- Entry " + std::to_string(index) + ": " + imageEntries[index].name + "\n";
-			}
+			// Disabled state
+			fillColor = config.disabledBgColor;
+			outlineColor = sf::Color(120, 120, 120);
+			circleColor = sf::Color(200, 200, 200, 100);
+			buttonText.get()->setFillColor(config.disabledTextColor);
 		}
-		return report;
 	}
 
-	const std::vector<ArchiveEntry>& getImageEntries() const {
-		return imageEntries;
+	void centerText() {
+		sf::FloatRect textBounds = buttonText.get()->getLocalBounds();
+		buttonText.get()->setPosition(sf::Vector2f(
+			position.x + (size - textBounds.size.x) / 2 - textBounds.position.x,
+			position.y + (size - textBounds.size.y) / 2 - textBounds.position.y
+		));
 	}
+};
 
-	const bool getIsArchiveOpen() const {
-		return isArchiveOpen;
-	}
+class UIButtonManager {
+private:
+	std::vector<std::unique_ptr<UIButton>> buttons;
+	std::map<ButtonID, size_t> buttonIndexMap;
+	mutable std::shared_mutex buttonMutex;
+	OverlayGeometry geometry;
+	std::atomic<bool> geometryDirty;
+public:
+	UIButtonManager() : buttons(), buttonIndexMap(), buttonMutex(), geometry(), geometryDirty(true) { buttons.reserve(10); }
 
-	void clearCache(int index = -1) {
-		std::lock_guard<std::mutex> lock(archiveMutex);
-		try
-		{
-			if (index >= 0 && index < static_cast<int>(cachedImages.size()))
-			{
-				cachedImages[index].clear();
-				cachedImages[index].shrink_to_fit();
-			}
-			else if (index == -1)
-			{
-				for (auto& cache : cachedImages)
-				{
-					cache.clear();
-					cache.shrink_to_fit();
-				}
-				cachedImages.clear();
-			}
-		} catch (const std::exception& e)
-		{
-			ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
-				ErrorDisplayHelper::ErrorContext()
-				.setArchive(archivePathW)
-				.setOperation("clearCache")
-				.setDetails(e.what()));
-		}
+	UIButton* getButtonInternal(ButtonID id) {
+		auto it = buttonIndexMap.find(id);
+		return (it != buttonIndexMap.end()) ? buttons[it->second].get() : nullptr;
 	}
 
-	bool isCached(int index) {
-		std::lock_guard<std::mutex> lock(archiveMutex);
-		return index >= 0 && index < static_cast<int>(cachedImages.size()) && !cachedImages[index].empty();
+	void addButton(const sf::Font& font, ButtonID id, float x, float y,
+		const UIButton::ButtonConfig& config, float size = 30.0f) {
+		std::unique_lock<std::shared_mutex> lock(buttonMutex);
+		size_t index = buttons.size();
+		auto button = std::make_unique<UIButton>();
+		button->initialize(font, id, x, y, config, size);
+		buttons.push_back(std::move(button));
+		buttonIndexMap[id] = index;
+		geometryDirty = true;
 	}
 
-	bool extractImageToMemory(int entryIndex, std::vector<uint8_t>& buffer) {
-		std::lock_guard<std::mutex> lock(archiveMutex);
-
-		try
-		{
-			if (!isArchiveOpen || entryIndex < 0 || entryIndex >= imageEntries.size())
-			{
-				std::string error = "Invalid extraction parameters. Index: " + std::to_string(entryIndex) +
-					", Archive open: " + (isArchiveOpen ? "true" : "false") +
-					", Entries: " + std::to_string(imageEntries.size());
-				ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
-					ErrorDisplayHelper::ErrorContext()
-					.setArchive(archivePathW)
-					.setOperation("Parameter Validation")
-					.setDetails(error));
-				return false;
-			}
-
-			// Check if this entry was previously marked as corrupted
-			if (corruptedEntries.find(entryIndex) != corruptedEntries.end())
-			{
-				std::wstring message = L"Skipping previously corrupted image:\n\n";
-				message += L"Entry: " + std::to_wstring(entryIndex) + L"\n";
-				message += L"File: " + UnicodeUtils::stringToWstring(imageEntries[entryIndex].name);
-
-				LockedMessageBox::showError(message, L"Corrupted Image Skipped");
-				return false;
-			}
-
-			// Check if image is already cached
-			if (entryIndex < cachedImages.size() && !cachedImages[entryIndex].empty())
-			{
-				buffer = cachedImages[entryIndex];
-				return true;
-			}
-
-			// Extract using the main archive instance with error checking
-			if (!extractAndCacheImageInternal(entryIndex))
-			{
-				corruptedEntries.insert(entryIndex); // Mark as corrupted
-				ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CORRUPTION,
-					ErrorDisplayHelper::ErrorContext()
-					.setArchive(archivePathW)
-					.setEntry(entryIndex, imageEntries[entryIndex].name));
-				return false;
-			}
-
-			// Return cached data
-			if (entryIndex < cachedImages.size() && !cachedImages[entryIndex].empty())
-			{
-				buffer = cachedImages[entryIndex];
-				return true;
-			}
-
-			ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
-				ErrorDisplayHelper::ErrorContext()
-				.setArchive(archivePathW)
-				.setOperation("Cache Error")
-				.setDetails("Cache is empty after successful extraction for entry: " + std::to_string(entryIndex)));
-			return false;
-
-		} catch (const std::bad_alloc& e)
-		{
-			corruptedEntries.insert(entryIndex);
-			ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::MEMORY,
-				ErrorDisplayHelper::ErrorContext()
-				.setArchive(archivePathW)
-				.setOperation("extractImageToMemory")
-				.setMemorySize(0));
-			return false;
-		} catch (const std::exception& e)
-		{
-			corruptedEntries.insert(entryIndex);
-			ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
-				ErrorDisplayHelper::ErrorContext()
-				.setArchive(archivePathW)
-				.setOperation("extractImageToMemory Exception")
-				.setDetails("Entry: " + std::to_string(entryIndex) + " - " + e.what()));
-			return false;
-		} catch (...)
-		{
-			corruptedEntries.insert(entryIndex);
-			ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
-				ErrorDisplayHelper::ErrorContext()
-				.setArchive(archivePathW)
-				.setOperation("extractImageToMemory Unknown Exception")
-				.setDetails("Unknown exception for entry: " + std::to_string(entryIndex)));
-			return false;
-		}
+	template<typename Func>
+	auto withButton(ButtonID id, Func&& func) -> decltype(func(std::declval<UIButton*>())) {
+		std::shared_lock<std::shared_mutex> lock(buttonMutex);  // Shared lock for reading
+		UIButton* btn = getButtonInternal(id);
+		return func(btn);
 	}
 
-	bool isSafeToAllocate(size_t requestedSize) {
-		const size_t MAX_SINGLE_ALLOCATION = 200 * 1024 * 1024; // 200MB max per image
-		const size_t MIN_FREE_MEMORY = 500 * 1024 * 1024; // Keep 500MB free
-
-		if (requestedSize > MAX_SINGLE_ALLOCATION)
-		{
-			ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::MEMORY,
-				ErrorDisplayHelper::ErrorContext()
-				.setArchive(archivePathW)
-				.setOperation("Size Check")
-				.setMemorySize(requestedSize));
-			return false;
-		}
-
-		MEMORYSTATUSEX memInfo;
-		memInfo.dwLength = sizeof(MEMORYSTATUSEX);
-		if (GlobalMemoryStatusEx(&memInfo))
-		{
-			if (memInfo.ullAvailPhys < (requestedSize + MIN_FREE_MEMORY))
-			{
-				ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::MEMORY,
-					ErrorDisplayHelper::ErrorContext()
-					.setArchive(archivePathW)
-					.setOperation("Memory Check")
-					.setMemorySize(requestedSize));
-				return false;
-			}
-		}
-
-		return true;
+	// Get button by ID
+	UIButton* getButton(ButtonID id) {
+		std::shared_lock<std::shared_mutex> lock(buttonMutex);  // NEW: Shared lock
+		geometryDirty = true; // caller may change the button's appearance
+		return getButtonInternal(id);
 	}
 
-	std::vector<uint8_t> safeAllocateVector(size_t size) {
-		if (!isSafeToAllocate(size))
-		{
-			throw std::bad_alloc();
-		}
-
-		try
-		{
-			return std::vector<uint8_t>(size);
-		} catch (const std::bad_alloc& e)
+	// Update all button positions (useful for window resize)
+	void updateAllPositions(const std::function<sf::Vector2f(ButtonID)>& positionCalculator) {
+		std::unique_lock<std::shared_mutex> lock(buttonMutex);  // NEW: Exclusive lock
+		for (auto& button : buttons)
 		{
-			ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
-				ErrorDisplayHelper::ErrorContext()
-				.setArchive(archivePathW)
-				.setOperation("Vector Allocation")
-				.setDetails(e.what()));
-			throw;
+			sf::Vector2f newPos = positionCalculator(button->getID());
+			button->updatePosition(newPos.x, newPos.y);
 		}
+		geometryDirty = true;
 	}
 
-private:
-
-	bool extractAndCacheImage(int targetIndex) {
-		if (!archive || targetIndex < 0 || targetIndex >= imageEntries.size())
-		{
-			return false;
-		}
-
-		// Ensure cache is properly sized
-		if (cachedImages.size() < imageEntries.size())
-		{
-			cachedImages.resize(imageEntries.size());
-		}
-
-		// If already cached, return success
-		if (!cachedImages[targetIndex].empty())
-		{
-			return true;
-		}
-
-		// Create a new archive instance for extraction
-		struct archive* extractArchive = archive_read_new();
-		if (!extractArchive)
-		{
-			return false;
-		}
-
-		archive_read_support_filter_all(extractArchive);
-		archive_read_support_format_all(extractArchive);
-		archive_read_set_option(extractArchive, NULL, "hdrcharset", "UTF-8");
-
-		// Open archive for extraction
-		std::wstring wPath = UnicodeUtils::stringToWstring(archivePath);
-		int result = archive_read_open_filename_w(extractArchive, wPath.c_str(), 10240);
-
-		if (result != ARCHIVE_OK)
-		{
-			archive_read_free(extractArchive);
-			return false;
-		}
-
-		struct archive_entry* entry;
-		int currentIndex = 0;
-		bool found = false;
-
-		// Find and extract the target image
-		while (archive_read_next_header(extractArchive, &entry) == ARCHIVE_OK)
+	// Check which button was clicked (returns ButtonID::COUNT if none)
+	ButtonID checkButtonClick(sf::Vector2f mousePos, float expandBy = 5.0f) {
+		std::shared_lock<std::shared_mutex> lock(buttonMutex);  // NEW: Shared lock
+		for (const auto& button : buttons)
 		{
-			const char* pathname = archive_entry_pathname(entry);
-			if (!pathname)
-			{
-				archive_read_data_skip(extractArchive);
-				continue;
-			}
-
-			std::string fileName;
-			try
-			{
-				fileName = std::string(pathname);
-				std::wstring wFileName = UnicodeUtils::stringToWstring(fileName);
-				fileName = UnicodeUtils::wstringToString(wFileName);
-			} catch (...)
-			{
-				fileName = std::string(pathname);
-			}
-
-			if (IsImgExtValid(std::filesystem::path(fileName).extension().string()))
-			{
-				if (currentIndex == targetIndex)
-				{
-					// Extract this image
-					la_int64_t size = archive_entry_size(entry);
-					if (size > 0)
-					{
-						cachedImages[targetIndex].resize(static_cast<size_t>(size));
-						la_ssize_t bytesRead = archive_read_data(extractArchive,
-							cachedImages[targetIndex].data(), cachedImages[targetIndex].size());
-
-						if (bytesRead == size)
-						{
-							found = true;
-						}
-						else
-						{
-							cachedImages[targetIndex].clear();
-						}
-					}
-
-					break;
-				}
-				else
-				{
-					archive_read_data_skip(extractArchive);
-				}
-				currentIndex++;
-			}
-			else
+			if (button->isClicked(mousePos, expandBy))
 			{
-				archive_read_data_skip(extractArchive);
+				return button->getID();
 			}
 		}
+		return ButtonID::COUNT;
+	}
 
-		// Always clean up extraction archive
-		archive_read_free(extractArchive);
-		return found;
+	// Batch operations
+	void enableButton(ButtonID id, bool enabled) {
+		withButton(id, [enabled](UIButton* btn) {
+			if (btn) btn->setEnabled(enabled);
+			return true;
+			});
+		geometryDirty = true;
 	}
 
-	bool loadImageEntries() {
-		try
+	void toggleButton(ButtonID id) {
+		withButton(id, [](UIButton* btn) {
+			if (btn) btn->toggle();
+			return true;
+			});
+		geometryDirty = true;
+	}
+
+	bool isButtonToggled(ButtonID id) {
+		return withButton(id, [](UIButton* btn) {
+			return btn ? btn->getIsToggled() : false;
+			});
+	}
+
+	// Render all buttons: one batched draw for the backgrounds, then the labels
+	void drawAll(sf::RenderWindow& window) {
+		std::shared_lock<std::shared_mutex> lock(buttonMutex);
+		if (geometryDirty.exchange(false))
 		{
-			imageEntries.clear();
+			geometry.clear();
+			for (const auto& button : buttons)
+			{
+				button->appendGeometry(geometry);
+			}
+		}
 
-			if (!archive || !isArchiveOpen) return false;
+		geometry.draw(window);
+		for (auto& button : buttons)
+		{
+			button->drawText(window);
+		}
+	}
 
-			struct archive_entry* entry;
-			int index = 0;
-			int totalEntries = 0;
-			int maxFolderDepth = 0;
-			size_t maxPathLength = 0;
+	// Get button count
+	size_t getButtonCount() const {
+		std::shared_lock<std::shared_mutex> lock(buttonMutex);
+		return buttons.size();
+	}
 
-			while (archive_read_next_header(archive, &entry) == ARCHIVE_OK)
-			{
-				totalEntries++;
+	// Clear all buttons
+	void clear() {
+		std::unique_lock<std::shared_mutex> lock(buttonMutex);
+		buttons.clear();
+		buttonIndexMap.clear();
+		geometryDirty = true;
+	}
+};
 
-				// Get entry info
-				const char* pathname = archive_entry_pathname(entry);
-				la_int64_t entry_type = archive_entry_filetype(entry);
-				la_int64_t entry_size = archive_entry_size(entry);
+static constexpr const char* CONFIG_SECTION = "Settings";
+static constexpr const char* CONFIG_LAST_FOLDER = "Settings.lastMangaFolder";
+static constexpr const char* CONFIG_LAST_FOLDER_INDEX = "Settings.lastFolderIndex";
+static constexpr const char* CONFIG_LAST_IMAGE_INDEX = "Settings.lastImageIndex";
+static constexpr const char* CONFIG_LAST_SOURCE = "Settings.lastSource";
+static constexpr const char* CONFIG_LAST_SOURCE_IS_ARCHIVE = "Settings.lastSourceIsArchive";
+static constexpr const char* CONFIG_WINDOW_WIDTH = "Settings.windowWidth";
+static constexpr const char* CONFIG_WINDOW_HEIGHT = "Settings.windowHeight";
+static constexpr const char* CONFIG_WINDOW_MAXIMIZED = "Settings.windowMaximized";
+static constexpr const char* CONFIG_WINDOW_FULLSCREEN = "Settings.windowFullscreen";
+static constexpr const char* CONFIG_USE_SMOOTHING = "Settings.useSmoothing";
+static constexpr const char* CONFIG_ASK_SESSION_RESTORE = "Settings.askSessionRestore";
+static constexpr const char* CONFIG_LAST_SESSION_EXISTS = "Settings.lastSessionExists";
+static constexpr const char* CONFIG_SHOW_SESSION_SUCCESS = "Settings.showSessionSuccessDialog";
+static constexpr const char* CONFIG_FRAME_RATE_LIMIT = "Settings.frameRateLimit";
+static constexpr const char* CONFIG_VERTICAL_SYNC = "Settings.verticalSync";
+static constexpr const char* CONFIG_WEBTOON_MODE = "Settings.webtoonMode";
+static constexpr const char* CONFIG_SPREAD_MODE = "Settings.spreadMode";
+static constexpr const char* CONFIG_RIGHT_TO_LEFT = "Settings.rightToLeft";
+static constexpr const char* CONFIG_PREFETCH_BUDGET_MB = "Settings.prefetchBudgetMB";
+static constexpr const char* CONFIG_LIBRARY_SCAN_DEPTH = "Settings.libraryScanDepth";
+static constexpr const char* CONFIG_LIBRARY_SCAN_THREADS = "Settings.libraryScanThreads";
+static constexpr const char* CONFIG_WATCH_LIBRARY = "Settings.watchLibrary";
+static constexpr const char* CONFIG_LIBRARY_WATCH_DEBOUNCE_MS = "Settings.libraryWatchDebounceMs";
+static constexpr const char* CONFIG_FOLDER_PREFETCH_THRESHOLD = "Settings.folderPrefetchThreshold";
+static constexpr const char* CONFIG_FOLDER_PREFETCH_PAGES = "Settings.folderPrefetchPages";
+static constexpr const char* CONFIG_PREFETCH_PREVIOUS_FOLDER = "Settings.prefetchPreviousFolder";
+
+
+// Virtual texture for the current page: pixels stay on the CPU and are cut into fixed-size
+// tiles, only the tiles overlapping the window (plus a margin) are resident on the GPU.
+// Oversized pages are built from their decode stripes, stacked top to bottom. The sources are
+// shared with the decoded page they came from rather than copied.
+class TiledPage {
+public:
+	using Source = std::shared_ptr<const sf::Image>;
 
-				// Skip directories
-				if (entry_type == AE_IFDIR)
-				{
-					archive_read_data_skip(archive);
-					continue;
-				}
+private:
+	struct Tile {
+		size_t sourceIndex;
+		sf::IntRect area;				// region of the source image this tile covers
+		sf::Vector2f offset;			// top-left in column pixels
+		std::unique_ptr<sf::Texture> texture;
+		std::unique_ptr<sf::Sprite> sprite;
+	};
 
-				// Skip non-regular files
-				if (entry_type != AE_IFREG)
-				{
-					archive_read_data_skip(archive);
-					continue;
-				}
+	std::vector<Source> sources;
+	std::vector<Tile> tiles;				// ordered top to bottom, then left to right
+	sf::Vector2u pageSize;				// full-resolution page size
+	sf::Vector2u columnSize;			// size of the stacked sources, smaller than pageSize for striped pages
+	sf::Vector2u viewSize;
+	sf::Vector2f position;
+	float scale;
+	bool smooth;
+	bool enabled;
+	size_t residentCount;
+	size_t uploadCount;
+	// Tiles that may hold a texture; everything outside this range has none
+	size_t residentBegin;
+	size_t residentEnd;
 
-				// Handle pathname
-				std::string currentPath;
-				if (!pathname)
-				{
-					currentPath = "unknown_" + std::to_string(index);
-				}
-				else
-				{
-					currentPath = std::string(pathname);
-				}
+public:
+	static constexpr int TILE_SIZE = 512;
+	// Screen pixels around the window that are kept resident so panning doesn't reveal holes
+	static constexpr float RESIDENCY_MARGIN = 256.0f;
 
-				// Normalize path
-				std::replace(currentPath.begin(), currentPath.end(), '\\', '/');
+	TiledPage() : sources(), tiles(), pageSize(0, 0), columnSize(0, 0), viewSize(0, 0), position(0.0f, 0.0f),
+		scale(1.0f), smooth(true), enabled(false), residentCount(0), uploadCount(0), residentBegin(0), residentEnd(0) { }
 
-				// Calculate folder depth and path length
-				int folderDepth = std::count(currentPath.begin(), currentPath.end(), '/');
-				maxFolderDepth = std::max(maxFolderDepth, folderDepth);
-				maxPathLength = std::max(maxPathLength, currentPath.length());
+	bool build(std::vector<Source> pageSources, sf::Vector2u originalSize, bool useSmoothing) {
+		clear();
+		if (pageSources.empty() || !pageSources.front() || pageSources.front()->getSize().x == 0) return false;
 
-				// Check if it's an image file
-				std::filesystem::path filePath(currentPath);
-				std::string extension = filePath.extension().string();
+		sources = std::move(pageSources);
+		pageSize = originalSize;
+		smooth = useSmoothing;
 
-				if (IsImgExtValid(extension) && entry_size > 0)
+		unsigned int top = 0;
+		for (size_t i = 0; i < sources.size(); ++i)
+		{
+			sf::Vector2u size = sources[i] ? sources[i]->getSize() : sf::Vector2u(0, 0);
+			for (unsigned int y = 0; y < size.y; y += TILE_SIZE)
+			{
+				for (unsigned int x = 0; x < size.x; x += TILE_SIZE)
 				{
-					ArchiveEntry archiveEntryStruct;
-					archiveEntryStruct.name = currentPath;
-					archiveEntryStruct.size = static_cast<size_t>(entry_size);
-					archiveEntryStruct.index = index++;
-
-					imageEntries.push_back(archiveEntryStruct);
+					Tile tile;
+					tile.sourceIndex = i;
+					tile.area = sf::IntRect(sf::Vector2i(static_cast<int>(x), static_cast<int>(y)),
+						sf::Vector2i(static_cast<int>(std::min<unsigned int>(TILE_SIZE, size.x - x)),
+							static_cast<int>(std::min<unsigned int>(TILE_SIZE, size.y - y))));
+					tile.offset = sf::Vector2f(static_cast<float>(x), static_cast<float>(top + y));
+					tiles.push_back(std::move(tile));
 				}
-
-				archive_read_data_skip(archive);
 			}
+			top += size.y;
+		}
 
-			// Check if the internal structure is too complex
-			const int MAX_FOLDER_DEPTH = 5;
-			const size_t MAX_INTERNAL_PATH = 150;
+		columnSize = sf::Vector2u(sources.front()->getSize().x, top);
+		position = sf::Vector2f(0.0f, 0.0f);
+		scale = 1.0f;
+		return true;
+	}
 
-			if (maxFolderDepth > MAX_FOLDER_DEPTH || maxPathLength > MAX_INTERNAL_PATH)
-			{
-				std::wstring message = L"ARCHIVE SKIPPED - COMPLEX STRUCTURE:\n\n";
-				message += L"Max folder depth: " + std::to_wstring(maxFolderDepth) + L" (limit: " + std::to_wstring(MAX_FOLDER_DEPTH) + L")\n";
-				message += L"Max internal path: " + std::to_wstring(maxPathLength) + L" chars (limit: " + std::to_wstring(MAX_INTERNAL_PATH) + L")\n";
-				message += L"Images found: " + std::to_wstring(imageEntries.size()) + L"\n\n";
-				message += L"Moving to next archive...";
+	void clear() {
+		tiles.clear();
+		sources.clear();
+		pageSize = sf::Vector2u(0, 0);
+		columnSize = sf::Vector2u(0, 0);
+		residentCount = 0;
+		residentBegin = 0;
+		residentEnd = 0;
+	}
 
-				LockedMessageBox::showError(message, L"Archive Skipped - Complex Structure");
-				return false;
-			}
+	bool isLoaded() const { return !tiles.empty(); }
 
-			// Sort entries by index to maintain order
-			std::sort(imageEntries.begin(), imageEntries.end(),
-				[](const ArchiveEntry& a, const ArchiveEntry& b) {
-					return a.index < b.index;
-				});
+	// Built from more than one decode stripe, or downscaled at decode time
+	bool isStriped() const { return sources.size() > 1 || (isLoaded() && columnSize.x != pageSize.x); }
 
-			if (imageEntries.empty())
-			{
-				std::wstring message = L"No images found in archive.\n";
-				message += L"Moving to next archive...";
-				LockedMessageBox::showError(message, L"No Images Found");
-				return false;
-			}
+	sf::Vector2u getPageSize() const { return pageSize; }
 
-			return true;
+	// Full-resolution pixels of a single-image page, for CPU rescaling
+	const sf::Image& getSourceImage() const { return *sources.front(); }
 
-		} catch (const std::exception& e)
-		{
-			ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
-				ErrorDisplayHelper::ErrorContext()
-				.setArchive(archivePathW)
-				.setOperation("loadImageEntries Exception")
-				.setDetails(e.what()));
-			return false;
-		} catch (...)
-		{
-			ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
-				ErrorDisplayHelper::ErrorContext()
-				.setArchive(archivePathW)
-				.setOperation("loadImageEntries")
-				.setDetails("Unknown exception occurred"));
-			return false;
-		}
-	}
+	size_t getTileCount() const { return tiles.size(); }
+	size_t getResidentCount() const { return residentCount; }
+	size_t getUploadCount() const { return uploadCount; }
 
-	void closeArchiveInternal() {
-		if (archive)
-		{
-			archive_read_free(archive);
-			archive = nullptr;
-		}
-		isArchiveOpen = false;
-		archivePath.clear();
-		imageEntries.clear();
-		cachedImages.clear();
-		corruptedEntries.clear();
+	// Disabled pages give back all their tile textures
+	void setEnabled(bool isEnabled) {
+		enabled = isEnabled;
+		updateResidency();
 	}
 
-	bool testArchiveCompatibility() {
-		std::string archiveName = UnicodeUtils::wstringToString(archivePathW);
+	bool isEnabled() const { return enabled && isLoaded(); }
 
-		std::filesystem::path archivePath(archiveName);
-		std::string archiveFilename = archivePath.filename().string();
-		std::string archiveDir = archivePath.parent_path().string();
+	void setViewSize(sf::Vector2u size) {
+		viewSize = size;
+		updateResidency();
+	}
 
-		size_t archivePathLength = archiveName.length();
-		size_t basePathLength = archiveDir.length();
+	// Zoom is expressed against the original page, striped sources are already downscaled
+	void setZoom(float zoom) {
+		if (columnSize.x == 0) return;
+		scale = zoom * static_cast<float>(pageSize.x) / static_cast<float>(columnSize.x);
+		updateResidency();
+	}
 
-		// Dynamic limits based on system configuration
-		const size_t MAX_TOTAL_PATH = PathLimitChecker::getSafePathLength();
-		const size_t MAX_SINGLE_COMPONENT = PathLimitChecker::getMaxComponentLength();
-		const size_t MAX_ESTIMATED_INTERNAL_PATH = 120; // Keep this as estimate
+	void setPosition(sf::Vector2f newPosition) {
+		position = newPosition;
+		updateResidency();
+	}
 
-		bool pathTooLong = false;
-		bool componentTooLong = false;
-		bool estimatedOverflow = false;
+	sf::Vector2f getPosition() const { return position; }
 
-		// Check if archive path is already too long
-		if (archivePathLength > MAX_TOTAL_PATH)
-		{
-			pathTooLong = true;
-		}
+	sf::FloatRect getGlobalBounds() const {
+		return sf::FloatRect(position, sf::Vector2f(columnSize.x * scale, columnSize.y * scale));
+	}
 
-		// Check if archive filename itself is too long
-		if (archiveFilename.length() > MAX_SINGLE_COMPONENT)
+	void setSmooth(bool useSmoothing) {
+		smooth = useSmoothing;
+		for (size_t i = residentBegin; i < residentEnd; ++i)
 		{
-			componentTooLong = true;
+			if (tiles[i].texture) tiles[i].texture->setSmooth(smooth);
 		}
+	}
 
-		// Estimate if internal paths might cause overflow
-		size_t estimatedMaxPath = basePathLength + archiveFilename.length() + MAX_ESTIMATED_INTERNAL_PATH;
-		if (estimatedMaxPath > MAX_TOTAL_PATH)
-		{
-			estimatedOverflow = true;
-		}
+	void draw(sf::RenderWindow& window) const {
+		if (!isEnabled()) return;
 
-		if (pathTooLong || componentTooLong || estimatedOverflow)
+		const sf::Vector2f windowSize(window.getSize());
+		for (size_t i = residentBegin; i < residentEnd; ++i)
 		{
-			std::wstring message = L"ARCHIVE SKIPPED - PATH LENGTH ISSUE:\n\n";
-			message += L"Archive: " + UnicodeUtils::stringToWstring(archiveFilename) + L"\n\n";
-			message += L"System Path Limit: " + std::to_wstring(PathLimitChecker::getMaxPathLength()) + L" chars\n";
-			message += L"Long Path Support: " + std::wstring(PathLimitChecker::getMaxPathLength() > 260 ? L"ENABLED" : L"DISABLED") + L"\n\n";
-
-			if (pathTooLong)
-			{
-				message += L"• Archive path too long: " + std::to_wstring(archivePathLength) +
-					L" chars (max " + std::to_wstring(MAX_TOTAL_PATH) + L")\n";
-			}
-			if (componentTooLong)
-			{
-				message += L"• Archive filename too long: " + std::to_wstring(archiveFilename.length()) +
-					L" chars (max " + std::to_wstring(MAX_SINGLE_COMPONENT) + L")\n";
-			}
-			if (estimatedOverflow)
+			if (tiles[i].sprite && intersects(tiles[i], sf::Vector2f(0.0f, 0.0f), windowSize))
 			{
-				message += L"• Estimated total path would exceed limit\n";
+				window.draw(*tiles[i].sprite);
 			}
-
-			LockedMessageBox::showError(message, L"Archive Skipped - Path Too Long");
-			return false;
 		}
+	}
 
-		return true;
+private:
+	bool intersects(const Tile& tile, sf::Vector2f viewMin, sf::Vector2f viewMax) const {
+		float left = position.x + tile.offset.x * scale;
+		float top = position.y + tile.offset.y * scale;
+		float right = left + tile.area.size.x * scale;
+		float bottom = top + tile.area.size.y * scale;
+		return right >= viewMin.x && left <= viewMax.x && bottom >= viewMin.y && top <= viewMax.y;
 	}
 
-	bool extractAndCacheImageInternal(int targetIndex) {
-		try
-		{
-			if (!archive || targetIndex < 0 || targetIndex >= imageEntries.size())
-			{
-				return false;
-			}
+	static void release(Tile& tile) {
+		tile.sprite.reset();
+		tile.texture.reset();
+	}
 
-			// Ensure cache is properly sized
-			if (cachedImages.size() < imageEntries.size())
-			{
-				cachedImages.resize(imageEntries.size());
-			}
+	// Tile rows overlapping [viewMin.y, viewMax.y], found by binary search on the row order
+	std::pair<size_t, size_t> getTileRange(sf::Vector2f viewMin, sf::Vector2f viewMax) const {
+		if (scale <= 0.0f) return { 0, 0 };
 
-			// If already cached, return success
-			if (!cachedImages[targetIndex].empty())
-			{
-				return true;
-			}
+		const float columnTop = (viewMin.y - position.y) / scale;
+		const float columnBottom = (viewMax.y - position.y) / scale;
+		auto first = std::partition_point(tiles.begin(), tiles.end(), [columnTop](const Tile& tile) {
+			return tile.offset.y + tile.area.size.y < columnTop;
+			});
+		auto last = std::partition_point(first, tiles.end(), [columnBottom](const Tile& tile) {
+			return tile.offset.y <= columnBottom;
+			});
+		return { static_cast<size_t>(first - tiles.begin()), static_cast<size_t>(last - tiles.begin()) };
+	}
 
-			// Reopen the archive to reset position
-			std::wstring wPath = UnicodeUtils::stringToWstring(archivePath);
+	// Upload tiles entering the view, release those that left it, and lay out the rest. Only
+	// the rows around the view and the ones resident before are visited, not the whole page.
+	void updateResidency() {
+		const bool active = isEnabled() && viewSize.x > 0 && viewSize.y > 0;
+		const sf::Vector2f viewMin(-RESIDENCY_MARGIN, -RESIDENCY_MARGIN);
+		const sf::Vector2f viewMax(viewSize.x + RESIDENCY_MARGIN, viewSize.y + RESIDENCY_MARGIN);
 
-			// Close current archive
-			if (archive)
-			{
-				archive_read_free(archive);
-				archive = nullptr;
-			}
+		auto [first, last] = active ? getTileRange(viewMin, viewMax) : std::pair<size_t, size_t>(0, 0);
+		for (size_t i = residentBegin; i < residentEnd; ++i)
+		{
+			if (i < first || i >= last) release(tiles[i]);
+		}
+		residentBegin = first;
+		residentEnd = last;
 
-			// Reopen archive with error checking
-			archive = archive_read_new();
-			if (!archive)
+		residentCount = 0;
+		for (size_t i = first; i < last; ++i)
+		{
+			Tile& tile = tiles[i];
+			if (!intersects(tile, viewMin, viewMax))
 			{
-				isArchiveOpen = false;
-				ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
-					ErrorDisplayHelper::ErrorContext()
-					.setArchive(archivePathW)
-					.setOperation("Archive Reopen")
-					.setDetails("Failed to create new archive object for extraction"));
-				return false;
+				release(tile);
+				continue;
 			}
 
-			archive_read_support_filter_all(archive);
-			archive_read_support_format_all(archive);
-			archive_read_set_option(archive, NULL, "hdrcharset", "UTF-8");
+			if (!tile.texture && !uploadTile(tile)) continue;
 
-			if (archive_read_open_filename_w(archive, wPath.c_str(), 10240) != ARCHIVE_OK)
-			{
-				std::string errorMsg = "Failed to reopen archive for extraction";
-				if (archive_error_string(archive))
-				{
-					errorMsg += ": " + std::string(archive_error_string(archive));
-				}
-				ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
-					ErrorDisplayHelper::ErrorContext()
-					.setArchive(archivePathW)
-					.setOperation("Archive Reopen")
-					.setDetails(errorMsg));
-				archive_read_free(archive);
-				archive = nullptr;
-				isArchiveOpen = false;
-				return false;
-			}
+			tile.sprite->setScale(sf::Vector2f(scale, scale));
+			tile.sprite->setPosition(sf::Vector2f(position.x + tile.offset.x * scale, position.y + tile.offset.y * scale));
+			++residentCount;
+		}
+	}
 
-			struct archive_entry* entry;
-			bool found = false;
-			int imageCount = 0; // Count only image files
-			std::vector<std::string> foundPaths; // Debug: track what we find
+	// A one pixel gutter is uploaded around the tile so smoothing doesn't show seams
+	bool uploadTile(Tile& tile) {
+		const sf::Image& source = *sources[tile.sourceIndex];
+		const sf::Vector2i sourceSize(source.getSize());
 
-			// Extract by position - much simpler and more reliable
-			while (archive_read_next_header(archive, &entry) == ARCHIVE_OK)
-			{
-				const char* pathname = archive_entry_pathname(entry);
+		sf::Vector2i gutterMin(std::max(tile.area.position.x - 1, 0), std::max(tile.area.position.y - 1, 0));
+		sf::Vector2i gutterMax(std::min(tile.area.position.x + tile.area.size.x + 1, sourceSize.x),
+			std::min(tile.area.position.y + tile.area.size.y + 1, sourceSize.y));
 
-				// Get entry info
-				la_int64_t entry_type = archive_entry_filetype(entry);
-				la_int64_t size = archive_entry_size(entry);
+		auto texture = std::make_unique<sf::Texture>();
+		if (!texture->loadFromImage(source, false, sf::IntRect(gutterMin, gutterMax - gutterMin)))
+		{
+			return false;
+		}
+		texture->setSmooth(smooth);
 
-				// Skip directories
-				if (entry_type == AE_IFDIR)
-				{
-					archive_read_data_skip(archive);
-					continue;
-				}
+		tile.texture = std::move(texture);
+		tile.sprite = std::make_unique<sf::Sprite>(*tile.texture,
+			sf::IntRect(tile.area.position - gutterMin, tile.area.size));
+		++uploadCount;
+		return true;
+	}
+};
 
-				// Skip non-regular files
-				if (entry_type != AE_IFREG)
-				{
-					archive_read_data_skip(archive);
-					continue;
-				}
+// Running sums over a fixed number of slots (a Fenwick tree): O(log n) updates and prefix sums
+class PrefixSumTree {
+private:
+	std::vector<double> tree;		// 1-based
 
-				// Handle pathname
-				std::string currentPath = pathname ? std::string(pathname) : ("unknown_" + std::to_string(imageCount));
-				std::replace(currentPath.begin(), currentPath.end(), '\\', '/');
+	static size_t lowestBit(size_t i) { return i & (~i + 1); }
 
-				// Check if it's an image file
-				std::filesystem::path filePath(currentPath);
-				std::string extension = filePath.extension().string();
+public:
+	PrefixSumTree() : tree() { }
 
-				if (IsImgExtValid(extension) && size > 0)
-				{
-					foundPaths.push_back(currentPath); // Debug tracking
+	void reset(size_t count) {
+		tree.assign(count + 1, 0.0);
+	}
 
-					// Is this our target image? (by position in image sequence)
-					if (imageCount == targetIndex)
-					{
-						// This is our target image - extract it
-						if (size > 500 * 1024 * 1024)
-						{
-							ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::MEMORY,
-								ErrorDisplayHelper::ErrorContext()
-								.setArchive(archivePathW)
-								.setOperation("Image Too Large")
-								.setMemorySize(static_cast<size_t>(size)));
-							break;
-						}
+	void add(size_t index, double delta) {
+		for (size_t i = index + 1; i < tree.size(); i += lowestBit(i))
+		{
+			tree[i] += delta;
+		}
+	}
 
-						try
-						{
-							cachedImages[targetIndex] = safeAllocateVector(static_cast<size_t>(size));
+	// Sum of the slots before end
+	double prefix(size_t end) const {
+		if (tree.empty()) return 0.0;
 
-							la_ssize_t bytesRead = archive_read_data(archive,
-								cachedImages[targetIndex].data(), cachedImages[targetIndex].size());
+		double sum = 0.0;
+		for (size_t i = std::min(end, tree.size() - 1); i > 0; i -= lowestBit(i))
+		{
+			sum += tree[i];
+		}
+		return sum;
+	}
+};
 
-							if (bytesRead == size)
-							{
-								found = true;
+// Continuous vertical strip of every page in the source, for long-strip (webtoon) reading.
+// Page heights start as estimates and are corrected as pages decode; only pages inside the
+// viewport plus a prefetch margin are decoded, scaled to the strip width and kept as textures.
+// Nothing here walks the whole page list: offsets come from prefix sums and only the resident
+// window is visited, so a source with thousands of pages costs the same per frame as a short one.
+class WebtoonStrip {
+public:
+	using PageLoader = std::function<ImageLoader::LoadResult(int)>;
 
-								// Success message with debug info
-								//std::wstring successMsg = L"EXTRACTION SUCCESS!\n\n";
-								//successMsg += L"Target index: " + std::to_wstring(targetIndex) + L"\n";
-								//successMsg += L"Image count: " + std::to_wstring(imageCount) + L"\n";
-								//successMsg += L"Path found: " + UnicodeUtils::stringToWstring(currentPath) + L"\n";
-								//successMsg += L"Size: " + std::to_wstring(size) + L" bytes\n";
-								//successMsg += L"Bytes read: " + std::to_wstring(bytesRead);
+	static constexpr float DEFAULT_ASPECT = 1.5f;		// height / width until a page is known
+	static constexpr size_t MAX_DECODES_IN_FLIGHT = 2;
+	static constexpr size_t MAX_UPLOADS_PER_UPDATE = 2;	// stripes, keeps a frame's upload cost bounded
 
-								//MessageBoxW(NULL, successMsg.c_str(), L"Extraction Success", MB_OK | MB_ICONINFORMATION);
+private:
+	enum class PageState {
+		EMPTY,
+		DECODING,
+		UPLOADING,
+		READY,
+		FAILED
+	};
 
-							}
-							else if (bytesRead < 0)
-							{
-								std::string error = "Archive read error for: " + currentPath;
-								if (archive_error_string(archive))
-								{
-									error += " - " + std::string(archive_error_string(archive));
-								}
-								ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
-									ErrorDisplayHelper::ErrorContext()
-									.setArchive(archivePathW)
-									.setOperation("Archive Read Error")
-									.setDetails(error));
-								cachedImages[targetIndex].clear();
-							}
-							else
-							{
-								std::string error = "Partial read for: " + currentPath +
-									". Expected: " + std::to_string(size) +
-									", Got: " + std::to_string(bytesRead);
-								ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
-									ErrorDisplayHelper::ErrorContext()
-									.setArchive(archivePathW)
-									.setOperation("Partial Read")
-									.setDetails(error));
-								cachedImages[targetIndex].clear();
-							}
-						} catch (const std::bad_alloc& e)
-						{
-							ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::MEMORY,
-								ErrorDisplayHelper::ErrorContext()
-								.setArchive(archivePathW)
-								.setOperation("Allocation Failed")
-								.setMemorySize(static_cast<size_t>(size)));
-							cachedImages[targetIndex].clear();
-							found = false;
-						}
-						break; // Found our target, stop here
-					}
+	struct Page {
+		PageState state = PageState::EMPTY;
+		float aspect = DEFAULT_ASPECT;
+		bool aspectKnown = false;
+		std::vector<sf::Image> pendingStripes;
+		std::vector<sf::Texture> textures;
+		float scale = 1.0f;				// strip width / stripe width, narrow pages are upscaled on the GPU
+	};
 
-					imageCount++; // Count this as an image
-				}
+	struct DecodedPage {
+		bool success = false;
+		sf::Vector2u sourceSize;
+		std::vector<sf::Image> stripes;
+	};
 
-				// Skip the data for this entry
-				archive_read_data_skip(archive);
-			}
+	// Set by the task before it wakes the render loop, so the woken thread finds it done; the
+	// future would only become ready after the wake-up callback has returned
+	struct DecodeOutput {
+		DecodedPage page;
+		std::atomic<bool> ready{ false };
+	};
 
-			if (!found)
-			{
-				// Show debug info about what was found
-				std::wstring message = L"EXTRACTION FAILED - DEBUG INFO:\n\n";
-				message += L"Target index: " + std::to_wstring(targetIndex) + L"\n";
-				message += L"Total images found during extraction: " + std::to_wstring(imageCount) + L"\n";
-				message += L"Target path from loadImageEntries: " + UnicodeUtils::stringToWstring(imageEntries[targetIndex].name) + L"\n\n";
-
-				message += L"Images found during extraction:\n";
-				for (int i = 0; i < std::min(5, (int)foundPaths.size()); i++)
-				{
-					message += L"[" + std::to_wstring(i) + L"] " + UnicodeUtils::stringToWstring(foundPaths[i]) + L"\n";
-				}
-				if (foundPaths.size() > 5)
-				{
-					message += L"... and " + std::to_wstring(foundPaths.size() - 5) + L" more\n";
-				}
+	struct DecodeJob {
+		int pageIndex;
+		unsigned int width;
+		std::shared_ptr<DecodeOutput> output;
+		std::future<void> task;
+	};
 
-				LockedMessageBox::showError(message, L"Extraction Debug");
-			}
+	std::vector<Page> pages;
+	// Known page aspects and how many are known; unknown pages take the running average
+	PrefixSumTree knownAspects;
+	PrefixSumTree knownPages;
+	std::vector<DecodeJob> jobs;
+	PageLoader loader;
+	std::function<void()> onPageDecoded;
+	sf::Vector2u viewSize;
+	float stripWidth;
+	float scrollY;
+	double aspectSum;
+	int aspectCount;
+	// Pages that may hold textures or stripes; everything outside is EMPTY, FAILED or DECODING
+	int residentFirst;
+	int residentLast;
+	bool smooth;
 
-			return found;
+public:
+	WebtoonStrip() : pages(), knownAspects(), knownPages(), jobs(), loader(), onPageDecoded(), viewSize(0, 0), stripWidth(0.0f),
+		scrollY(0.0f), aspectSum(0.0), aspectCount(0), residentFirst(0), residentLast(-1), smooth(true) { }
 
-		} catch (const std::exception& e)
-		{
-			ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
-				ErrorDisplayHelper::ErrorContext()
-				.setArchive(archivePathW)
-				.setOperation("extractAndCacheImageInternal Exception")
-				.setDetails(e.what()));
-			return false;
-		} catch (...)
-		{
-			ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
-				ErrorDisplayHelper::ErrorContext()
-				.setArchive(archivePathW)
-				.setOperation("extractAndCacheImageInternal")
-				.setDetails("Unknown exception occurred"));
-			return false;
-		}
+	~WebtoonStrip() {
+		clear();
 	}
-};
 
-class ImageLoadingDispatcher {
-public:
-	struct LoadContext {
-		bool isArchive;
-		ArchiveHandler* archiveHandler;
-		const std::vector<std::wstring>* currentImages;
-		int imageIndex;
-
-		LoadContext(bool archive, ArchiveHandler* handler,
-			const std::vector<std::wstring>* images, int index)
-			: isArchive(archive), archiveHandler(handler),
-			currentImages(images), imageIndex(index) { }
-	};
+	// The loader runs on worker threads; the callback fires there when a decode finishes
+	void setPageLoader(PageLoader pageLoader, std::function<void()> decodedCallback) {
+		loader = std::move(pageLoader);
+		onPageDecoded = std::move(decodedCallback);
+	}
 
-	static ImageLoader::LoadResult loadImageAtIndex(const LoadContext& context) {
-		if (!context.currentImages || context.imageIndex < 0 ||
-			context.imageIndex >= context.currentImages->size())
+	// Waits for in-flight decodes, which may still be reading the current source
+	void clear() {
+		for (auto& job : jobs)
 		{
-			return ImageLoader::LoadResult("Invalid image index");
+			if (job.task.valid()) job.task.wait();
 		}
+		jobs.clear();
+		pages.clear();
+		knownAspects.reset(0);
+		knownPages.reset(0);
+		scrollY = 0.0f;
+		aspectSum = 0.0;
+		aspectCount = 0;
+		residentFirst = 0;
+		residentLast = -1;
+	}
 
-		if (context.isArchive && context.archiveHandler)
-		{
-			return loadFromArchive(context);
-		}
-		else
-		{
-			return loadFromFile(context);
-		}
+	void reset(size_t pageCount) {
+		clear();
+		pages.resize(pageCount);
+		knownAspects.reset(pageCount);
+		knownPages.reset(pageCount);
 	}
 
-	static sf::Vector2u getImageDimensionsAtIndex(const LoadContext& context) {
-		ImageLoader::LoadResult result = loadImageAtIndex(context);
-		if (result.success)
-		{
-			return result.image.getSize();
-		}
-		return sf::Vector2u(0, 0);
+	// A page size known before the page is decoded; unknown pages are laid out like it
+	void setPageSize(int index, sf::Vector2u size) {
+		if (index < 0 || index >= pages.size() || size.x == 0 || size.y == 0) return;
+		setPageAspect(index, static_cast<float>(size.y) / static_cast<float>(size.x));
 	}
 
-private:
-	static ImageLoader::LoadResult loadFromArchive(const LoadContext& context) {
-		std::vector<uint8_t> rawData;
-		if (context.archiveHandler->extractImageToMemory(context.imageIndex, rawData))
+	size_t getPageCount() const { return pages.size(); }
+
+	bool hasPendingWork() const {
+		if (!jobs.empty()) return true;
+		for (int i = residentFirst; i <= residentLast; ++i)
 		{
-			std::string filename = getFilenameFromArchivePath((*context.currentImages)[context.imageIndex]);
-			return ImageLoader::loadImageFromMemory(rawData, filename);
+			if (pages[i].state == PageState::UPLOADING) return true;
 		}
-		return ImageLoader::LoadResult("Failed to extract from archive");
-	}
-
-	static ImageLoader::LoadResult loadFromFile(const LoadContext& context) {
-		return ImageLoader::loadImage((*context.currentImages)[context.imageIndex]);
+		return false;
 	}
 
-	static std::string getFilenameFromArchivePath(const std::wstring& archivePath) {
-		std::string filename = UnicodeUtils::wstringToString(archivePath);
-		size_t hashPos = filename.find('#');
-		if (hashPos != std::string::npos)
+	void setSmooth(bool useSmoothing) {
+		smooth = useSmoothing;
+		for (int i = residentFirst; i <= residentLast; ++i)
 		{
-			filename = filename.substr(hashPos + 1);
+			for (auto& texture : pages[i].textures) texture.setSmooth(smooth);
 		}
-		std::filesystem::path p(filename);
-		return p.filename().string();
 	}
-};
-
-struct FoldersIdent {
-	std::wstring dir;
-	bool isArchieve;
 
-	bool operator<(const FoldersIdent& other) const {
-		return dir < other.dir;  // std::wstring already has operator<
-	}
-};
+	// A width change invalidates every scaled page; the page at the top of the view stays put
+	void setViewSize(sf::Vector2u size) {
+		bool widthChanged = size.x != viewSize.x;
+		viewSize = size;
+		if (!widthChanged) return;
 
-class ConfigManager {
-private:
-	std::wstring configFilePath;
-	std::map<std::string, std::string> configData;
+		int anchor = pageAt(scrollY);
+		float anchorFraction = anchor >= 0 && pageHeight(anchor) > 0.0f ? (scrollY - pageTop(anchor)) / pageHeight(anchor) : 0.0f;
 
-public:
-	ConfigManager(const std::wstring& configPath = L"") : configFilePath() , configData() {
+		stripWidth = static_cast<float>(size.x);
+		releaseResidentPages();
 
-		if (configPath.empty())
-		{
-			// Default to executable directory + "config.ini"
-			wchar_t exePath[MAX_PATH];
-			GetModuleFileNameW(NULL, exePath, MAX_PATH);
-			std::filesystem::path execDir = std::filesystem::path(exePath).parent_path();
-			configFilePath = (execDir / "manga_reader_config.ini").wstring();
-		}
-		else
+		if (anchor >= 0)
 		{
-			configFilePath = configPath;
+			scrollY = pageTop(anchor) + anchorFraction * pageHeight(anchor);
 		}
-		loadConfig();
+		clampScroll();
 	}
 
-	~ConfigManager() {
-		saveConfig();
+	// Returns false when already at the start or end of the strip
+	bool scrollBy(float delta) {
+		float previous = scrollY;
+		scrollY += delta;
+		clampScroll();
+		return scrollY != previous;
 	}
 
-	// Load configuration from INI file
-	bool loadConfig() {
-		configData.clear();
-
-		try
-		{
-			std::ifstream file(configFilePath);
-			if (!file.is_open())
-			{
-				// File doesn't exist yet, that's ok
-				return true;
-			}
-
-			std::string line;
-			std::string currentSection = "";
-
-			while (std::getline(file, line))
-			{
-				line = UnicodeUtils::trim(line);
-
-				// Skip empty lines and comments
-				if (line.empty() || line[0] == ';' || line[0] == '#')
-				{
-					continue;
-				}
-
-				// Check for section headers [section]
-				if (line[0] == '[' && line.back() == ']')
-				{
-					currentSection = line.substr(1, line.length() - 2);
-					continue;
-				}
-
-				// Parse key=value pairs
-				size_t equalPos = line.find('=');
-				if (equalPos != std::string::npos)
-				{
-					std::string key = UnicodeUtils::trim(line.substr(0, equalPos));
-					std::string value = UnicodeUtils::trim(line.substr(equalPos + 1));
-
-					// Remove quotes if present
-					if (value.length() >= 2 && value[0] == '"' && value.back() == '"')
-					{
-						value = value.substr(1, value.length() - 2);
-					}
+	void scrollToPage(int index) {
+		if (index < 0 || index >= static_cast<int>(pages.size())) return;
+		scrollY = pageTop(index);
+		clampScroll();
+	}
 
-					// Store with section prefix if we have one
-					std::string fullKey = currentSection.empty() ? key : currentSection + "." + key;
-					configData[fullKey] = value;
-				}
-			}
+	// The page a reader is looking at: the one a third of the way down the window
+	int getCurrentPage() const {
+		return pageAt(scrollY + viewSize.y / 3.0f);
+	}
 
-			file.close();
-			return true;
+	sf::Vector2u getPageSize(int index) const {
+		if (index < 0 || index >= static_cast<int>(pages.size()) || pages[index].textures.empty()) return sf::Vector2u(0, 0);
+		return sf::Vector2u(static_cast<unsigned int>(stripWidth), static_cast<unsigned int>(pageHeight(index)));
+	}
 
-		} catch (const std::exception& e)
+	size_t getResidentPageCount() const {
+		size_t count = 0;
+		for (int i = residentFirst; i <= residentLast; ++i)
 		{
-			return false;
+			if (!pages[i].textures.empty()) ++count;
 		}
+		return count;
 	}
 
-	// Save configuration to INI file
-	bool saveConfig() {
-		try
+	// Collects finished decodes, uploads a few stripes and schedules/evicts pages around the view.
+	// Returns true if anything visible may have changed.
+	bool update() {
+		if (pages.empty() || stripWidth <= 0.0f) return false;
+
+		bool changed = collectFinishedJobs();
+		changed |= uploadPendingStripes();
+
+		// Residency window: the viewport plus one screen above and below
+		const float margin = static_cast<float>(viewSize.y);
+		const int first = std::max(0, pageAt(scrollY - margin));
+		const int last = std::max(first, pageAt(scrollY + viewSize.y + margin));
+
+		for (int i = residentFirst; i <= residentLast; ++i)
 		{
-			std::ofstream file(configFilePath);
-			if (!file.is_open())
-			{
-				return false;
-			}
+			if (i < first || i > last) releasePage(pages[i]);
+		}
+		residentFirst = first;
+		residentLast = last;
 
-			file << "; Manga Reader Configuration File\n";
-			file << "; Auto-generated - modify with care\n\n";
+		// Visible pages first, then the margin below, then above
+		const int firstVisible = std::max(0, pageAt(scrollY));
+		const int lastVisible = std::max(firstVisible, pageAt(scrollY + viewSize.y));
+		for (int i = firstVisible; i <= lastVisible; ++i) scheduleDecode(i);
+		for (int i = lastVisible + 1; i <= last; ++i) scheduleDecode(i);
+		for (int i = firstVisible - 1; i >= first; --i) scheduleDecode(i);
 
-			// Group by sections
-			std::map<std::string, std::map<std::string, std::string>> sections;
+		return changed;
+	}
 
-			for (const auto& pair : configData)
-			{
-				size_t dotPos = pair.first.find('.');
-				if (dotPos != std::string::npos)
-				{
-					std::string section = pair.first.substr(0, dotPos);
-					std::string key = pair.first.substr(dotPos + 1);
-					sections[section][key] = pair.second;
-				}
-				else
-				{
-					sections[""][pair.first] = pair.second;
-				}
-			}
+	void draw(sf::RenderWindow& window) const {
+		if (pages.empty()) return;
 
-			// Write sections
-			for (const auto& section : sections)
+		const int first = std::max(0, pageAt(scrollY));
+		const int last = pageAt(scrollY + viewSize.y);
+		float y = pageTop(first) - scrollY;
+		for (int i = first; i <= last && i < static_cast<int>(pages.size()); ++i)
+		{
+			const Page& page = pages[i];
+			float stripeY = y;
+			for (const auto& texture : page.textures)
 			{
-				if (!section.first.empty())
-				{
-					file << "[" << section.first << "]\n";
-				}
-
-				for (const auto& keyValue : section.second)
+				float height = texture.getSize().y * page.scale;
+				if (stripeY + height >= 0.0f && stripeY <= viewSize.y)
 				{
-					file << keyValue.first << "=" << keyValue.second << "\n";
+					sf::Sprite sprite(texture);
+					sprite.setScale(sf::Vector2f(page.scale, page.scale));
+					sprite.setPosition(sf::Vector2f(0.0f, stripeY));
+					window.draw(sprite);
 				}
-
-				file << "\n";
+				stripeY += height;
 			}
+			y += pageHeight(i);
+		}
+	}
 
-			file.close();
-			return true;
+private:
+	float estimatedAspect() const {
+		return aspectCount > 0 ? static_cast<float>(aspectSum / aspectCount) : DEFAULT_ASPECT;
+	}
 
-		} catch (const std::exception& e)
-		{
-			return false;
-		}
+	float pageHeight(int index) const {
+		return (pages[index].aspectKnown ? pages[index].aspect : estimatedAspect()) * stripWidth;
 	}
 
-	// Get string value
-	std::string getString(const std::string& key, const std::string& defaultValue = "") {
-		auto it = configData.find(key);
-		return (it != configData.end()) ? it->second : defaultValue;
+	// Strip coordinate of the top of a page; pageTop(pages.size()) is the strip height
+	float pageTop(int index) const {
+		double known = knownPages.prefix(index);
+		double aspects = knownAspects.prefix(index) + (index - known) * estimatedAspect();
+		return static_cast<float>(aspects * stripWidth);
 	}
 
-	// Get wide string value
-	std::wstring getWString(const std::string& key, const std::wstring& defaultValue = L"") {
-		std::string value = getString(key);
-		return value.empty() ? defaultValue : UnicodeUtils::stringToWstring(value);
+	float totalHeight() const {
+		return pageTop(static_cast<int>(pages.size()));
 	}
 
-	// Get integer value
-	int getInt(const std::string& key, int defaultValue = 0) {
-		std::string value = getString(key);
-		if (value.empty()) return defaultValue;
+	// Index of the page containing strip coordinate y, clamped to the strip
+	int pageAt(float y) const {
+		if (pages.empty()) return -1;
 
-		try
+		int low = 0;
+		int high = static_cast<int>(pages.size()) - 1;
+		while (low < high)
 		{
-			return std::stoi(value);
-		} catch (...)
-		{
-			return defaultValue;
+			int mid = low + (high - low + 1) / 2;
+			if (pageTop(mid) <= y) low = mid;
+			else high = mid - 1;
 		}
+		return low;
 	}
 
-	// Get boolean value
-	bool getBool(const std::string& key, bool defaultValue = false) {
-		std::string value = getString(key);
-		if (value.empty()) return defaultValue;
-
-		std::transform(value.begin(), value.end(), value.begin(), ::tolower);
-		return (value == "true" || value == "1" || value == "yes" || value == "on");
+	void clampScroll() {
+		float maxScroll = std::max(0.0f, totalHeight() - static_cast<float>(viewSize.y));
+		scrollY = std::clamp(scrollY, 0.0f, maxScroll);
 	}
 
-	// Get float value
-	float getFloat(const std::string& key, float defaultValue = 0.0f) {
-		std::string value = getString(key);
-		if (value.empty()) return defaultValue;
+	// Content at the top of the view keeps its screen position when height estimates are corrected
+	void setPageAspect(int index, float aspect) {
+		int anchor = pageAt(scrollY);
+		float anchorOffset = scrollY - pageTop(anchor);
 
-		try
+		Page& page = pages[index];
+		if (page.aspectKnown)
 		{
-			return std::stof(value);
-		} catch (...)
+			aspectSum += aspect - page.aspect;
+			knownAspects.add(index, aspect - page.aspect);
+		}
+		else
 		{
-			return defaultValue;
+			aspectSum += aspect;
+			++aspectCount;
+			knownAspects.add(index, aspect);
+			knownPages.add(index, 1.0);
 		}
-	}
+		page.aspectKnown = true;
+		page.aspect = aspect;
 
-	// Set string value
-	void setString(const std::string& key, const std::string& value) {
-		configData[key] = value;
+		scrollY = pageTop(anchor) + std::min(anchorOffset, pageHeight(anchor));
+		clampScroll();
 	}
 
-	// Set wide string value
-	void setWString(const std::string& key, const std::wstring& value) {
-		configData[key] = UnicodeUtils::wstringToString(value);
+	void releasePage(Page& page) {
+		if (page.state == PageState::DECODING) return;
+		page.textures.clear();
+		page.pendingStripes.clear();
+		if (page.state != PageState::FAILED) page.state = PageState::EMPTY;
 	}
 
-	// Set integer value
-	void setInt(const std::string& key, int value) {
-		configData[key] = std::to_string(value);
+	void releaseResidentPages() {
+		for (int i = residentFirst; i <= residentLast; ++i)
+		{
+			releasePage(pages[i]);
+		}
+		residentFirst = 0;
+		residentLast = -1;
 	}
 
-	// Set boolean value
-	void setBool(const std::string& key, bool value) {
-		configData[key] = value ? "true" : "false";
+	bool isResident(int index) const {
+		return index >= residentFirst && index <= residentLast;
 	}
 
-	// Set float value
-	void setFloat(const std::string& key, float value) {
-		configData[key] = std::to_string(value);
-	}
+	void scheduleDecode(int index) {
+		if (!loader || jobs.size() >= MAX_DECODES_IN_FLIGHT) return;
+		if (pages[index].state != PageState::EMPTY) return;
 
-	// Check if key exists
-	bool hasKey(const std::string& key) {
-		return configData.find(key) != configData.end();
-	}
+		pages[index].state = PageState::DECODING;
+		unsigned int width = static_cast<unsigned int>(stripWidth);
+		PageLoader pageLoader = loader;
+		std::function<void()> callback = onPageDecoded;
+		auto output = std::make_shared<DecodeOutput>();
 
-	// Remove a key
-	void removeKey(const std::string& key) {
-		configData.erase(key);
+		jobs.push_back({ index, width, output, std::async(std::launch::async, [pageLoader, callback, output, index, width]() {
+			DecodedPage& decoded = output->page;
+			ImageLoader::LoadResult result = pageLoader(index);
+			if (result.success)
+			{
+				decoded.sourceSize = result.sourceSize;
+				if (result.isStriped())
+				{
+					for (const auto& stripe : result.stripes)
+					{
+						std::vector<sf::Image> scaled;
+						ImageStripeBuilder::build(stripe.getPixelsPtr(), stripe.getSize(), width, ImageLoader::STRIPE_HEIGHT, scaled);
+						std::move(scaled.begin(), scaled.end(), std::back_inserter(decoded.stripes));
+					}
+				}
+				else
+				{
+					ImageStripeBuilder::build(result.image.getPixelsPtr(), result.image.getSize(), width, ImageLoader::STRIPE_HEIGHT, decoded.stripes);
+				}
+				decoded.success = !decoded.stripes.empty();
+			}
+			output->ready.store(true, std::memory_order_release);
+			if (callback) callback();
+		}) });
 	}
 
-	// Get config file path
-	std::wstring getConfigFilePath() const {
-		return configFilePath;
-	}
+	bool collectFinishedJobs() {
+		bool changed = false;
+		for (auto it = jobs.begin(); it != jobs.end();)
+		{
+			if (!it->output->ready.load(std::memory_order_acquire))
+			{
+				++it;
+				continue;
+			}
 
-	// Force save config now
-	void forceSave() {
-		saveConfig();
-	}
-};
+			DecodedPage decoded = std::move(it->output->page);
+			Page& page = pages[it->pageIndex];
+			int index = it->pageIndex;
+			bool stale = it->width != static_cast<unsigned int>(stripWidth);
+			it = jobs.erase(it);
 
-enum class ButtonID {
-	INFO_BUTTON,
-	PREVIOUS_FOLDER,
-	NEXT_FOLDER,
-	SETTINGS_BUTTON,
-	HELP_BUTTON,
-	DELETE_BUTTON,
-	COUNT
-};
+			if (!decoded.success)
+			{
+				page.state = PageState::FAILED;
+				continue;
+			}
 
-enum class SessionChoice {
-	RESTORE_SESSION,
-	NEW_SESSION,
-	CANCELLED
-};
+			// The size is worth keeping even when the pixels are not: it fixes the layout
+			page.state = PageState::EMPTY;
+			setPageAspect(index, static_cast<float>(decoded.sourceSize.y) / static_cast<float>(decoded.sourceSize.x));
+			changed = true;
+			if (stale || !isResident(index)) continue;
 
-class UIButton {
-public:
-	struct ButtonConfig {
-		std::string text = "?";
-		sf::Color backgroundColor = sf::Color(100, 100, 100, 200);
-		sf::Color textColor = sf::Color::White;
-		sf::Color outlineColor = sf::Color::White;
-		sf::Color disabledBgColor = sf::Color(60, 60, 60, 150);
-		sf::Color disabledTextColor = sf::Color(150, 150, 150);
-		bool hasCircularBg = true;
-		unsigned int fontSize = 18;
-	};
+			page.pendingStripes = std::move(decoded.stripes);
+			page.scale = stripWidth / static_cast<float>(page.pendingStripes.front().getSize().x);
+			page.state = PageState::UPLOADING;
+		}
+		return changed;
+	}
 
-private:
-	ButtonID buttonID;
-	sf::RectangleShape button;
-	sf::CircleShape circularBg;
-	sf_text_wrapper buttonText;
-	sf::Vector2f position;
-	float size;
-	bool isEnabled;
-	bool hasToggleState;
-	bool isToggled;
-	ButtonConfig config;
+	// Texture creation has to happen on the thread that owns the GL context
+	bool uploadPendingStripes() {
+		size_t budget = MAX_UPLOADS_PER_UPDATE;
+		bool changed = false;
+		for (int i = residentFirst; i <= residentLast && budget > 0; ++i)
+		{
+			Page& page = pages[i];
+			if (page.state != PageState::UPLOADING) continue;
 
-public:
+			while (budget > 0 && page.textures.size() < page.pendingStripes.size())
+			{
+				sf::Texture texture;
+				if (texture.loadFromImage(page.pendingStripes[page.textures.size()]))
+				{
+					texture.setSmooth(smooth);
+				}
+				page.textures.push_back(std::move(texture));
+				--budget;
+				changed = true;
+			}
 
-	UIButton() : buttonID(ButtonID::INFO_BUTTON), button(), circularBg(), buttonText(),
-		position(0, 0), size(30.0f), isEnabled(true), hasToggleState(false),
-		isToggled(false), config() { }
+			if (page.textures.size() == page.pendingStripes.size())
+			{
+				page.pendingStripes.clear();
+				page.state = PageState::READY;
+			}
+		}
+		return changed;
+	}
+};
 
-	// Delete copy constructor and copy assignment
-	UIButton(const UIButton&) = delete;
-	UIButton& operator=(const UIButton&) = delete;
+// Frame and wake-up counters for the render loop, plus process CPU use between samples
+class RenderLoopStats {
+private:
+	ULONGLONG lastCpuTime;			// kernel + user time, 100ns units
+	std::chrono::steady_clock::time_point lastSample;
+	double cpuPercent;
+	size_t framesRendered;
+	size_t wakeups;
+	size_t framesSinceSample;
+	size_t wakeupsSinceSample;
+	size_t lastFrames;
+	size_t lastWakeups;
+
+	// Page turn latency: from the turn request to the first frame showing the new page
+	std::chrono::steady_clock::time_point pageTurnStart;
+	bool pageTurnPending;
+	double lastPageTurnMs;
+	double averagePageTurnMs;
+	size_t pageTurns;
 
-	// Add move constructor and move assignment
-	UIButton(UIButton&&) = default;
-	UIButton& operator=(UIButton&&) = default;
+public:
+	RenderLoopStats() : lastCpuTime(readProcessCpuTime()), lastSample(std::chrono::steady_clock::now()), cpuPercent(0.0),
+		framesRendered(0), wakeups(0), framesSinceSample(0), wakeupsSinceSample(0), lastFrames(0), lastWakeups(0),
+		pageTurnStart(), pageTurnPending(false), lastPageTurnMs(0.0), averagePageTurnMs(0.0), pageTurns(0) { }
 
-	void initialize(const sf::Font& font, ButtonID id, float x, float y,
-		const ButtonConfig& buttonConfig, float buttonSize = 30.0f) {
-		buttonID = id;
-		config = buttonConfig;
-		size = buttonSize;
-		position = sf::Vector2f(x, y);
+	void onWakeup() { ++wakeups; ++wakeupsSinceSample; }
 
-		// Setup button background
-		button.setSize(sf::Vector2f(size, size));
-		button.setPosition(position);
-		button.setOutlineThickness(1);
+	void onFrame() {
+		++framesRendered;
+		++framesSinceSample;
 
-		// Setup circular background if needed
-		if (config.hasCircularBg)
+		if (pageTurnPending)
 		{
-			circularBg.setRadius(size / 2 - 3);
-			circularBg.setPosition(sf::Vector2f(x + 3, y + 3));
+			pageTurnPending = false;
+			lastPageTurnMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - pageTurnStart).count();
+			++pageTurns;
+			averagePageTurnMs += (lastPageTurnMs - averagePageTurnMs) / static_cast<double>(pageTurns);
 		}
+	}
 
-		// Setup text
-		buttonText.initialize(font, config.fontSize);
-		buttonText.get()->setString(config.text);
-		buttonText.get()->setStyle(sf::Text::Bold);
+	void beginPageTurn() {
+		pageTurnStart = std::chrono::steady_clock::now();
+		pageTurnPending = true;
+	}
 
-		// Set initial appearance
-		updateAppearance();
-		centerText();
+	std::string getPageTurnString() const {
+		if (pageTurns == 0) return "n/a";
+		return std::to_string(std::lround(lastPageTurnMs)) + " ms last, " + std::to_string(std::lround(averagePageTurnMs)) +
+			" ms avg over " + std::to_string(pageTurns);
 	}
 
-	void updatePosition(float x, float y) {
-		position = sf::Vector2f(x, y);
-		button.setPosition(position);
+	// Returns true when a new sample was taken
+	bool sample(std::chrono::milliseconds interval) {
+		auto now = std::chrono::steady_clock::now();
+		if (now - lastSample < interval) return false;
 
-		if (config.hasCircularBg)
-		{
-			circularBg.setPosition(sf::Vector2f(x + 3, y + 3));
-		}
+		ULONGLONG cpuTime = readProcessCpuTime();
+		double wallMicros = std::chrono::duration<double, std::micro>(now - lastSample).count();
+		cpuPercent = wallMicros > 0.0 ? (static_cast<double>(cpuTime - lastCpuTime) / 10.0) / wallMicros * 100.0 : 0.0;
 
-		centerText();
+		lastCpuTime = cpuTime;
+		lastSample = now;
+		lastFrames = framesSinceSample;
+		lastWakeups = wakeupsSinceSample;
+		framesSinceSample = 0;
+		wakeupsSinceSample = 0;
+		return true;
 	}
 
-	void setEnabled(bool enabled) {
-		isEnabled = enabled;
-		updateAppearance();
-	}
+	// Percent of one core over the last sample interval
+	double getCpuPercent() const { return cpuPercent; }
 
-	void setToggleState(bool canToggle, bool initialState = false) {
-		hasToggleState = canToggle;
-		isToggled = initialState;
-		updateAppearance();
+	std::string getCpuPercentString() const {
+		long tenths = std::lround(cpuPercent * 10.0);
+		return std::to_string(tenths / 10) + "." + std::to_string(tenths % 10) + "%";
 	}
+	size_t getFramesRendered() const { return framesRendered; }
+	size_t getLastIntervalFrames() const { return lastFrames; }
+	size_t getLastIntervalWakeups() const { return lastWakeups; }
 
-	void toggle() {
-		if (hasToggleState)
+private:
+	static ULONGLONG readProcessCpuTime() {
+		FILETIME creationTime, exitTime, kernelTime, userTime;
+		if (!GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime))
 		{
-			isToggled = !isToggled;
-			updateAppearance();
+			return 0;
 		}
+
+		ULARGE_INTEGER kernel, user;
+		kernel.LowPart = kernelTime.dwLowDateTime;
+		kernel.HighPart = kernelTime.dwHighDateTime;
+		user.LowPart = userTime.dwLowDateTime;
+		user.HighPart = userTime.dwHighDateTime;
+		return kernel.QuadPart + user.QuadPart;
 	}
+};
 
-	bool isClicked(sf::Vector2f mousePos, float expandBy = 5.0f) const {
-		if (!isEnabled) return false;
+// Multi-producer, single-consumer completion list. Workers push without locking; the consumer
+// takes the whole list with one exchange, so there is no ABA window.
+template <typename T>
+class CompletionQueue {
+private:
+	struct Node {
+		T value;
+		Node* next;
+	};
 
-		sf::FloatRect bounds = button.getGlobalBounds();
-		bounds.position.x -= expandBy;
-		bounds.position.y -= expandBy;
-		bounds.size.x += expandBy * 2;
-		bounds.size.y += expandBy * 2;
+	std::atomic<Node*> head;
 
-		return bounds.contains(mousePos);
+public:
+	CompletionQueue() : head(nullptr) { }
+
+	~CompletionQueue() {
+		drain([](T&&) { });
 	}
 
-	// Getters
-	ButtonID getID() const { return buttonID; }
-	bool getIsEnabled() const { return isEnabled; }
-	bool getIsToggled() const { return isToggled; }
-	sf::Vector2f getPosition() const { return position; }
-	float getSize() const { return size; }
-	sf::FloatRect getBounds() const { return button.getGlobalBounds(); }
+	CompletionQueue(const CompletionQueue&) = delete;
+	CompletionQueue& operator=(const CompletionQueue&) = delete;
 
-	void draw(sf::RenderWindow& window) {
-		window.draw(button);
-		if (config.hasCircularBg)
+	void push(T value) {
+		Node* node = new Node{ std::move(value), head.load(std::memory_order_relaxed) };
+		while (!head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed))
 		{
-			window.draw(circularBg);
 		}
-		window.draw(*buttonText.get());
 	}
 
-private:
-	void updateAppearance() {
-		if (isEnabled)
+	// Consumer side only; hands items over in the order they were pushed
+	template <typename Fn>
+	size_t drain(Fn&& consume) {
+		Node* list = head.exchange(nullptr, std::memory_order_acquire);
+
+		Node* ordered = nullptr;
+		while (list)
 		{
-			if (hasToggleState && isToggled)
-			{
-				// Toggled state (brighter/different color)
-				button.setFillColor(sf::Color(100, 160, 210, 220));
-				button.setOutlineColor(sf::Color::Cyan);
-				if (config.hasCircularBg)
-				{
-					circularBg.setFillColor(sf::Color(200, 230, 255, 180));
-				}
-				buttonText.get()->setFillColor(sf::Color(70, 130, 180));
-			}
-			else
-			{
-				// Normal enabled state
-				button.setFillColor(config.backgroundColor);
-				button.setOutlineColor(config.outlineColor);
-				if (config.hasCircularBg)
-				{
-					circularBg.setFillColor(sf::Color(255, 255, 255, 180));
-				}
-				buttonText.get()->setFillColor(config.textColor);
-			}
+			Node* next = list->next;
+			list->next = ordered;
+			ordered = list;
+			list = next;
 		}
-		else
+
+		size_t count = 0;
+		while (ordered)
 		{
-			// Disabled state
-			button.setFillColor(config.disabledBgColor);
-			button.setOutlineColor(sf::Color(120, 120, 120));
-			if (config.hasCircularBg)
-			{
-				circularBg.setFillColor(sf::Color(200, 200, 200, 100));
-			}
-			buttonText.get()->setFillColor(config.disabledTextColor);
+			Node* next = ordered->next;
+			consume(std::move(ordered->value));
+			delete ordered;
+			ordered = next;
+			++count;
 		}
-	}
-
-	void centerText() {
-		sf::FloatRect textBounds = buttonText.get()->getLocalBounds();
-		buttonText.get()->setPosition(sf::Vector2f(
-			position.x + (size - textBounds.size.x) / 2 - textBounds.position.x,
-			position.y + (size - textBounds.size.y) / 2 - textBounds.position.y
-		));
+		return count;
 	}
 };
 
-class UIButtonManager {
-private:
-	std::vector<std::unique_ptr<UIButton>> buttons;
-	std::map<ButtonID, size_t> buttonIndexMap;
-	mutable std::shared_mutex buttonMutex;
+// Neighbouring pages scaled to their display size on a worker and uploaded during idle frames,
+// so a page turn that lands on one of them only swaps textures
+class PageUploadCache {
 public:
-	UIButtonManager() : buttons(), buttonIndexMap(), buttonMutex() { buttons.reserve(10); }
+	struct Key {
+		int index = -1;
+		sf::Vector2u size;
+		bool smooth = false;
 
-	UIButton* getButtonInternal(ButtonID id) {
-		auto it = buttonIndexMap.find(id);
-		return (it != buttonIndexMap.end()) ? buttons[it->second].get() : nullptr;
-	}
+		bool operator==(const Key& other) const {
+			return index == other.index && size == other.size && smooth == other.smooth;
+		}
+	};
 
-	void addButton(const sf::Font& font, ButtonID id, float x, float y,
-		const UIButton::ButtonConfig& config, float size = 30.0f) {
-		std::unique_lock<std::shared_mutex> lock(buttonMutex);
-		size_t index = buttons.size();
-		auto button = std::make_unique<UIButton>();
-		button->initialize(font, id, x, y, config, size);
-		buttons.push_back(std::move(button));
-		buttonIndexMap[id] = index;
-	}
+	using ScaleJob = std::function<sf::Image()>;
 
-	template<typename Func>
-	auto withButton(ButtonID id, Func&& func) -> decltype(func(std::declval<UIButton*>())) {
-		std::shared_lock<std::shared_mutex> lock(buttonMutex);  // Shared lock for reading
-		UIButton* btn = getButtonInternal(id);
-		return func(btn);
-	}
+private:
+	static constexpr size_t SLOT_COUNT = 2;	// next and previous page
 
-	// Get button by ID
-	UIButton* getButton(ButtonID id) {
-		std::shared_lock<std::shared_mutex> lock(buttonMutex);  // NEW: Shared lock
-		return getButtonInternal(id);
-	}
+	struct Slot {
+		Key key;
+		std::future<sf::Image> job;
+		sf::Texture texture;
+		bool ready = false;
+	};
 
-	// Update all button positions (useful for window resize)
-	void updateAllPositions(const std::function<sf::Vector2f(ButtonID)>& positionCalculator) {
-		std::unique_lock<std::shared_mutex> lock(buttonMutex);  // NEW: Exclusive lock
-		for (auto& button : buttons)
+	std::array<Slot, SLOT_COUNT> slots;
+	std::vector<std::future<sf::Image>> retiredJobs;	// superseded jobs, reaped once finished
+	std::function<void()> onJobFinished;
+	size_t hits;
+	size_t misses;
+
+public:
+	PageUploadCache() : slots(), retiredJobs(), onJobFinished(), hits(0), misses(0) { }
+
+	// Retired jobs call back into the cache, so it outlives them
+	~PageUploadCache() {
+		clear();
+		for (auto& job : retiredJobs)
 		{
-			sf::Vector2f newPos = positionCalculator(button->getID());
-			button->updatePosition(newPos.x, newPos.y);
+			job.wait();
 		}
 	}
 
-	// Check which button was clicked (returns ButtonID::COUNT if none)
-	ButtonID checkButtonClick(sf::Vector2f mousePos, float expandBy = 5.0f) {
-		std::shared_lock<std::shared_mutex> lock(buttonMutex);  // NEW: Shared lock
-		for (const auto& button : buttons)
+	void setCallback(std::function<void()> callback) {
+		onJobFinished = std::move(callback);
+	}
+
+	// Keeps slots that already hold a wanted page and reuses the others for the missing ones
+	void prepare(const std::vector<std::pair<Key, ScaleJob>>& wanted) {
+		std::array<bool, SLOT_COUNT> keep{};
+		std::vector<const std::pair<Key, ScaleJob>*> missing;
+
+		for (const auto& request : wanted)
 		{
-			if (button->isClicked(mousePos, expandBy))
+			bool found = false;
+			for (size_t i = 0; i < SLOT_COUNT; ++i)
 			{
-				return button->getID();
+				if (slots[i].key == request.first)
+				{
+					keep[i] = true;
+					found = true;
+				}
 			}
+			if (!found) missing.push_back(&request);
+		}
+
+		for (size_t i = 0; i < SLOT_COUNT && !missing.empty(); ++i)
+		{
+			if (keep[i]) continue;
+
+			Slot& slot = slots[i];
+			retire(slot);
+			slot.key = missing.back()->first;
+			ScaleJob job = missing.back()->second;
+			missing.pop_back();
+
+			slot.job = std::async(std::launch::async, [job, this]() {
+				sf::Image image = job();
+				if (onJobFinished) onJobFinished();
+				return image;
+				});
 		}
-		return ButtonID::COUNT;
 	}
 
-	// Batch operations
-	void enableButton(ButtonID id, bool enabled) {
-		withButton(id, [enabled](UIButton* btn) {
-			if (btn) btn->setEnabled(enabled);
-			return true;
+	// Uploads at most one finished page per call so a frame never pays for more than one upload
+	bool update() {
+		std::erase_if(retiredJobs, [](std::future<sf::Image>& job) {
+			return job.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
 			});
-	}
 
-	void toggleButton(ButtonID id) {
-		withButton(id, [](UIButton* btn) {
-			if (btn) btn->toggle();
+		for (Slot& slot : slots)
+		{
+			if (!slot.job.valid() || slot.job.wait_for(std::chrono::seconds(0)) != std::future_status::ready) continue;
+
+			// A failed page keeps its key so it isn't retried for the same turn
+			sf::Image image = slot.job.get();
+			slot.ready = image.getSize().x > 0 && slot.texture.loadFromImage(image);
 			return true;
-			});
+		}
+		return false;
 	}
 
-	bool isButtonToggled(ButtonID id) {
-		return withButton(id, [](UIButton* btn) {
-			return btn ? btn->getIsToggled() : false;
-			});
+	// Swaps a prepared texture into out when it matches exactly what the page turn needs
+	bool take(const Key& key, sf::Texture& out) {
+		for (Slot& slot : slots)
+		{
+			if (slot.ready && slot.key == key)
+			{
+				std::swap(out, slot.texture);
+				slot.texture = sf::Texture();
+				slot.ready = false;
+				slot.key = Key();
+				++hits;
+				return true;
+			}
+		}
+		++misses;
+		return false;
 	}
 
-	// Render all buttons
-	void drawAll(sf::RenderWindow& window) {
-		std::shared_lock<std::shared_mutex> lock(buttonMutex);
-		for (auto& button : buttons)
+	// Doesn't block: running scale jobs are retired and reaped by update() once they finish
+	void clear() {
+		for (Slot& slot : slots)
 		{
-			button->draw(window);
+			retire(slot);
 		}
 	}
 
-	// Get button count
-	size_t getButtonCount() const {
-		std::shared_lock<std::shared_mutex> lock(buttonMutex);
-		return buttons.size();
+	bool hasPendingWork() const {
+		for (const Slot& slot : slots)
+		{
+			if (slot.job.valid()) return true;
+		}
+		return false;
 	}
 
-	// Clear all buttons
-	void clear() {
-		std::unique_lock<std::shared_mutex> lock(buttonMutex);
-		buttons.clear();
-		buttonIndexMap.clear();
+	size_t getHitCount() const { return hits; }
+	size_t getMissCount() const { return misses; }
+
+private:
+	void retire(Slot& slot) {
+		if (slot.job.valid())
+		{
+			retiredJobs.push_back(std::move(slot.job));
+		}
+		slot.key = Key();
+		slot.texture = sf::Texture();
+		slot.ready = false;
 	}
 };
 
-static constexpr const char* CONFIG_SECTION = "Settings";
-static constexpr const char* CONFIG_LAST_FOLDER = "Settings.lastMangaFolder";
-static constexpr const char* CONFIG_LAST_FOLDER_INDEX = "Settings.lastFolderIndex";
-static constexpr const char* CONFIG_LAST_IMAGE_INDEX = "Settings.lastImageIndex";
-static constexpr const char* CONFIG_WINDOW_WIDTH = "Settings.windowWidth";
-static constexpr const char* CONFIG_WINDOW_HEIGHT = "Settings.windowHeight";
-static constexpr const char* CONFIG_WINDOW_MAXIMIZED = "Settings.windowMaximized";
-static constexpr const char* CONFIG_WINDOW_FULLSCREEN = "Settings.windowFullscreen";
-static constexpr const char* CONFIG_USE_SMOOTHING = "Settings.useSmoothing";
-static constexpr const char* CONFIG_ASK_SESSION_RESTORE = "Settings.askSessionRestore";
-static constexpr const char* CONFIG_LAST_SESSION_EXISTS = "Settings.lastSessionExists";
-static constexpr const char* CONFIG_SHOW_SESSION_SUCCESS = "Settings.showSessionSuccessDialog";
-
-
 struct CommandLineOptions {
 	bool enableLongPaths = false;
 	bool showPathInfo = false;
@@ -2666,23 +1736,38 @@ struct CommandLineOptions {
 	std::string mangaFolder = "";
 };
 
+// Taken during static initialisation, as close to process start as this file gets
+static const std::chrono::steady_clock::time_point processStartTime = std::chrono::steady_clock::now();
+
 class MangaReader {
 private:
 	CommandLineOptions cmdOptions;
 
 	sf::RenderWindow window;
 
-	sf::Texture originalTexture;      // Store original high-res texture
+	TiledPage tiledPage;              // Full-resolution page, tiles streamed in for zoomed and oversized views
+	TiledPage companionPage;          // Second page of a two-page spread, drawn next to tiledPage
 	sf::Texture scaledTexture;        // Store scaled texture for display
+	sf::Texture companionScaledTexture; // The companion page's counterpart of scaledTexture
 
 	sf_Sprite_wrapper currentSprite;
+	sf_Sprite_wrapper companionSprite;
+	int pendingCompanionIndex;        // Spread partner being decoded for the current page, -1 if none
+	WebtoonStrip webtoonStrip;        // All pages of the source in one scrollable strip
+	bool webtoonMode;
+	bool spreadMode;
+	bool rightToLeft;
 	sf_font_wrapper font;
 	sf_text_wrapper statusText;
 	sf_text_wrapper helpText;
 	sf_text_wrapper detailedInfoText;
 
 	std::vector<FoldersIdent> folders;
-	std::vector<std::wstring> currentImages;
+	LibraryIndex libraryIndex;          // Last scan of the library, so startup skips unchanged directories
+	LibraryScanner libraryScanner;      // Fills folders in the background after a root is chosen
+	LibraryWatcher libraryWatcher;      // Picks up sources added to or removed from the root while reading
+	ReadingProgress readingProgress;    // Where each title was left, so reopening one resumes there
+	PageList currentImages;             // Pages of the open source
 	int currentFolderIndex;
 	int currentImageIndex;
 
@@ -2705,18 +1790,80 @@ private:
 
 	struct LoadedImageData {
 		sf::Image image;
+		std::vector<sf::Image> stripes;
+		sf::Vector2u sourceSize;
 		std::string filename;
 		size_t fileSize;
-		bool isLoaded;
 
-		LoadedImageData() : fileSize(0), isLoaded(false) { }
+		LoadedImageData() : fileSize(0) { }
 	};
 
-	std::vector<LoadedImageData> loadedImages;
-	std::mutex loadingMutex;
+	enum class PageSlotState : uint8_t {
+		EMPTY,
+		DECODING,
+		READY,
+		EVICTED
+	};
+
+	// Workers only claim a slot (EMPTY or EVICTED -> DECODING); data is written by the UI thread
+	// when it publishes or evicts the page. Readers on other threads check READY and then load
+	// data atomically, so an eviction racing with them leaves them holding a page or nothing.
+	struct PageSlot {
+		std::atomic<PageSlotState> state;
+		std::atomic<std::shared_ptr<const LoadedImageData>> data;
+
+		PageSlot() : state(PageSlotState::EMPTY), data() { }
+	};
+
+	// Fixed-size slot array; atomics can't live in a resizable vector
+	class PageSlotTable {
+	private:
+		std::unique_ptr<PageSlot[]> slots;
+		size_t count;
+
+	public:
+		PageSlotTable() : slots(), count(0) { }
+
+		void reset(size_t size) {
+			slots = size > 0 ? std::make_unique<PageSlot[]>(size) : nullptr;
+			count = size;
+		}
+
+		size_t size() const { return count; }
+		PageSlot& operator[](size_t index) { return slots[index]; }
+		const PageSlot& operator[](size_t index) const { return slots[index]; }
+	};
+
+	struct DecodedPage {
+		CancellationToken token;
+		int index;
+		std::shared_ptr<const LoadedImageData> data;	// null when the decode failed
+	};
+
+	PageSlotTable loadedImages;
+	CompletionQueue<DecodedPage> decodedPages;	// Filled by folder workers, drained by the UI thread
 	std::atomic<bool> isLoadingFolder;
+	bool folderDecodeStarted;			// for the current source; not in webtoon mode until it is left
 	std::atomic<int> loadingProgress;
 	std::future<void> folderLoadingFuture;
+	std::vector<std::future<void>> pageDecodeJobs;	// Single pages decoded outside the folder load
+	FolderGeneration folderGeneration;  // Advanced on every folder switch to cancel queued work
+	double lastCancelMs;                // How long the last switch waited for cancelled work
+	double firstPixelMs;                // Process start to the first page on screen, -1 until then
+	double firstPageDecodeMs;           // Decode of the page a folder was opened at (session restore)
+#ifdef MANGAREADER_COUNT_CONVERSIONS
+	size_t lastTurnConversions;         // Made on the UI thread by the last loadCurrentImage
+#endif
+
+	// Next/previous source opened ahead of time once the reader is far enough into this one
+	FolderPrefetcher folderPrefetcher;
+	PagePrefetcher pagePrefetcher;      // Archive entries around the current page, sized by reading speed
+	bool currentPageWasReady;           // Whether the page being shown was decoded or cached before the turn
+	PageUploadCache pageUploads;        // Next/previous page already scaled and on the GPU
+	bool pageTurnTexturePending;        // The page just set up hasn't got its scaled texture yet
+	float folderPrefetchThreshold;      // Fraction of the current source read before prefetching
+	int folderPrefetchPages;
+	bool prefetchPreviousFolder;
 
 	// Progress display
 	sf_text_wrapper loadingText;
@@ -2743,7 +1890,6 @@ private:
 	LONG windowedStyle;
 	LONG windowedExStyle;
 
-	sf::RectangleShape memoryWarningBg;
 	sf_text_wrapper memoryWarningText;
 	sf_text_wrapper memoryHoverText;
 	bool showMemoryWarning;
@@ -2751,6 +1897,26 @@ private:
 	sf::Vector2f memoryWarningPosition;
 	float memoryWarningSize;
 
+	// Overlay backgrounds are cached per panel and rebuilt only when marked dirty
+	std::array<OverlayGeometry, static_cast<size_t>(OverlayPanel::COUNT)> overlayGeometry;
+	std::array<bool, static_cast<size_t>(OverlayPanel::COUNT)> overlayDirty;
+	sf_text_wrapper lockText;
+	std::string lockTextOperation;
+
+	// Render loop: only redraw when something changed
+	std::atomic<bool> needsRedraw;
+	bool wasBusyLastWake;
+	RenderLoopStats renderStats;
+	sf::Clock memoryCheckClock;
+
+	static constexpr DWORD IDLE_WAKE_MS = 1000;		// memory warning / stats polling while idle
+	static constexpr DWORD BUSY_WAKE_MS = 100;		// loading progress refresh
+	static constexpr int MEMORY_CHECK_MS = 1000;
+	static constexpr int EVICT_KEEP_RADIUS = 8;		// decoded pages kept around the reader under memory pressure
+	static constexpr int REDECODE_RADIUS = 2;		// evicted or failed pages decoded again ahead of the reader
+
+	static constexpr float WEBTOON_WHEEL_STEP = 150.0f;	// strip pixels per wheel notch
+
 public: //constructor and destructor
 
 	struct AppMemoryInfo {
@@ -2807,12 +1973,6 @@ public: //constructor and destructor
 		showMemoryWarning = false;
 		memoryWarningHovered = false;
 
-		// Setup warning background (triangle shape using rectangle)
-		memoryWarningBg.setSize(sf::Vector2f(memoryWarningSize, memoryWarningSize));
-		memoryWarningBg.setFillColor(sf::Color(255, 165, 0, 200)); // Orange
-		memoryWarningBg.setOutlineThickness(1);
-		memoryWarningBg.setOutlineColor(sf::Color(255, 255, 255));
-
 		// Setup warning text (!)
 		memoryWarningText.initialize(*font.get(), 16);
 		memoryWarningText.get()->setString("!");
@@ -2835,7 +1995,8 @@ public: //constructor and destructor
 		memoryWarningPosition.x = infoButtonX + (buttonSize - memoryWarningSize) / 2.0f;
 		memoryWarningPosition.y = buttonY + buttonSize + 10.0f; // 10px gap below buttons
 
-		memoryWarningBg.setPosition(memoryWarningPosition);
+		markOverlayDirty(OverlayPanel::MEMORY_WARNING);
+		markOverlayDirty(OverlayPanel::MEMORY_HOVER);
 
 		// Center the "!" in the warning box
 		sf::FloatRect textBounds = memoryWarningText.get()->getLocalBounds();
@@ -2845,8 +2006,10 @@ public: //constructor and destructor
 		));
 	}
 
-	void updateMemoryWarning() {
+	// Returns true if the warning needs to be redrawn
+	bool updateMemoryWarning() {
 		AppMemoryInfo memInfo = getCurrentAppMemoryInfo();
+		bool wasShowing = showMemoryWarning;
 		showMemoryWarning = memInfo.isHighUsage;
 
 		if (showMemoryWarning)
@@ -2867,13 +2030,16 @@ public: //constructor and destructor
 				"- Clear image cache (Tab to switch folders)";
 
 			memoryHoverText.get()->setString(UnicodeUtils::stringToSFString(hoverMessage));
+			markOverlayDirty(OverlayPanel::MEMORY_HOVER);
 		}
+
+		return showMemoryWarning != wasShowing || (showMemoryWarning && memoryWarningHovered);
 	}
 
 	bool isMouseOverMemoryWarning(sf::Vector2f mousePos) {
 		if (!showMemoryWarning) return false;
 
-		sf::FloatRect warningBounds = memoryWarningBg.getGlobalBounds();
+		sf::FloatRect warningBounds(memoryWarningPosition, sf::Vector2f(memoryWarningSize, memoryWarningSize));
 		// Add a small buffer for easier hovering
 		warningBounds.position.x -= 5.0f;
 		warningBounds.position.y -= 5.0f;
@@ -2917,6 +2083,11 @@ public: //constructor and destructor
 			return false;
 		}
 
+		// The folder loader, strip decodes and the page prefetcher may still be reading the source
+		cancelFolderLoading();
+		webtoonStrip.clear();
+		pagePrefetcher.reset();
+
 		// Close archive if it's currently open
 		if (isCurrentlyInArchive && archiveHandler.getIsArchiveOpen())
 		{
@@ -3010,14 +2181,26 @@ public: //constructor and destructor
 
 	explicit MangaReader(const CommandLineOptions& options): cmdOptions(options)
 		 , window()
-		 , originalTexture()
+		 , tiledPage()
+		 , companionPage()
 		 , scaledTexture()
+		 , companionScaledTexture()
 		 , currentSprite()
+		 , companionSprite()
+		 , pendingCompanionIndex(-1)
+		 , webtoonStrip()
+		 , webtoonMode(false)
+		 , spreadMode(false)
+		 , rightToLeft(false)
 		 , font()
 		 , statusText()
 		 , helpText()
 		 , detailedInfoText()
 		 , folders()
+		 , libraryIndex()
+		 , libraryScanner()
+		 , libraryWatcher()
+		 , readingProgress()
 		 , currentImages()
 		 , currentFolderIndex(0)
 		 , currentImageIndex(0)
@@ -3033,10 +2216,27 @@ public: //constructor and destructor
 		 , isCurrentlyInArchive()
 		 , currentArchivePath()
 		 , loadedImages()
-		 , loadingMutex()
+		 , decodedPages()
 		 , isLoadingFolder(false)
+		 , folderDecodeStarted(false)
 		 , loadingProgress(0)
 		 , folderLoadingFuture()
+		 , pageDecodeJobs()
+		 , folderGeneration()
+		 , lastCancelMs(0.0)
+		 , firstPixelMs(-1.0)
+		 , firstPageDecodeMs(0.0)
+#ifdef MANGAREADER_COUNT_CONVERSIONS
+		 , lastTurnConversions(0)
+#endif
+		 , folderPrefetcher()
+		 , pagePrefetcher()
+		 , currentPageWasReady(false)
+		 , pageUploads()
+		 , pageTurnTexturePending(false)
+		 , folderPrefetchThreshold(0.75f)
+		 , folderPrefetchPages(3)
+		 , prefetchPreviousFolder(false)
 		 , loadingText()
 		 , savedZoomLevel(1.0f)
 		 , savedImageOffset()
@@ -3054,7 +2254,17 @@ public: //constructor and destructor
 		 , windowedRect({ 0, 0, 0, 0 })
 		 , windowedStyle(0)
 		 , windowedExStyle(0)
+		 , overlayGeometry()
+		 , overlayDirty()
+		 , lockText()
+		 , lockTextOperation()
+		 , needsRedraw(true)
+		 , wasBusyLastWake(false)
+		 , renderStats()
+		 , memoryCheckClock()
 	{
+		overlayDirty.fill(true);
+
 		// Step 1: Create config FIRST (before any validation or window creation)
 		if (!cmdOptions.configFile.empty())
 		{
@@ -3066,6 +2276,7 @@ public: //constructor and destructor
 		{
 			config = std::make_unique<ConfigManager>();
 		}
+		readingProgress.open(getReadingProgressPath());
 
 		// Step 2: Validate command line paths (now we can show errors properly)
 		if (!validateCommandLinePaths())
@@ -3084,6 +2295,9 @@ public: //constructor and destructor
 		loadingText.initialize(*font.get(), 18u);
 		loadingText.get()->setFillColor(sf::Color::White);
 
+		lockText.initialize(*font.get(), 18u);
+		lockText.get()->setFillColor(sf::Color::White);
+
 		// Step 5: Initialize with command line manga folder if provided and valid
 		if (!cmdOptions.mangaFolder.empty())
 		{
@@ -3169,6 +2383,12 @@ public: //constructor and destructor
 	~MangaReader() {
 		saveCurrentSession();
 
+		// Strip decodes, the page prefetcher and the folder loader read members declared before
+		// them (the archive, the page list, the page slots), so they stop before those are destroyed
+		webtoonStrip.clear();
+		pagePrefetcher.reset();
+		cancelFolderLoading();
+
 		//Cleanup COM
 		CoUninitialize();
 	}
@@ -3364,7 +2584,21 @@ public: //constructor and destructor
 
 		// Create window with saved dimensions
 		window.create(sf::VideoMode(sf::Vector2u(savedWidth, savedHeight)), "Simple Manga Reader");
-		window.setFramerateLimit(60);
+		applyFrameRateSettings();
+
+		// Pages over the GPU limit get striped, downscaled no further than the desktop width
+		ImageLoader::setStripeLimits(sf::Texture::getMaximumSize(), sf::VideoMode::getDesktopMode().size.x);
+
+		webtoonMode = config->getBool(CONFIG_WEBTOON_MODE, false);
+		spreadMode = !webtoonMode && config->getBool(CONFIG_SPREAD_MODE, false);
+		rightToLeft = config->getBool(CONFIG_RIGHT_TO_LEFT, false);
+		folderPrefetchThreshold = std::clamp(config->getFloat(CONFIG_FOLDER_PREFETCH_THRESHOLD, 0.75f), 0.0f, 1.0f);
+		folderPrefetchPages = std::max(0, config->getInt(CONFIG_FOLDER_PREFETCH_PAGES, 3));
+		prefetchPreviousFolder = config->getBool(CONFIG_PREFETCH_PREVIOUS_FOLDER, false);
+		pagePrefetcher.setArchive(&archiveHandler);
+		pageUploads.setCallback([this]() { wakeRenderLoop(); });
+		pagePrefetcher.setBudget(static_cast<size_t>(std::max(16, config->getInt(CONFIG_PREFETCH_BUDGET_MB, 256))) * 1024u * 1024u);
+		webtoonStrip.setPageLoader([this](int index) { return loadPageAtIndex(index); }, [this]() { wakeRenderLoop(); });
 
 		// Get the native window handle
 		HWND hwnd = window.getNativeHandle();
@@ -3571,6 +2805,11 @@ public: //constructor and destructor
 			// Save current state
 			config->setWString(CONFIG_LAST_FOLDER, rootMangaPath);
 			config->setInt(CONFIG_LAST_FOLDER_INDEX, currentFolderIndex);
+			if (currentFolderIndex >= 0 && currentFolderIndex < folders.size())
+			{
+				config->setWString(CONFIG_LAST_SOURCE, folders[currentFolderIndex].dir);
+				config->setBool(CONFIG_LAST_SOURCE_IS_ARCHIVE, folders[currentFolderIndex].isArchieve);
+			}
 			config->setInt(CONFIG_LAST_IMAGE_INDEX, currentImageIndex);
 
 			// Mark that we have session data
@@ -3615,11 +2854,14 @@ public: //constructor and destructor
 			}
 
 			config->setBool(CONFIG_USE_SMOOTHING, useSmoothing);
+			config->setBool(CONFIG_WEBTOON_MODE, webtoonMode);
+			config->setBool(CONFIG_SPREAD_MODE, spreadMode);
+			config->setBool(CONFIG_RIGHT_TO_LEFT, rightToLeft);
 			config->setBool("UI.infoButtonVisible", buttonManager.isButtonToggled(ButtonID::INFO_BUTTON));
 			config->setBool("UI.helpButtonVisible", buttonManager.isButtonToggled(ButtonID::HELP_BUTTON));
 
-			// Force save to disk
-			config->forceSave();
+			// Written in the background once the changes settle
+			config->requestSave();
 
 		} catch (const std::exception& e)
 		{
@@ -3830,7 +3072,7 @@ public: //constructor and destructor
 			break;
 
 		case ButtonID::PREVIOUS_FOLDER:
-			if (navLock.isNavigationAllowed())
+			if (canSwitchFolder())
 			{
 				previousFolder();
 				saveCurrentSession(); // Save after navigation
@@ -3838,7 +3080,7 @@ public: //constructor and destructor
 			break;
 
 		case ButtonID::NEXT_FOLDER:
-			if (navLock.isNavigationAllowed())
+			if (canSwitchFolder())
 			{
 				nextFolder();
 				saveCurrentSession(); // Save after navigation
@@ -4057,7 +3299,24 @@ public: //constructor and destructor
 			}
 
 			rootMangaPath = lastFolder;
-			loadFolders(rootMangaPath);
+
+			// With the saved source known the library scan finishes in the background; older
+			// configs only have the folder index, which refers to the complete, sorted library
+			FoldersIdent savedSource(config->getWString(CONFIG_LAST_SOURCE), config->getBool(CONFIG_LAST_SOURCE_IS_ARCHIVE, false));
+			std::error_code ec;
+			bool knowsSource = !savedSource.dir.empty() && std::filesystem::exists(savedSource.dir, ec);
+			loadFolders(rootMangaPath, knowsSource ? ScanWait::NONE : ScanWait::COMPLETE);
+
+			if (knowsSource)
+			{
+				// The scan may not have reached it yet
+				auto it = std::lower_bound(folders.begin(), folders.end(), savedSource);
+				if (it == folders.end() || it->dir != savedSource.dir)
+				{
+					it = folders.insert(it, savedSource);
+				}
+				lastFolderIndex = static_cast<int>(it - folders.begin());
+			}
 
 			updateNavigationButtons();
 
@@ -4066,7 +3325,8 @@ public: //constructor and destructor
 				// Clamp indices to valid ranges
 				currentFolderIndex = std::max(0, std::min(lastFolderIndex, (int)folders.size() - 1));
 
-				loadImagesFromFolder(folders[currentFolderIndex]);
+				// The saved page is decoded before the rest of the folder starts loading
+				loadImagesFromFolder(folders[currentFolderIndex], lastImageIndex);
 
 				if (!currentImages.empty())
 				{
@@ -4077,6 +3337,10 @@ public: //constructor and destructor
 						restoreUIStates();
 						updateWindowTitle();
 
+						// Paint now rather than on the first pass of the render loop
+						render();
+						noteFirstPixel();
+
 						// Only show success message if enabled (default: false)
 						bool showSuccess = config->getBool(CONFIG_SHOW_SESSION_SUCCESS, false);
 						if (showSuccess)
@@ -4128,116 +3392,59 @@ public: //constructor and destructor
 	}
 public: //helpers
 
-	sf::Image scaleImage(const sf::Image& originalImage, sf::Vector2u newSize) {
-		sf::Vector2u originalSize = originalImage.getSize();
-
-		if (originalSize == newSize)
+	// Get image dimensions as string
+	std::string getImageDimensionsString() {
+		if (webtoonMode)
 		{
-			return originalImage;
+			sf::Vector2u stripSize = webtoonStrip.getPageSize(currentImageIndex);
+			std::string pageSize = stripSize.x > 0 ? std::to_string(stripSize.x) + " x " + std::to_string(stripSize.y) + " pixels" : "Loading";
+			return pageSize + " (strip, " + std::to_string(webtoonStrip.getResidentPageCount()) + " pages resident)";
 		}
 
-		sf::Image scaledImage(newSize);
-
-		float scaleX = static_cast<float>(originalSize.x) / static_cast<float>(newSize.x);
-		float scaleY = static_cast<float>(originalSize.y) / static_cast<float>(newSize.y);
-
-		if (useSmoothing)
+		sf::Vector2u size = getCurrentPageSize();
+		if (size.x == 0 || size.y == 0)
 		{
-			// Bilinear interpolation for better quality
-			for (unsigned int y = 0; y < newSize.y; ++y)
-			{
-				for (unsigned int x = 0; x < newSize.x; ++x)
-				{
-					float srcX = x * scaleX;
-					float srcY = y * scaleY;
-
-					// Get surrounding pixels
-					int x1 = static_cast<int>(srcX);
-					int y1 = static_cast<int>(srcY);
-					int x2 = std::min(x1 + 1, static_cast<int>(originalSize.x - 1));
-					int y2 = std::min(y1 + 1, static_cast<int>(originalSize.y - 1));
-
-					// Calculate interpolation weights
-					float fx = srcX - x1;
-					float fy = srcY - y1;
-
-					// Get pixel colors
-					sf::Color c11 = originalImage.getPixel(sf::Vector2u(x1, y1));
-					sf::Color c21 = originalImage.getPixel(sf::Vector2u(x2, y1));
-					sf::Color c12 = originalImage.getPixel(sf::Vector2u(x1, y2));
-					sf::Color c22 = originalImage.getPixel(sf::Vector2u(x2, y2));
-
-					// Bilinear interpolation
-					std::uint8_t r = static_cast<std::uint8_t>(
-						c11.r * (1 - fx) * (1 - fy) + c21.r * fx * (1 - fy) +
-						c12.r * (1 - fx) * fy + c22.r * fx * fy);
-					std::uint8_t g = static_cast<std::uint8_t>(
-						c11.g * (1 - fx) * (1 - fy) + c21.g * fx * (1 - fy) +
-						c12.g * (1 - fx) * fy + c22.g * fx * fy);
-					std::uint8_t b = static_cast<std::uint8_t>(
-						c11.b * (1 - fx) * (1 - fy) + c21.b * fx * (1 - fy) +
-						c12.b * (1 - fx) * fy + c22.b * fx * fy);
-					std::uint8_t a = static_cast<std::uint8_t>(
-						c11.a * (1 - fx) * (1 - fy) + c21.a * fx * (1 - fy) +
-						c12.a * (1 - fx) * fy + c22.a * fx * fy);
-
-					scaledImage.setPixel(sf::Vector2u(x, y), sf::Color(r, g, b, a));
-				}
-			}
+			return "Unknown";
 		}
-		else
-		{
-			// Nearest neighbor (faster but lower quality)
-			for (unsigned int y = 0; y < newSize.y; ++y)
-			{
-				for (unsigned int x = 0; x < newSize.x; ++x)
-				{
-					int srcX = static_cast<int>(x * scaleX);
-					int srcY = static_cast<int>(y * scaleY);
 
-					srcX = std::min(srcX, static_cast<int>(originalSize.x - 1));
-					srcY = std::min(srcY, static_cast<int>(originalSize.y - 1));
-
-					scaledImage.setPixel(sf::Vector2u(x, y), originalImage.getPixel(sf::Vector2u(srcX, srcY)));
-				}
-			}
+		std::string dimensions = std::to_string(size.x) + " x " + std::to_string(size.y) + " pixels";
+		if (isSpreadActive())
+		{
+			dimensions += " (spread)";
 		}
-
-		return scaledImage;
-	}
-
-	// Get image dimensions as string
-	std::string getImageDimensionsString() {
-		if (originalTexture.getSize().x == 0 || originalTexture.getSize().y == 0)
+		else if (tiledPage.isEnabled())
 		{
-			return "Unknown";
+			dimensions += " (" + std::to_string(tiledPage.getResidentCount()) + "/" +
+				std::to_string(tiledPage.getTileCount()) + " tiles resident)";
 		}
-
-		sf::Vector2u size = originalTexture.getSize();
-		return std::to_string(size.x) + " x " + std::to_string(size.y) + " pixels";
+		return dimensions;
 	}
 
+	// Size of a page for the zoom reset check before a turn, from what is already at hand: the
+	// decoded page, an extracted archive entry or a folder file's header. An archive page that is
+	// neither gives 0x0 rather than reading the archive on the UI thread; setupPage checks it then.
 	sf::Vector2u getImageDimensions(int imageIndex) {
 		if (imageIndex < 0 || imageIndex >= currentImages.size())
 		{
 			return sf::Vector2u(0, 0);
 		}
 
-		ImageLoadingDispatcher::LoadContext context(isCurrentlyInArchive, &archiveHandler, &currentImages, imageIndex);
-		return ImageLoadingDispatcher::getImageDimensionsAtIndex(context);
-	}
+		if (auto page = getLoadedPage(imageIndex))
+		{
+			return page->sourceSize;
+		}
 
-	bool isArchiveFile(const std::string& ext) {
-		std::string cpy = ext;
-		std::transform(cpy.begin(), cpy.end(), cpy.begin(), ::tolower);
-		for (auto& supp : supportedArchives)
+		if (isCurrentlyInArchive)
 		{
-			if (cpy == supp)
+			std::vector<uint8_t> header;
+			if (archiveHandler.readCachedPrefix(imageIndex, ImageLoader::HEADER_PROBE_MAX_BYTES, header))
 			{
-				return true;
+				return ImageLoader::readDimensions(header.data(), header.size());
 			}
+			return sf::Vector2u(0, 0);
 		}
-		return false;
+
+		return ImageLoader::readFileDimensions(currentImages.getFullPath(imageIndex));
 	}
 
 public: //loads
@@ -4276,73 +3483,247 @@ public: //loads
 		return false; // No working folders found
 	}
 
-	void loadFolders(const std::wstring& path) {
-		folders.clear();
+	enum class ScanWait {
+		FIRST_RESULT,   // Return once a source was found; the rest streams in
+		COMPLETE,       // Return with the complete, sorted library
+		NONE            // Return right away
+	};
 
-		try
+	// Starts a library scan of path. The sources indexed last time are shown straight away and
+	// the scan only lists directories that changed. Without an index this waits as asked; the
+	// rest streams in through mergeScannedFolders.
+	void loadFolders(const std::wstring& path, ScanWait wait = ScanWait::FIRST_RESULT) {
+		libraryScanner.cancel(); // The running scan may still be reading the index
+		libraryIndex.open(getLibraryIndexPath());
+		folders = libraryIndex.getSources(path);
+		bool fromIndex = !folders.empty();
+
+		int depth = config ? config->getInt(CONFIG_LIBRARY_SCAN_DEPTH, 1) : 1;
+		int threads = config ? config->getInt(CONFIG_LIBRARY_SCAN_THREADS, 8) : 8;
+		libraryScanner.start(path, depth, std::clamp(threads, 1, 64), &libraryIndex);
+
+		if (!config || config->getBool(CONFIG_WATCH_LIBRARY, true))
 		{
-			for (const auto& entry : std::filesystem::directory_iterator(path))
-			{
-				if (entry.is_directory())
-				{
-					// Check if directory contains images
-					bool hasImages = false;
-					for (const auto& subEntry : std::filesystem::directory_iterator(entry.path()))
-					{
-						if (subEntry.is_regular_file() && IsImgExtValid(subEntry.path().extension().string()))
-						{
-							hasImages = true;
-							break;
-						}
-					}
+			libraryWatcher.start(path);
+		}
+		else
+		{
+			libraryWatcher.stop();
+		}
 
-					if (hasImages)
-					{
-						folders.emplace_back(entry.path().wstring(), false);
-					}
-				}
-				else if (entry.is_regular_file())
-				{
-					// Check if it's an archive file
-					if (isArchiveFile(entry.path().extension().string()))
-					{
-						folders.emplace_back(entry.path().wstring(), true);
-					}
-				}
-			}
+		if (fromIndex || wait == ScanWait::NONE)
+		{
+			updateNavigationButtons();
+			return;
+		}
+
+		if (wait == ScanWait::COMPLETE)
+		{
+			libraryScanner.waitUntilDone();
+		}
+		else
+		{
+			libraryScanner.waitForResults();
+		}
+		mergeScannedFolders();
+		finishLibraryScan();
+
+		std::string rootError = libraryScanner.getRootError();
+		if (!rootError.empty())
+		{
+			std::wstring errorMsg = L"Error loading folders: " + UnicodeUtils::stringToWstring(rootError);
+			LockedMessageBox::showWarning(errorMsg, L"Folder Loading Error");
+		}
+	}
+
+	std::wstring getLibraryIndexPath() const {
+		std::filesystem::path configPath(config ? config->getConfigFilePath() : L"");
+		return (configPath.parent_path() / L"manga_reader_library.idx").wstring();
+	}
+
+	std::wstring getReadingProgressPath() const {
+		std::filesystem::path configPath(config ? config->getConfigFilePath() : L"");
+		return (configPath.parent_path() / L"manga_reader_progress.log").wstring();
+	}
+
+	void recordReadingProgress() {
+		if (currentFolderIndex < 0 || currentFolderIndex >= folders.size() || currentImages.empty()) return;
+		readingProgress.update(folders[currentFolderIndex].dir, currentImageIndex, static_cast<int>(currentImages.size()), getVisiblePageCount());
+	}
+
+	// Once a scan has run to the end: drop sources that disappeared since the index was written
+	// and store the new listing. The open source stays even if it vanished, and nothing is
+	// pruned when the root could not be read (an offline drive keeps its library).
+	bool finishLibraryScan() {
+		LibraryIndex::DirectoryMap scanned;
+		if (!libraryScanner.takeScannedDirectories(scanned)) return false;
+		if (!libraryScanner.getRootError().empty()) return false;
+
+		mergeScannedFolders();
+		libraryIndex.replaceDirectories(rootMangaPath, std::move(scanned));
+
+		std::set<std::wstring> live;
+		for (const auto& source : libraryIndex.getSources(rootMangaPath))
+		{
+			live.insert(source.dir);
+		}
+
+		bool hasCurrent = currentFolderIndex >= 0 && currentFolderIndex < folders.size();
+		std::wstring currentDir = hasCurrent ? folders[currentFolderIndex].dir : L"";
+		folders.erase(std::remove_if(folders.begin(), folders.end(), [&](const FoldersIdent& folder) {
+			return folder.dir != currentDir && live.count(folder.dir) == 0;
+			}), folders.end());
+
+		if (hasCurrent)
+		{
+			auto it = std::lower_bound(folders.begin(), folders.end(), FoldersIdent{ currentDir, false });
+			currentFolderIndex = static_cast<int>(it - folders.begin());
+		}
+
+		libraryIndex.requestSave();
+		updateNavigationButtons();
+		return true;
+	}
 
-			// Also add current directory if it has images
-			bool hasImages = false;
-			for (const auto& entry : std::filesystem::directory_iterator(path))
+	// Applies what the watcher saw: removed paths take their sources along right away, changed
+	// directories are listed again on the scanner's workers and applied by finishLibraryRefresh.
+	// currentFolderIndex keeps pointing at the open source, which stays even if it was removed.
+	void applyLibraryChanges(const LibraryWatcher::Changes& changes) {
+		int maxDepth = config ? config->getInt(CONFIG_LIBRARY_SCAN_DEPTH, 1) : 1;
+		int threads = config ? config->getInt(CONFIG_LIBRARY_SCAN_THREADS, 8) : 8;
+		if (changes.overflowed)
+		{
+			libraryScanner.start(rootMangaPath, maxDepth, std::clamp(threads, 1, 64), &libraryIndex);
+			return;
+		}
+
+		bool hasCurrent = currentFolderIndex >= 0 && currentFolderIndex < folders.size();
+		std::wstring currentDir = hasCurrent ? folders[currentFolderIndex].dir : L"";
+		auto isBelow = [](const std::wstring& path, const std::wstring& dir) {
+			return path.size() > dir.size() && path.compare(0, dir.size(), dir) == 0 &&
+				std::filesystem::path::preferred_separator == path[dir.size()];
+			};
+
+		for (const auto& path : changes.removed)
+		{
+			std::erase_if(folders, [&](const FoldersIdent& folder) {
+				return folder.dir != currentDir && (folder.dir == path || isBelow(folder.dir, path));
+				});
+			libraryIndex.removeDirectoryTree(rootMangaPath, path);
+		}
+
+		std::vector<LibraryScanner::WorkItem> toList;
+		for (const auto& dir : changes.directories)
+		{
+			int depth = getLibraryDepth(dir);
+			if (depth >= 0 && depth <= maxDepth)
 			{
-				if (entry.is_regular_file() && IsImgExtValid(entry.path().extension().string()))
-				{
-					hasImages = true;
-					break;
-				}
+				toList.push_back(LibraryScanner::WorkItem{ dir, depth });
 			}
+		}
+		libraryScanner.refresh(std::move(toList), maxDepth, std::clamp(threads, 1, 64), &libraryIndex);
+
+		if (hasCurrent)
+		{
+			auto it = std::lower_bound(folders.begin(), folders.end(), FoldersIdent{ currentDir, false });
+			currentFolderIndex = static_cast<int>(it - folders.begin());
+		}
+		updateNavigationButtons();
+	}
+
+	// Replaces the sources directly inside each directory a refresh listed with what is there now
+	bool finishLibraryRefresh() {
+		LibraryIndex::DirectoryMap listed;
+		if (!libraryScanner.takeRefreshedDirectories(listed)) return false;
 
-			if (hasImages)
+		bool hasCurrent = currentFolderIndex >= 0 && currentFolderIndex < folders.size();
+		std::wstring currentDir = hasCurrent ? folders[currentFolderIndex].dir : L"";
+
+		std::erase_if(folders, [&](const FoldersIdent& folder) {
+			if (folder.dir == currentDir) return false;
+			return listed.count(folder.isArchieve ? std::filesystem::path(folder.dir).parent_path().wstring() : folder.dir) > 0;
+			});
+		for (auto& [dir, record] : listed)
+		{
+			for (const auto& archive : record.archives)
+			{
+				folders.push_back(FoldersIdent{ archive, true });
+			}
+			if (record.hasImages)
 			{
-				folders.insert(folders.begin(), std::move(FoldersIdent(path, false)));
+				folders.push_back(FoldersIdent{ dir, false });
 			}
+			libraryIndex.setDirectory(rootMangaPath, dir, std::move(record));
+		}
 
-			std::sort(folders.begin(), folders.end());
+		std::sort(folders.begin(), folders.end());
+		folders.erase(std::unique(folders.begin(), folders.end(), [](const FoldersIdent& a, const FoldersIdent& b) {
+			return a.dir == b.dir;
+			}), folders.end());
 
-		} catch (const std::exception& e)
+		if (hasCurrent)
 		{
-			std::wstring errorMsg = L"Error loading folders: " + UnicodeUtils::stringToWstring(e.what());
-			LockedMessageBox::showWarning(errorMsg, L"Folder Loading Error");
+			auto it = std::lower_bound(folders.begin(), folders.end(), FoldersIdent{ currentDir, false });
+			currentFolderIndex = static_cast<int>(it - folders.begin());
 		}
+		libraryIndex.requestSave();
+		updateNavigationButtons();
+		return true;
 	}
 
-	void loadImagesFromFolder(const FoldersIdent& folderIdent) {
-		// Wait for any ongoing loading to complete
-		if (folderLoadingFuture.valid())
+	// Depth of dir below the library root (the root is 0), or -1 when it is outside
+	int getLibraryDepth(const std::wstring& dir) const {
+		std::filesystem::path relative = std::filesystem::path(dir).lexically_relative(rootMangaPath);
+		if (relative.empty()) return -1;
+		if (relative == ".") return 0;
+
+		int depth = 0;
+		for (const auto& part : relative)
 		{
-			folderLoadingFuture.wait();
+			if (part == "..") return -1;
+			depth++;
+		}
+		return depth;
+	}
+
+	// Adds sources found by the scanner, keeping folders sorted and currentFolderIndex on the
+	// folder that is open
+	bool mergeScannedFolders() {
+		std::vector<FoldersIdent> found;
+		if (libraryScanner.takeResults(found) == 0) return false;
+
+		bool hasCurrent = currentFolderIndex >= 0 && currentFolderIndex < folders.size();
+		std::wstring currentDir = hasCurrent ? folders[currentFolderIndex].dir : L"";
+
+		std::sort(found.begin(), found.end());
+		std::vector<FoldersIdent> merged;
+		merged.reserve(folders.size() + found.size());
+		std::merge(folders.begin(), folders.end(), found.begin(), found.end(), std::back_inserter(merged));
+		merged.erase(std::unique(merged.begin(), merged.end(), [](const FoldersIdent& a, const FoldersIdent& b) {
+			return a.dir == b.dir;
+			}), merged.end());
+		folders = std::move(merged);
+
+		if (hasCurrent)
+		{
+			auto it = std::lower_bound(folders.begin(), folders.end(), FoldersIdent{ currentDir, false });
+			currentFolderIndex = static_cast<int>(it - folders.begin());
 		}
 
+		updateNavigationButtons();
+		return true;
+	}
+
+	// firstPage, when given, is decoded before the background load starts instead of queueing
+	// behind it; a prefetched source usually has it already
+	void loadImagesFromFolder(const FoldersIdent& folderIdent, int firstPage = -1) {
+		// Abort any ongoing loading of the previous folder
+		cancelFolderLoading();
+		webtoonStrip.clear();
+		companionPage.clear();
+		pagePrefetcher.reset();
+		pageUploads.clear();
+
 		currentImages.clear();
 		currentImageIndex = 0;
 
@@ -4360,6 +3741,29 @@ public: //loads
 		resetZoomAndPosition();
 		sizeMismatchHandler.reset();
 
+		// Adopt the source if the prefetcher already opened it
+		FolderPrefetcher::Result prefetched;
+		if (folderPrefetcher.take(folderIdent.dir, archiveHandler, prefetched))
+		{
+			currentImages = std::move(prefetched.images);
+			isCurrentlyInArchive = prefetched.isArchive;
+			currentArchivePath = prefetched.isArchive ? folderIdent.dir : L"";
+			libraryIndex.recordSource(folderIdent, static_cast<int>(currentImages.size()));
+
+			// The prefetch started at the resume page it knew; the source may open elsewhere
+			int first = std::min(firstPage, static_cast<int>(currentImages.size()) - 1);
+			if (first >= 0 && std::none_of(prefetched.pages.begin(), prefetched.pages.end(), [first](const auto& page) { return page.first == first; }))
+			{
+				for (auto& page : decodePageFirst(first))
+				{
+					prefetched.pages.push_back(std::move(page));
+				}
+			}
+			loadAllImagesInFolder(std::move(prefetched.pages));
+			updateWindowTitle();
+			return;
+		}
+
 		try
 		{
 			if (folderIdent.isArchieve)
@@ -4377,12 +3781,7 @@ public: //loads
 						return;
 					}
 
-					for (const auto& entry : entries)
-					{
-						// Store archive entries as pseudo-paths for consistency
-						std::wstring entryPath = folderIdent.dir + L"#" + UnicodeUtils::stringToWstring(entry.name);
-						currentImages.push_back(entryPath);
-					}
+					currentImages = FileSystemHelper::listArchivePages(folderIdent.dir, entries);
 					isCurrentlyInArchive = true;
 					currentArchivePath = folderIdent.dir;
 				}
@@ -4399,17 +3798,7 @@ public: //loads
 				// Load from regular folder
 				try
 				{
-					for (const auto& entry : std::filesystem::directory_iterator(folderIdent.dir))
-					{
-						if (entry.is_regular_file() && IsImgExtValid(entry.path().extension().string()))
-						{
-							currentImages.push_back(entry.path().wstring());
-						}
-					}
-
-					// Sort images naturally
-					std::sort(currentImages.begin(), currentImages.end());
-
+					currentImages = FileSystemHelper::listImageFiles(folderIdent.dir);
 				} catch (const std::filesystem::filesystem_error& e)
 				{
 					std::wstring errorMsg = L"Error accessing folder: " + folderIdent.dir + L"\n" + UnicodeUtils::stringToWstring(e.what());
@@ -4421,7 +3810,8 @@ public: //loads
 			// Start loading all images in background
 			if (!currentImages.empty())
 			{
-				loadAllImagesInFolder();
+				libraryIndex.recordSource(folderIdent, static_cast<int>(currentImages.size()));
+				loadAllImagesInFolder(decodePageFirst(std::min(firstPage, static_cast<int>(currentImages.size()) - 1)));
 				updateWindowTitle();
 			}
 			else
@@ -4439,34 +3829,123 @@ public: //loads
 		}
 	}
 
-	void loadSingleImageAsync(int index) {
-		if (index < 0 || index >= currentImages.size()) return;
+	// Decodes one page on the UI thread, handed to loadAllImagesInFolder as already loaded
+	std::vector<std::pair<int, ImageLoader::LoadResult>> decodePageFirst(int index) {
+		std::vector<std::pair<int, ImageLoader::LoadResult>> pages;
+		if (index < 0 || index >= currentImages.size()) return pages;
 
+		auto start = std::chrono::steady_clock::now();
 		ImageLoadingDispatcher::LoadContext context(isCurrentlyInArchive, &archiveHandler, &currentImages, index);
 		ImageLoader::LoadResult result = ImageLoadingDispatcher::loadImageAtIndex(context);
+		firstPageDecodeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
 
 		if (result.success)
 		{
-			std::lock_guard<std::mutex> lock(loadingMutex);
-			loadedImages[index].image = std::move(result.image);
-			loadedImages[index].filename = FileSystemHelper::extractFilenameFromPath(currentImages[index], isCurrentlyInArchive);
-			loadedImages[index].isLoaded = true;
+			pages.emplace_back(index, std::move(result));
+		}
+		return pages;
+	}
+
+	// Records when the first page reached the screen
+	void noteFirstPixel() {
+		if (firstPixelMs >= 0.0 || !(tiledPage.isLoaded() || (webtoonMode && !currentImages.empty()))) return;
+		firstPixelMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - processStartTime).count();
+	}
+
+	void loadSingleImageAsync(int index, const CancellationToken& token) {
+		if (index < 0 || index >= currentImages.size() || token.isCancelled()) return;
+
+		// Pages handed over by the folder prefetcher are already decoded
+		PageSlotState expected = PageSlotState::EMPTY;
+		if (!loadedImages[index].state.compare_exchange_strong(expected, PageSlotState::DECODING) &&
+			(expected != PageSlotState::EVICTED ||
+				!loadedImages[index].state.compare_exchange_strong(expected, PageSlotState::DECODING))) return;
+
+		ImageLoadingDispatcher::LoadContext context(isCurrentlyInArchive, &archiveHandler, &currentImages, index, token);
+		ImageLoader::LoadResult result = ImageLoadingDispatcher::loadImageAtIndex(context);
 
-			// Get file size
-			if (!isCurrentlyInArchive)
+		decodedPages.push(DecodedPage{ token, index, result.success ? makeLoadedImage(index, std::move(result)) : nullptr });
+	}
+
+	std::shared_ptr<const LoadedImageData> makeLoadedImage(int index, ImageLoader::LoadResult result) const {
+		auto page = std::make_shared<LoadedImageData>();
+		page->image = std::move(result.image);
+		page->stripes = std::move(result.stripes);
+		page->sourceSize = result.sourceSize;
+		page->filename = std::string(currentImages.getFileName(index));
+
+		// Get file size
+		if (!isCurrentlyInArchive)
+		{
+			try
 			{
-				try
-				{
-					loadedImages[index].fileSize = std::filesystem::file_size(currentImages[index]);
-				} catch (...)
-				{
-					loadedImages[index].fileSize = 0;
-				}
+				page->fileSize = std::filesystem::file_size(currentImages.getFullPath(index));
+			} catch (...)
+			{
+				page->fileSize = 0;
+			}
+		}
+		return page;
+	}
+
+	// UI thread only. A failed decode doesn't replace a page the UI thread already published.
+	void publishPage(int index, std::shared_ptr<const LoadedImageData> page) {
+		PageSlot& slot = loadedImages[index];
+		if (!page && slot.state.load() == PageSlotState::READY) return;
+
+		const bool ready = page != nullptr;
+		slot.data.store(std::move(page));
+		slot.state.store(ready ? PageSlotState::READY : PageSlotState::EMPTY, std::memory_order_release);
+	}
+
+	// Moves pages finished by the folder workers into their slots, once per frame and before
+	// a page turn; results for a folder that was switched away from are dropped
+	size_t publishDecodedPages() {
+		return decodedPages.drain([this](DecodedPage&& page) {
+			if (!page.token.isCancelled() && page.index >= 0 && page.index < loadedImages.size())
+			{
+				publishPage(page.index, std::move(page.data));
+			}
+			});
+	}
+
+	// Safe from any thread, see PageSlot
+	std::shared_ptr<const LoadedImageData> getLoadedPage(int index) const {
+		if (index < 0 || index >= loadedImages.size()) return nullptr;
+
+		const PageSlot& slot = loadedImages[index];
+		return slot.state.load(std::memory_order_acquire) == PageSlotState::READY ? slot.data.load() : nullptr;
+	}
+
+	// Under memory pressure, drop decoded pages far from the reader; requeueNearbyPages decodes
+	// them again as the reader comes back. Not while the folder loads, its workers keep filling slots.
+	void evictDistantPages() {
+		if (isLoadingFolder) return;
+
+		for (int i = 0; i < static_cast<int>(loadedImages.size()); ++i)
+		{
+			PageSlot& slot = loadedImages[i];
+			if (std::abs(i - currentImageIndex) > EVICT_KEEP_RADIUS && slot.state.load() == PageSlotState::READY)
+			{
+				slot.state.store(PageSlotState::EVICTED, std::memory_order_release);
+				slot.data.store(nullptr);
 			}
 		}
 	}
 
-	void loadImagesAsync() {
+	std::string getDecodedPagesString() const {
+		size_t ready = 0;
+		size_t evicted = 0;
+		for (size_t i = 0; i < loadedImages.size(); ++i)
+		{
+			PageSlotState state = loadedImages[i].state.load(std::memory_order_relaxed);
+			if (state == PageSlotState::READY) ++ready;
+			else if (state == PageSlotState::EVICTED) ++evicted;
+		}
+		return std::to_string(ready) + " ready, " + std::to_string(evicted) + " evicted";
+	}
+
+	void loadImagesAsync(CancellationToken token) {
 		const int totalImages = currentImages.size();
 		std::vector<std::future<void>> workers;
 		const int numThreads = std::min(4, (int)std::thread::hardware_concurrency());
@@ -4477,10 +3956,10 @@ public: //loads
 			int startIdx = t * imagesPerThread;
 			int endIdx = (t == numThreads - 1) ? totalImages : (t + 1) * imagesPerThread;
 
-			workers.emplace_back(std::async(std::launch::async, [this, startIdx, endIdx]() {
-				for (int i = startIdx; i < endIdx; ++i)
+			workers.emplace_back(std::async(std::launch::async, [this, startIdx, endIdx, token]() {
+				for (int i = startIdx; i < endIdx && !token.isCancelled(); ++i)
 				{
-					loadSingleImageAsync(i);
+					loadSingleImageAsync(i, token);
 					loadingProgress = loadingProgress + 1;
 				}
 				}));
@@ -4495,32 +3974,156 @@ public: //loads
 		isLoadingFolder = false;
 	}
 
-	void loadAllImagesInFolder() {
+	void loadAllImagesInFolder(std::vector<std::pair<int, ImageLoader::LoadResult>> prefetchedPages = {}) {
 		if (currentImages.empty()) return;
 
+		// Clear previous data; the old folder's workers have already been cancelled and waited for
+		publishDecodedPages();
+		loadedImages.reset(currentImages.size());
+		folderDecodeStarted = false;
+
+		for (auto& [index, page] : prefetchedPages)
+		{
+			if (index >= 0 && index < currentImages.size())
+			{
+				publishPage(index, makeLoadedImage(index, std::move(page)));
+			}
+		}
+
+		// The strip decodes only the pages around its view, at strip width; a full-resolution
+		// copy of every page would only grow memory. The decode starts when the strip is left.
+		if (!webtoonMode)
+		{
+			startFolderDecode();
+		}
+	}
+
+	// Leaving the strip for single pages or spreads, which want the whole source decoded
+	void ensureFolderDecode() {
+		if (!folderDecodeStarted && !currentImages.empty())
+		{
+			startFolderDecode();
+		}
+	}
+
+	void startFolderDecode() {
+		folderDecodeStarted = true;
 		isLoadingFolder = true;
 		loadingProgress = 0;
 
 		// LOCK navigation during async loading
 		navLock.lock("Loading Images");
 
-		// Clear previous data
-		{
-			std::lock_guard<std::mutex> lock(loadingMutex);
-			loadedImages.clear();
-			loadedImages.resize(currentImages.size());
-		}
-
 		// Start async loading
-		folderLoadingFuture = std::async(std::launch::async, [this]() {
-			loadImagesAsync();
+		CancellationToken token = folderGeneration.token();
+		folderLoadingFuture = std::async(std::launch::async, [this, token]() {
+			loadImagesAsync(token);
 			// UNLOCK navigation when async loading is complete
 			navLock.unlock();
+			wakeRenderLoop();
+			});
+	}
+
+	// Folder switches may interrupt a folder load; everything else waits for it
+	bool canSwitchFolder() const {
+		return navLock.isNavigationAllowed() || (isLoadingFolder && !LockedMessageBox::isActive());
+	}
+
+	// Stops the background work of the current folder: every queued extract, decode and scale
+	// sees its token cancelled, so only the ones already running are waited for
+	void cancelFolderLoading() {
+		folderGeneration.advance();
+		auto start = std::chrono::steady_clock::now();
+		if (folderLoadingFuture.valid())
+		{
+			folderLoadingFuture.wait();
+		}
+		for (auto& job : pageDecodeJobs)
+		{
+			job.wait();
+		}
+		pageDecodeJobs.clear();
+		lastCancelMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	// Decodes one page on a worker and hands it over through decodedPages like the folder load.
+	// Pages that are already decoded or being decoded are left alone.
+	void requestPageDecode(int index) {
+		if (index < 0 || index >= currentImages.size()) return;
+		PageSlotState state = loadedImages[index].state.load();
+		if (state != PageSlotState::EMPTY && state != PageSlotState::EVICTED) return;
+
+		CancellationToken token = folderGeneration.token();
+		pageDecodeJobs.push_back(std::async(std::launch::async, [this, index, token]() {
+			loadSingleImageAsync(index, token);
+			wakeRenderLoop();
+			}));
+	}
+
+	// After the folder load, evicted or failed pages next to the reader are decoded again on a
+	// worker, so the next turn and the upload cache find them ready
+	void requeueNearbyPages() {
+		if (isLoadingFolder || !folderDecodeStarted) return;
+
+		for (int offset = 1; offset <= REDECODE_RADIUS; ++offset)
+		{
+			requestPageDecode(currentImageIndex + offset);
+			requestPageDecode(currentImageIndex - offset);
+		}
+	}
+
+	void reapPageDecodeJobs() {
+		std::erase_if(pageDecodeJobs, [](std::future<void>& job) {
+			return job.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
 			});
 	}
 
+	bool isPageReady(int index) {
+		return getLoadedPage(index) || (isCurrentlyInArchive && archiveHandler.isCached(index));
+	}
+
+	// The current page had to be decoded on the UI thread; keep it so the next visit is free
+	void showLoadedPage(std::shared_ptr<const LoadedImageData> page) {
+		publishPage(currentImageIndex, page);
+		setupPage(page);
+		updateWindowTitle();
+	}
+
+	// A counting build measures the whole turn on this thread: decode if not ready, title,
+	// status and detailed info
 	bool loadCurrentImage() {
+#ifdef MANGAREADER_COUNT_CONVERSIONS
+		const size_t conversionsBefore = UnicodeUtils::conversionCount;
+#endif
+		bool loaded = showCurrentImage();
+#ifdef MANGAREADER_COUNT_CONVERSIONS
+		lastTurnConversions = UnicodeUtils::conversionCount - conversionsBefore;
+#endif
+		return loaded;
+	}
+
+	bool showCurrentImage() {
 		if (currentImages.empty()) return false;
+		recordReadingProgress();
+
+		if (webtoonMode)
+		{
+			showCurrentImageInStrip();
+			return true;
+		}
+
+		publishDecodedPages();
+		currentPageWasReady = isPageReady(currentImageIndex);
+
+		requeueNearbyPages();
+
+		// Use preloaded data if available; prefetched pages are there even while the folder loads
+		if (auto page = getLoadedPage(currentImageIndex))
+		{
+			setupPage(page);
+			updateWindowTitle();
+			return true;
+		}
 
 		// Check if we're still loading
 		if (isLoadingFolder)
@@ -4529,71 +4132,29 @@ public: //loads
 			updateLoadingProgress();
 
 			// Try to load the current image synchronously while others load in background
-			sf::Image imageData;
-			bool loaded = false;
-
 			ImageLoadingDispatcher::LoadContext context(isCurrentlyInArchive, &archiveHandler, &currentImages, currentImageIndex);
 			ImageLoader::LoadResult result = ImageLoadingDispatcher::loadImageAtIndex(context);
 			if (result.success)
 			{
-				imageData = std::move(result.image);
-				loaded = true;
-			}
-			else
-			{
-				loaded = false;
-				// Show error if needed: LockedMessageBox::showError(UnicodeUtils::stringToWstring(result.errorMessage), L"Image Loading Error");
-			}
-
-			if (loaded)
-			{
-				setupTextureFromImage(imageData);
-				updateWindowTitle();
+				showLoadedPage(makeLoadedImage(currentImageIndex, std::move(result)));
 				return true;
 			}
+			// Show error if needed: LockedMessageBox::showError(UnicodeUtils::stringToWstring(result.errorMessage), L"Image Loading Error");
 
 			return false;
 		}
 
-		// Use preloaded data if available
-		{
-			std::lock_guard<std::mutex> lock(loadingMutex);
-			if (currentImageIndex < loadedImages.size() &&
-				loadedImages[currentImageIndex].isLoaded)
-			{
-
-				setupTextureFromImage(loadedImages[currentImageIndex].image);
-				updateWindowTitle();
-				return true;
-			}
-		}
-
-		sf::Image imageData;
-		bool loaded = false;
-
 		ImageLoadingDispatcher::LoadContext context(isCurrentlyInArchive, &archiveHandler, &currentImages, currentImageIndex);
 		ImageLoader::LoadResult result = ImageLoadingDispatcher::loadImageAtIndex(context);
 		if (result.success)
 		{
-			imageData = std::move(result.image);
-			loaded = true;
-		}
-		else
-		{
-			loaded = false;
-			// Show error if needed: LockedMessageBox::showError(UnicodeUtils::stringToWstring(result.errorMessage), L"Image Loading Error");
-		}
-
-		if (loaded)
-		{
-			setupTextureFromImage(imageData);
-			updateWindowTitle();
+			showLoadedPage(makeLoadedImage(currentImageIndex, std::move(result)));
 			return true;
 		}
+		// Show error if needed: LockedMessageBox::showError(UnicodeUtils::stringToWstring(result.errorMessage), L"Image Loading Error");
 
 		// Show error if image fails to load
-		std::wstring imagePath = currentImages[currentImageIndex];
-		std::wstring errorMsg = L"Failed to load image: " + imagePath;
+		std::wstring errorMsg = L"Failed to load image: " + currentImages.getFullPath(currentImageIndex);
 		LockedMessageBox::showError(errorMsg, L"Image Loading Error");
 		return false;
 	}
@@ -4622,6 +4183,7 @@ public://setup
 		}
 
 		helpText.get()->setPosition(sf::Vector2f(10.0f, yPosition));
+		markOverlayDirty(OverlayPanel::HELP);
 	}
 
 	void setupUI() {
@@ -4645,6 +4207,10 @@ public://setup
 			"H: Toggle help\n"
 			"I: Toggle detailed info\n"
 			"R: Select new manga folder\n"
+			"V: Toggle webtoon (continuous scroll) mode\n"
+			"P: Toggle two-page spread mode\n"
+			"L: Toggle right-to-left page order\n"
+			"Space/Page Down, Page Up: Scroll a screen (webtoon)\n"
 			"F10: Toggle maximize (windowed mode)\n"    // NEW
 			"F11: Toggle fullscreen (exclusive mode)\n" // UPDATED
 			"Left Click Info Button: Toggle info\n"
@@ -4671,7 +4237,7 @@ public://setup
 			static_cast<int>(mousePos.y)));
 
 		// Get current image position
-		sf::Vector2f oldImagePos = currentSprite.get()->getPosition();
+		sf::Vector2f oldImagePos = getPagePosition();
 
 		// Calculate zoom
 		float oldZoom = zoomLevel;
@@ -4691,10 +4257,7 @@ public://setup
 
 		// Update scaled texture for new zoom level
 		updateScaledTexture();
-
-		// Set sprite scale
-		float spriteScale = (zoomLevel <= 1.0f) ? 1.0f : zoomLevel;
-		currentSprite.get()->setScale(sf::Vector2f(spriteScale, spriteScale));
+		applyPageScale();
 
 		// Zoom towards mouse position
 		sf::Vector2f newImagePos = oldImagePos;
@@ -4705,7 +4268,7 @@ public://setup
 			newImagePos = worldMousePos + mouseToImage * zoomFactor;
 		}
 
-		currentSprite.get()->setPosition(newImagePos);
+		setPagePosition(newImagePos);
 		imagePosition = newImagePos;
 
 		// Update saved offset from center
@@ -4715,15 +4278,40 @@ public://setup
 		updateDetailedInfo();
 	}
 
-	void setupTextureFromImage(const sf::Image& imageData) {
+	// The tiles share the decoded page's pixels; aliasing pointers keep the page alive
+	static std::vector<TiledPage::Source> getPageSources(const std::shared_ptr<const LoadedImageData>& page) {
+		std::vector<TiledPage::Source> sources;
+		if (page->stripes.empty())
+		{
+			sources.emplace_back(page, &page->image);
+		}
+		else
+		{
+			sources.reserve(page->stripes.size());
+			for (const sf::Image& stripe : page->stripes)
+			{
+				sources.emplace_back(page, &stripe);
+			}
+		}
+		return sources;
+	}
+
+	void setupPage(const std::shared_ptr<const LoadedImageData>& page) {
 		scaledTexture = sf::Texture();
+		pageTurnTexturePending = true;
+		const sf::Vector2u sourceSize = page->sourceSize;
 
-		if (originalTexture.loadFromImage(imageData))
+		// The page stays on the CPU; textures are only made for what is on screen
+		if (tiledPage.build(getPageSources(page), sourceSize, useSmoothing))
 		{
-			originalTexture.setSmooth(useSmoothing);
-			// Update the size tracker (no need for reset check here anymore)
-			sf::Vector2u currentImageSize = originalTexture.getSize();
-			bool needsReset = sizeMismatchHandler.shouldResetZoom(currentImageSize);
+			tiledPage.setViewSize(window.getSize());
+			updateSpreadCompanion(sourceSize);
+			if (currentImageIndex == 0 && currentFolderIndex >= 0 && currentFolderIndex < folders.size())
+			{
+				libraryIndex.recordFirstPage(folders[currentFolderIndex].dir, sourceSize);
+			}
+
+			bool needsReset = sizeMismatchHandler.shouldResetZoom(sourceSize);
 
 			if (needsReset) {
 				// Reset zoom and position for size mismatch
@@ -4733,18 +4321,19 @@ public://setup
 				}
 			}
 
-			lastZoomLevel = -1.0f;
-			updateScaledTexture();
+			// fitToWindow rescales once the zoom for this page is known
 			// Apply current zoom and position (don't reset)
 			fitToWindow(needsReset); // false = don't force reset
 			// debugCurrentScaling();
 			updateStatusText();
 			updateDetailedInfo();
 
-			// Preload next images if using preloading system
+			// Archive entries ahead are extracted in the background, deeper the faster pages are turned
 			if (isCurrentlyInArchive) {
-				archiveHandler.preloadImages(currentImageIndex);
+				pagePrefetcher.onPageTurn(currentImageIndex, currentImages.size(), currentPageWasReady, folderGeneration.token());
 			}
+			schedulePageUploads();
+			updateFolderPrefetch();
 		}
 	}
 
@@ -4769,9 +4358,13 @@ public://setup
 		// Update all button positions in batch
 		updateAllButtonPositions();
 		updateHelpTextPosition();
+		markAllOverlayDirty();
+		tiledPage.setViewSize(newSize);
+		companionPage.setViewSize(newSize);
+		webtoonStrip.setViewSize(newSize);
 
 		// Refit image with current zoom preferences
-		if (originalTexture.getSize().x > 0)
+		if (getCurrentPageSize().x > 0)
 		{
 			fitToWindow(false); // Don't force reset, maintain user preferences
 		}
@@ -4786,7 +4379,7 @@ public: //update funcs
 		sf::Vector2f windowCenter(static_cast<float>(windowSize.x) / 2.0f,
 			static_cast<float>(windowSize.y) / 2.0f);
 
-		sf::FloatRect spriteBounds = currentSprite.get()->getGlobalBounds();
+		sf::FloatRect spriteBounds = getPageBounds();
 		sf::Vector2f imageCenter(spriteBounds.position.x + spriteBounds.size.x / 2.0f,
 			spriteBounds.position.y + spriteBounds.size.y / 2.0f);
 
@@ -4794,45 +4387,272 @@ public: //update funcs
 		hasCustomPosition = (savedImageOffset.x != 0 || savedImageOffset.y != 0);
 	}
 
-	void updateScaledTexture() {
-		if (originalTexture.getSize().x == 0 || originalTexture.getSize().y == 0)
+	// Size of the page at full resolution; a spread is both pages at the height of the current one
+	sf::Vector2u getCurrentPageSize() const {
+		sf::Vector2u size = tiledPage.getPageSize();
+		if (isSpreadActive())
+		{
+			size.x += static_cast<unsigned int>(companionPage.getPageSize().x * getCompanionScale());
+		}
+		return size;
+	}
+
+	bool isSpreadActive() const {
+		return spreadMode && companionPage.isLoaded();
+	}
+
+	// Number of pages currently on screen, which is how far page turns move
+	int getVisiblePageCount() const {
+		return isSpreadActive() ? 2 : 1;
+	}
+
+	// Scale that brings the companion page to the current page's height
+	float getCompanionScale() const {
+		sf::Vector2u primarySize = tiledPage.getPageSize();
+		sf::Vector2u companionSize = companionPage.getPageSize();
+		if (primarySize.y == 0 || companionSize.y == 0) return 1.0f;
+		return static_cast<float>(primarySize.y) / static_cast<float>(companionSize.y);
+	}
+
+	// Bounds of whichever representation of the page is on screen
+	sf::FloatRect getPrimaryBounds() {
+		if (isTiledDisplay()) return tiledPage.getGlobalBounds();
+		return currentSprite.get() ? currentSprite.get()->getGlobalBounds() : sf::FloatRect();
+	}
+
+	sf::FloatRect getCompanionBounds() {
+		if (isTiledDisplay()) return companionPage.getGlobalBounds();
+		return companionSprite.get() ? companionSprite.get()->getGlobalBounds() : sf::FloatRect();
+	}
+
+	// Wide pages are already a double page and are always shown on their own
+	static bool isWidePage(sf::Vector2u size) {
+		return size.x > size.y;
+	}
+
+	bool canPairWith(int index) const {
+		return index >= 0 && index + 1 < currentImages.size();
+	}
+
+	bool isSpreadPartner(sf::Vector2u pageSize, sf::Vector2u partnerSize) const {
+		if (pageSize.x == 0 || partnerSize.x == 0) return false;
+		if (isWidePage(pageSize) || isWidePage(partnerSize)) return false;
+		// Long strips belong in webtoon mode, not in a spread
+		return !ImageLoader::needsStripes(pageSize) && !ImageLoader::needsStripes(partnerSize);
+	}
+
+	// Size of a decoded page, without touching the disk; zero while it isn't decoded
+	sf::Vector2u getDecodedPageSize(int index) const {
+		auto page = getLoadedPage(index);
+		return page ? page->sourceSize : sf::Vector2u(0, 0);
+	}
+
+	// Pairs the current page with the next one; each keeps its own tiles, nothing is composited.
+	// The partner comes from the decoded pages. One that isn't decoded yet is queued on a worker
+	// and paired in once it arrives, so the turn itself never waits on the disk or the archive.
+	void updateSpreadCompanion(sf::Vector2u currentSize) {
+		companionPage.clear();
+		companionScaledTexture = sf::Texture();
+		pendingCompanionIndex = -1;
+		if (!spreadMode || !canPairWith(currentImageIndex)) return;
+
+		int partnerIndex = currentImageIndex + 1;
+		auto partner = getLoadedPage(partnerIndex);
+		if (!partner)
 		{
+			pendingCompanionIndex = partnerIndex;
+			requestPageDecode(partnerIndex);
 			return;
 		}
 
-		sf::Vector2u originalSize = originalTexture.getSize();
-		sf::Vector2u windowSize = window.getSize();
+		if (!isSpreadPartner(currentSize, partner->sourceSize) || !partner->stripes.empty()) return;
+
+		if (companionPage.build(getPageSources(partner), partner->sourceSize, useSmoothing))
+		{
+			companionPage.setViewSize(window.getSize());
+		}
+	}
+
+	// Called once decoded pages are published: completes a spread that was waiting for its partner
+	void resolvePendingCompanion() {
+		if (pendingCompanionIndex < 0 || !getLoadedPage(pendingCompanionIndex)) return;
+
+		if (pendingCompanionIndex != currentImageIndex + 1 || webtoonMode || !tiledPage.isLoaded())
+		{
+			pendingCompanionIndex = -1;
+			return;
+		}
+
+		updateSpreadCompanion(tiledPage.getPageSize());
+		if (isSpreadActive())
+		{
+			fitToWindow(false);
+			requestRedraw();
+		}
+	}
+
+	// How far back a page turn goes so that the previous spread lines up with the one shown before.
+	// Only decoded sizes are used; an undecoded neighbour counts as a single page.
+	int getPreviousSpreadStep(int index) {
+		if (!spreadMode || index < 2) return 1;
+		sf::Vector2u prevSize = getDecodedPageSize(index - 1);
+		sf::Vector2u pairSize = getDecodedPageSize(index - 2);
+		return isSpreadPartner(pairSize, prevSize) ? 2 : 1;
+	}
+
+	// Zoomed-in and striped pages are drawn from tiles; the rest, spreads included, from the
+	// CPU-downscaled textures, which are filtered properly where unmipmapped tiles would alias
+	bool isTiledDisplay() const {
+		return tiledPage.isLoaded() && (tiledPage.isStriped() || zoomLevel > 1.0f);
+	}
+
+	sf::FloatRect getPageBounds() {
+		if (isSpreadActive())
+		{
+			sf::FloatRect left = rightToLeft ? getCompanionBounds() : getPrimaryBounds();
+			sf::FloatRect right = rightToLeft ? getPrimaryBounds() : getCompanionBounds();
+			return sf::FloatRect(left.position, sf::Vector2f(left.size.x + right.size.x, std::max(left.size.y, right.size.y)));
+		}
+		return getPrimaryBounds();
+	}
+
+	sf::Vector2f getPagePosition() {
+		if (isSpreadActive()) return (rightToLeft ? getCompanionBounds() : getPrimaryBounds()).position;
+		if (isTiledDisplay()) return tiledPage.getPosition();
+		return currentSprite.get() ? currentSprite.get()->getPosition() : imagePosition;
+	}
+
+	// Both representations track the position so switching between them doesn't jump
+	void setPagePosition(sf::Vector2f position) {
+		sf::Vector2f primaryPosition = position;
+		if (isSpreadActive())
+		{
+			sf::Vector2f rightPosition(position.x + (rightToLeft ? getCompanionBounds() : getPrimaryBounds()).size.x, position.y);
+			primaryPosition = rightToLeft ? rightPosition : position;
+			sf::Vector2f companionPosition = rightToLeft ? position : rightPosition;
+
+			companionPage.setPosition(companionPosition);
+			if (companionSprite.get())
+			{
+				companionSprite.get()->setPosition(companionPosition);
+			}
+		}
+
+		tiledPage.setPosition(primaryPosition);
+		if (currentSprite.get())
+		{
+			currentSprite.get()->setPosition(primaryPosition);
+		}
+	}
+
+	void applyPageScale() {
+		// Downscaling is baked into scaledTexture, upscaling is done per tile on the GPU
+		tiledPage.setZoom(zoomLevel);
+		if (isSpreadActive())
+		{
+			companionPage.setZoom(zoomLevel * getCompanionScale());
+			// The right-hand page follows the width of the left one
+			setPagePosition(getPagePosition());
+		}
+		if (currentSprite.get())
+		{
+			currentSprite.get()->setScale(sf::Vector2f(1.0f, 1.0f));
+		}
+	}
 
-		// Calculate target size based on zoom and window size
+	// Downscaling: calculate optimal size to maintain quality
+	static sf::Vector2u getScaledTargetSize(sf::Vector2u originalSize, float zoom) {
 		sf::Vector2u targetSize;
+		targetSize.x = static_cast<unsigned int>(originalSize.x * zoom);
+		targetSize.y = static_cast<unsigned int>(originalSize.y * zoom);
 
-		if (zoomLevel <= 1.0f)
+		// Ensure minimum size for readability
+		targetSize.x = std::max(targetSize.x, 100u);
+		targetSize.y = std::max(targetSize.y, 100u);
+		return targetSize;
+	}
+
+	// Zoom fitToWindow would pick for a page of this size
+	float getFitZoom(sf::Vector2u pageSize, bool striped) const {
+		sf::Vector2u windowSize = window.getSize();
+		float scaleX = static_cast<float>(windowSize.x) / static_cast<float>(pageSize.x);
+		float scaleY = static_cast<float>(windowSize.y) / static_cast<float>(pageSize.y);
+
+		// A striped page is scrolled through, so fit its width rather than the whole page
+		return striped ? std::min(scaleX, 1.0f) : std::min(scaleX, scaleY);
+	}
+
+	// Scale the pages a turn can land on to the size they will be shown at. Only pages drawn
+	// from the CPU-downscaled texture qualify; tiled, striped and spread pages upload per tile.
+	void schedulePageUploads() {
+		if (webtoonMode || spreadMode || currentImages.empty()) return;
+
+		std::vector<std::pair<PageUploadCache::Key, PageUploadCache::ScaleJob>> wanted;
+		for (int index : { currentImageIndex + 1, currentImageIndex - 1 })
 		{
-			// Downscaling: calculate optimal size to maintain quality
-			targetSize.x = static_cast<unsigned int>(originalSize.x * zoomLevel);
-			targetSize.y = static_cast<unsigned int>(originalSize.y * zoomLevel);
+			if (index < 0 || index >= currentImages.size()) continue;
+
+			auto page = getLoadedPage(index);
+			if (!page || !page->stripes.empty()) continue;
 
-			// Ensure minimum size for readability
-			targetSize.x = std::max(targetSize.x, 100u);
-			targetSize.y = std::max(targetSize.y, 100u);
+			sf::Vector2u pageSize = page->sourceSize;
+			if (pageSize.x == 0 || pageSize.y == 0) continue;
+
+			float zoom = hasCustomZoom ? savedZoomLevel : getFitZoom(pageSize, false);
+			if (zoom > 1.0f) continue;
+
+			PageUploadCache::Key key{ index, getScaledTargetSize(pageSize, zoom), useSmoothing };
+			CancellationToken token = folderGeneration.token();
+			// The job holds its own reference, so eviction or a folder switch can't free the source
+			wanted.emplace_back(key, [page, key, token]() {
+				return token.isCancelled() ? sf::Image() : ImageScaler::scaleImage(page->image, key.size, key.smooth);
+				});
 		}
-		else
+		pageUploads.prepare(wanted);
+	}
+
+	void updateScaledTexture() {
+		// Only the first scale after a turn can use a pre-uploaded neighbour; zoom and resize can't
+		const bool pageTurn = pageTurnTexturePending;
+		pageTurnTexturePending = false;
+
+		tiledPage.setEnabled(isTiledDisplay());
+		companionPage.setEnabled(isSpreadActive() && isTiledDisplay());
+		if (isTiledDisplay())
 		{
-			// For upscaling, use original texture and let GPU handle it
-			scaledTexture = originalTexture;
-			currentSprite.initialize(scaledTexture);
+			// Tiles take over; don't keep a full-size copy on the GPU
+			scaledTexture = sf::Texture();
+			companionScaledTexture = sf::Texture();
 			return;
 		}
 
+		if (!tiledPage.isLoaded())
+		{
+			return;
+		}
+
+		sf::Vector2u windowSize = window.getSize();
+		sf::Vector2u targetSize = getScaledTargetSize(tiledPage.getPageSize(), zoomLevel);
+
 		// Only rescale if significant change in zoom or window size
 		bool needsRescale = (std::abs(zoomLevel - lastZoomLevel) > 0.1f) ||
 			(windowSize != lastWindowSize) ||
 			(scaledTexture.getSize().x == 0);
 
-		if (needsRescale)
-		{
-			sf::Image originalImage = originalTexture.copyToImage();
-			sf::Image scaledImage = scaleImage(originalImage, targetSize);
+		if (needsRescale)
+		{
+			updateCompanionScaledTexture();
+
+			// A page turn onto a pre-uploaded neighbour is just a texture swap
+			if (pageTurn && pageUploads.take(PageUploadCache::Key{ currentImageIndex, targetSize, useSmoothing }, scaledTexture))
+			{
+				currentSprite.initialize(scaledTexture);
+				lastZoomLevel = zoomLevel;
+				lastWindowSize = windowSize;
+				return;
+			}
+
+			sf::Image scaledImage = ImageScaler::scaleImage(tiledPage.getSourceImage(), targetSize, useSmoothing);
 
 			if (scaledTexture.loadFromImage(scaledImage))
 			{
@@ -4843,6 +4663,22 @@ public: //update funcs
 		}
 	}
 
+	// The companion is scaled to the current page's height at the same zoom
+	void updateCompanionScaledTexture() {
+		if (!isSpreadActive())
+		{
+			companionScaledTexture = sf::Texture();
+			return;
+		}
+
+		sf::Vector2u targetSize = getScaledTargetSize(companionPage.getPageSize(), zoomLevel * getCompanionScale());
+		sf::Image scaledImage = ImageScaler::scaleImage(companionPage.getSourceImage(), targetSize, useSmoothing);
+		if (companionScaledTexture.loadFromImage(scaledImage))
+		{
+			companionSprite.initialize(companionScaledTexture);
+		}
+	}
+
 	void updateLoadingProgress() {
 		if (!isLoadingFolder) return;
 
@@ -4860,8 +4696,14 @@ public: //update funcs
 	void updateStatusText() {
 		if (!folders.empty() && !currentImages.empty())
 		{
+			std::string pageRange = std::to_string(currentImageIndex + 1);
+			if (isSpreadActive() && !webtoonMode)
+			{
+				pageRange += "-" + std::to_string(currentImageIndex + 2);
+			}
+
 			std::string statusString = (
-				"Image: " + std::to_string(currentImageIndex + 1) + "/" +
+				"Image: " + pageRange + "/" +
 				std::to_string(currentImages.size()) + "\n" +
 				"Zoom: " + std::to_string(static_cast<int>(zoomLevel * 100)) + "%" +
 				" | Smooth: " + (useSmoothing ? "ON" : "OFF")
@@ -4876,6 +4718,15 @@ public: //update funcs
 				statusString += " | Maximized";
 			}
 
+			if (webtoonMode)
+			{
+				statusString += " | Webtoon";
+			}
+			else if (spreadMode)
+			{
+				statusString += rightToLeft ? " | Spread (RTL)" : " | Spread";
+			}
+
 			if (isCurrentlyInArchive)
 			{
 				statusString = "[ARCHIVE] " + statusString;
@@ -4889,20 +4740,17 @@ public: //update funcs
 		if (!folders.empty() && !currentImages.empty())
 		{
 			const std::string folderPath = UnicodeUtils::wstringToString(folders[currentFolderIndex].dir);
-			const std::string imagePath = UnicodeUtils::wstringToString(currentImages[currentImageIndex]);
+			const std::string_view pageFileName = currentImages.getFileName(currentImageIndex);
+			size_t dot = pageFileName.rfind('.');
+			std::string extension = dot == std::string_view::npos ? std::string() : std::string(pageFileName.substr(dot));
 			std::string fileName;
-			std::string extension;
+			std::string imagePath;
 			std::string fileSize;
 
 			if (isCurrentlyInArchive)
 			{
-				// Extract filename from archive entry path
-				size_t hashPos = imagePath.find('#');
-				if (hashPos != std::string::npos)
-				{
-					fileName = imagePath.substr(hashPos + 1);
-					extension = std::filesystem::path(fileName).extension().string();
-				}
+				fileName = std::string(currentImages.getName(currentImageIndex));
+				imagePath = folderPath + "#" + fileName;
 				const auto& entries = archiveHandler.getImageEntries();
 				if (currentImageIndex < entries.size()) {
 					fileSize = FileSystemHelper::getFileSizeString(entries[currentImageIndex].size);
@@ -4910,10 +4758,9 @@ public: //update funcs
 			}
 			else
 			{
-				fileName = UnicodeUtils::getFilenameOnly(imagePath);
-				std::filesystem::path path(currentImages[currentImageIndex]);
-				extension = UnicodeUtils::wstringToString(path.extension().wstring());
-				fileSize = FileSystemHelper::getFileSizeString(currentImages[currentImageIndex]);
+				fileName = std::string(pageFileName);
+				imagePath = folderPath + static_cast<char>(std::filesystem::path::preferred_separator) + fileName;
+				fileSize = FileSystemHelper::getFileSizeString(currentImages.getFullPath(currentImageIndex));
 			}
 
 			const std::string dimensions = getImageDimensionsString();
@@ -4921,9 +4768,7 @@ public: //update funcs
 			float imageProgress = ((float)(currentImageIndex + 1) / (float)currentImages.size()) * 100.0f;
 			const std::string current = wrapText(std::string("Current ") + (isCurrentlyInArchive ? "Archive: " : "Folder: ") + UnicodeUtils::getFilenameOnly(folderPath),
 				detailedInfoText.get()->getFont(), detailedInfoText.get()->getCharacterSize(), 580.f);
-			const std::string show_which = isCurrentlyInArchive ?
-				"Archive Entry:\n" + wrapText(fileName, detailedInfoText.get()->getFont(), detailedInfoText.get()->getCharacterSize(), 580.f) :
-				"Full Image Path:\n" + wrapText(imagePath, detailedInfoText.get()->getFont(), detailedInfoText.get()->getCharacterSize(), 580.f);
+			const std::string show_which = "Full Image Path:\n" + wrapText(imagePath, detailedInfoText.get()->getFont(), detailedInfoText.get()->getCharacterSize(), 580.f);
 
 			std::string detailedString = (
 				"=== DETAILED INFORMATION ===\n" +
@@ -4943,9 +4788,38 @@ public: //update funcs
 
 				"=== SOURCE STATISTICS ===\n" +
 				"Total Images in Source: " + std::to_string(currentImages.size()) + "\n" +
+				"Page List Memory: " + FileSystemHelper::getFileSizeString(currentImages.getMemoryBytes()) + "\n" +
 				"Images Remaining: " + std::to_string(currentImages.size() - currentImageIndex - 1) + "\n" +
-				"Total Sources: " + std::to_string(folders.size()) + "\n" +
-				"Sources Remaining: " + std::to_string(folders.size() - currentFolderIndex - 1) + "\n\n" +
+				"Total Sources: " + std::to_string(folders.size()) +
+				(libraryScanner.isScanning() ? " (scanning, " + std::to_string(libraryScanner.getDirectoriesScanned()) + " dirs)" : "") + "\n" +
+				"Reading Progress: " + readingProgress.getStatsString() + "\n" +
+				"Library Index: " + std::to_string(libraryIndex.getDirectoryCount()) + " dirs, " +
+				std::to_string(libraryScanner.getDirectoriesReused()) + " unchanged at last scan\n" +
+				"Sources Remaining: " + std::to_string(folders.size() - currentFolderIndex - 1) + "\n" +
+				"Source Prefetch: " + folderPrefetcher.getStatusString() + "\n" +
+				"Config Saves: " + (config ? config->getSaveStatsString() : std::string("-")) + "\n" +
+				"Last Load Cancel: " + std::to_string(std::lround(lastCancelMs)) + " ms\n" +
+				"First Page Shown: " + (firstPixelMs < 0.0 ? std::string("-") : std::to_string(std::lround(firstPixelMs)) + " ms after start") +
+				" (opening page decode " + std::to_string(std::lround(firstPageDecodeMs)) + " ms)\n" +
+				"Decoded Pages: " + getDecodedPagesString() + "\n" +
+				"Page Prefetch: " + pagePrefetcher.getHitRateString() + " ready, " +
+				std::to_string(pagePrefetcher.getLookahead()) + (pagePrefetcher.getDirection() > 0 ? " ahead" : " behind") + ", " +
+				std::to_string(static_cast<int>(pagePrefetcher.getPagesPerMinute())) + " pages/min\n\n" +
+
+				"=== RENDERING ===\n" +
+				"CPU: " + renderStats.getCpuPercentString() + " of one core\n" +
+				"Last Second: " + std::to_string(renderStats.getLastIntervalFrames()) + " frames, " +
+				std::to_string(renderStats.getLastIntervalWakeups()) + " wake-ups\n" +
+				"Frames Drawn: " + std::to_string(renderStats.getFramesRendered()) + "\n" +
+				"Page Turn: " + renderStats.getPageTurnString() + "\n" +
+				"Pre-uploaded Pages: " + std::to_string(pageUploads.getHitCount()) + " used, " +
+				std::to_string(pageUploads.getMissCount()) + " scaled on the UI thread\n" +
+				"Text Layouts: " + std::to_string(TextLayoutCache::instance().getHitCount()) + " cached, " +
+				std::to_string(TextLayoutCache::instance().getMissCount()) + " wrapped\n" +
+#ifdef MANGAREADER_COUNT_CONVERSIONS
+				"Conversions Last Turn: " + std::to_string(lastTurnConversions) + "\n" +
+#endif
+				"\n" +
 
 				"=== PATH INFORMATION ===\n" +
 				"Full Source Path:\n" + wrapText(folderPath, detailedInfoText.get()->getFont(), detailedInfoText.get()->getCharacterSize(), 580.f) + "\n\n" +
@@ -4953,6 +4827,7 @@ public: //update funcs
 				);
 
 			detailedInfoText.get()->setString(UnicodeUtils::stringToSFString(detailedString));
+			markOverlayDirty(OverlayPanel::DETAILED_INFO);
 		}
 	}
 
@@ -5018,9 +4893,11 @@ public: //navigations and inputs
 
 	void toggleSmoothing() {
 		useSmoothing = !useSmoothing;
-		if (originalTexture.getSize().x > 0)
+		webtoonStrip.setSmooth(useSmoothing);
+		companionPage.setSmooth(useSmoothing);
+		if (tiledPage.isLoaded())
 		{
-			originalTexture.setSmooth(useSmoothing);
+			tiledPage.setSmooth(useSmoothing);
 			// Force rescale with new smoothing setting
 			lastZoomLevel = -1.0f; // Force update
 			updateScaledTexture();
@@ -5028,9 +4905,162 @@ public: //navigations and inputs
 		}
 	}
 
+	void toggleWebtoonMode() {
+		webtoonMode = !webtoonMode;
+		webtoonStrip.clear();
+		if (webtoonMode)
+		{
+			spreadMode = false;
+			companionPage.clear();
+		}
+		else
+		{
+			ensureFolderDecode();
+		}
+
+		if (!currentImages.empty())
+		{
+			loadCurrentImage();
+		}
+		updateStatusText();
+		saveCurrentSession();
+	}
+
+	// Once the reader is past the threshold, open the next source in the background (or the
+	// previous one when near the start, if enabled) so Tab and the last-page advance are instant
+	void updateFolderPrefetch() {
+		if (folders.size() < 2 || currentImages.empty() || folderPrefetchPages == 0) return;
+
+		// Navigation wraps around the library, but reading past the last title back to the
+		// first is rare enough that it isn't worth opening and decoding in advance
+		float position = static_cast<float>(currentImageIndex + getVisiblePageCount()) / static_cast<float>(currentImages.size());
+		int targetIndex = -1;
+		if (position >= folderPrefetchThreshold)
+		{
+			targetIndex = currentFolderIndex + 1 < folders.size() ? currentFolderIndex + 1 : -1;
+		}
+		else if (prefetchPreviousFolder && position <= 1.0f - folderPrefetchThreshold)
+		{
+			targetIndex = currentFolderIndex - 1;
+		}
+
+		if (targetIndex >= 0 && targetIndex != currentFolderIndex)
+		{
+			int resumePage = readingProgress.getResumePage(folders[targetIndex].dir, getVisiblePageCount());
+			folderPrefetcher.request(folders[targetIndex], resumePage, folderPrefetchPages);
+		}
+	}
+
+	void toggleSpreadMode() {
+		spreadMode = !spreadMode;
+		if (spreadMode && webtoonMode)
+		{
+			webtoonMode = false;
+			webtoonStrip.clear();
+			ensureFolderDecode();
+		}
+		companionPage.clear();
+
+		if (!currentImages.empty())
+		{
+			// The page pair changes the fit, so start from a clean fit-to-window
+			resetZoomAndPosition();
+			loadCurrentImage();
+		}
+		updateStatusText();
+		saveCurrentSession();
+	}
+
+	void toggleReadingDirection() {
+		// The pages swap sides within the same spread bounds
+		sf::Vector2f spreadOrigin = getPagePosition();
+		rightToLeft = !rightToLeft;
+		if (isSpreadActive())
+		{
+			setPagePosition(spreadOrigin);
+			requestRedraw();
+		}
+		updateStatusText();
+		saveCurrentSession();
+	}
+
+	// Reuses the folder preload when the page is already decoded; also runs on strip worker threads
+	ImageLoader::LoadResult loadPageAtIndex(int index) {
+		if (auto page = getLoadedPage(index))
+		{
+			return page->stripes.empty() ? ImageLoader::LoadResult(page->image) : ImageLoader::LoadResult(page->stripes, page->sourceSize);
+		}
+
+		ImageLoadingDispatcher::LoadContext context(isCurrentlyInArchive, &archiveHandler, &currentImages, index, folderGeneration.token());
+		return ImageLoadingDispatcher::loadImageAtIndex(context);
+	}
+
+	// Navigation landed on currentImageIndex: make sure the strip covers this source and jump there
+	void showCurrentImageInStrip() {
+		if (webtoonStrip.getPageCount() != currentImages.size())
+		{
+			webtoonStrip.reset(currentImages.size());
+			webtoonStrip.setViewSize(window.getSize());
+
+			// The indexed first page sizes the strip before anything is decoded, so a restored
+			// position doesn't drift as the default heights are corrected
+			if (currentFolderIndex >= 0 && currentFolderIndex < folders.size())
+			{
+				if (const auto* source = libraryIndex.findSource(folders[currentFolderIndex].dir))
+				{
+					webtoonStrip.setPageSize(0, source->firstPageSize);
+				}
+			}
+		}
+		webtoonStrip.scrollToPage(currentImageIndex);
+		updateWindowTitle();
+		updateStatusText();
+		updateDetailedInfo();
+		requestRedraw();
+	}
+
+	// Scrolling past either end of the strip turns into the usual previous/next navigation
+	void scrollWebtoon(float delta) {
+		if (currentImages.empty()) return;
+
+		if (!webtoonStrip.scrollBy(delta))
+		{
+			if (delta > 0 && currentImageIndex == currentImages.size() - 1)
+			{
+				nextImage();
+			}
+			else if (delta < 0 && currentImageIndex == 0)
+			{
+				previousImage();
+			}
+		}
+		syncCurrentImageFromStrip();
+		requestRedraw();
+	}
+
+	void syncCurrentImageFromStrip() {
+		int page = webtoonStrip.getCurrentPage();
+		if (page >= 0 && page < currentImages.size() && page != currentImageIndex)
+		{
+			currentImageIndex = page;
+			recordReadingProgress();
+			updateFolderPrefetch();
+			updateWindowTitle();
+			updateStatusText();
+			updateDetailedInfo();
+			requestRedraw();
+		}
+	}
+
 	void handleScroll(sf::Vector2f delta) {
+		if (webtoonMode)
+		{
+			scrollWebtoon(delta.y);
+			return;
+		}
+
 		imagePosition += delta;
-		currentSprite.get()->setPosition(imagePosition);
+		setPagePosition(imagePosition);
 		updateSavedOffset();
 		hasCustomPosition = true;
 	}
@@ -5068,24 +5098,26 @@ public: //navigations and inputs
 
 	void centerImage() {
 		sf::Vector2u windowSize = window.getSize();
-		sf::FloatRect spriteBounds = currentSprite.get()->getGlobalBounds();
+		sf::FloatRect spriteBounds = getPageBounds();
 
 		imagePosition.x = (static_cast<float>(windowSize.x) - spriteBounds.size.x) / 2.0f;
 		imagePosition.y = (static_cast<float>(windowSize.y) - spriteBounds.size.y) / 2.0f;
 
-		currentSprite.get()->setPosition(imagePosition);
+		// Tall strips start reading from the top
+		if (tiledPage.isStriped() && spriteBounds.size.y > windowSize.y)
+		{
+			imagePosition.y = 0.0f;
+		}
+
+		setPagePosition(imagePosition);
 	}
 
 	void fitToWindow(bool forceReset = false) {
-		if (originalTexture.getSize().x == 0 || originalTexture.getSize().y == 0) return;
-
-		sf::Vector2u textureSize = originalTexture.getSize();
-		sf::Vector2u windowSize = window.getSize();
+		sf::Vector2u textureSize = getCurrentPageSize();
+		if (textureSize.x == 0 || textureSize.y == 0) return;
 
 		// Calculate the fit-to-window zoom for current image
-		float scaleX = static_cast<float>(windowSize.x) / static_cast<float>(textureSize.x);
-		float scaleY = static_cast<float>(windowSize.y) / static_cast<float>(textureSize.y);
-		float fitToWindowZoom = std::min(scaleX, scaleY);
+		float fitToWindowZoom = getFitZoom(textureSize, tiledPage.isStriped());
 
 		if (forceReset || !hasCustomZoom)
 		{
@@ -5093,12 +5125,6 @@ public: //navigations and inputs
 			zoomLevel = fitToWindowZoom;
 			savedZoomLevel = fitToWindowZoom;
 			hasCustomZoom = false;
-
-			// Clear any existing sprite scaling
-			if (currentSprite.get())
-			{
-				currentSprite.get()->setScale(sf::Vector2f(1.0f, 1.0f));
-			}
 		}
 		else
 		{
@@ -5109,13 +5135,7 @@ public: //navigations and inputs
 		// FORCE regenerate scaled texture
 		lastZoomLevel = -1.0f; // Force update
 		updateScaledTexture();
-
-		// Set sprite scale
-		float spriteScale = (zoomLevel <= 1.0f) ? 1.0f : zoomLevel;
-		if (currentSprite.get())
-		{
-			currentSprite.get()->setScale(sf::Vector2f(spriteScale, spriteScale));
-		}
+		applyPageScale();
 
 		// Center the image or use saved position
 		if (forceReset || !hasCustomPosition)
@@ -5131,15 +5151,12 @@ public: //navigations and inputs
 			sf::Vector2f windowCenter(static_cast<float>(windowSizeU.x) / 2.0f,
 				static_cast<float>(windowSizeU.y) / 2.0f);
 
-			if (currentSprite.get())
-			{
-				sf::FloatRect spriteBounds = currentSprite.get()->getGlobalBounds();
-				sf::Vector2f newImagePos = windowCenter - sf::Vector2f(spriteBounds.size.x / 2.0f,
-					spriteBounds.size.y / 2.0f) + savedImageOffset;
+			sf::FloatRect spriteBounds = getPageBounds();
+			sf::Vector2f newImagePos = windowCenter - sf::Vector2f(spriteBounds.size.x / 2.0f,
+				spriteBounds.size.y / 2.0f) + savedImageOffset;
 
-				imagePosition = newImagePos;
-				currentSprite.get()->setPosition(imagePosition);
-			}
+			imagePosition = newImagePos;
+			setPagePosition(imagePosition);
 		}
 
 		scrollOffset = 0;
@@ -5150,8 +5167,9 @@ public: //navigations and inputs
 	void nextImage() {
 		NavigationHelper::executeIfNavigationAllowed(navLock, [this]() {
 			if (currentImages.empty()) return;
+			renderStats.beginPageTurn();
 
-			int nextIndex = currentImageIndex + 1;
+			int nextIndex = currentImageIndex + (webtoonMode ? 1 : getVisiblePageCount());
 
 			if (nextIndex >= currentImages.size())
 			{
@@ -5168,11 +5186,16 @@ public: //navigations and inputs
 				}
 			}
 
+			int previousIndex = currentImageIndex;
 			currentImageIndex = nextIndex;
 
 			if (isCurrentlyInArchive)
 			{
-				archiveHandler.clearCache(currentImageIndex - 1);
+				// Drop every page that was on screen, the whole pair in spread mode
+				for (int i = previousIndex; i < nextIndex; ++i)
+				{
+					archiveHandler.clearCache(i);
+				}
 			}
 
 			loadCurrentImage();
@@ -5182,15 +5205,17 @@ public: //navigations and inputs
 	void previousImage() {
 		NavigationHelper::executeIfNavigationAllowed(navLock, [this]() {
 			if (currentImages.empty()) return;
+			renderStats.beginPageTurn();
 
-			int prevIndex = currentImageIndex - 1;
+			int prevIndex = currentImageIndex - (webtoonMode ? 1 : getPreviousSpreadStep(currentImageIndex));
 
 			if (prevIndex < 0)
 			{
 				previousFolder();
 				if (!currentImages.empty())
 				{
-					currentImageIndex = currentImages.size() - 1;
+					// Land on the last spread rather than a lone last page
+					currentImageIndex = currentImages.size() - getPreviousSpreadStep(currentImages.size());
 					loadCurrentImage();
 				}
 				return;
@@ -5205,11 +5230,16 @@ public: //navigations and inputs
 				}
 			}
 
+			int leavingCount = webtoonMode ? 1 : getVisiblePageCount();
+			int previousIndex = currentImageIndex;
 			currentImageIndex = prevIndex;
 
 			if (isCurrentlyInArchive)
 			{
-				archiveHandler.clearCache(currentImageIndex + 1);
+				for (int i = previousIndex; i < previousIndex + leavingCount; ++i)
+				{
+					archiveHandler.clearCache(i);
+				}
 			}
 
 			loadCurrentImage();
@@ -5217,13 +5247,16 @@ public: //navigations and inputs
 	}
 
 	void nextFolder() {
+		if (!canSwitchFolder()) return;
+
+		// Interrupting a folder load releases its navigation lock
+		cancelFolderLoading();
+
 		NavigationHelper::executeIfNavigationAllowed(navLock, [this]() {
 			if (folders.empty()) return;
 
-			if (folderLoadingFuture.valid())
-			{
-				folderLoadingFuture.wait();
-			}
+			webtoonStrip.clear();
+			pagePrefetcher.reset();
 
 			if (isCurrentlyInArchive)
 			{
@@ -5243,8 +5276,9 @@ public: //navigations and inputs
 
 				try
 				{
-					loadImagesFromFolder(folders[currentFolderIndex]);
-					currentImageIndex = 0;
+					int resumePage = readingProgress.getResumePage(folders[currentFolderIndex].dir, getVisiblePageCount());
+					loadImagesFromFolder(folders[currentFolderIndex], resumePage);
+					currentImageIndex = std::clamp(resumePage, 0, std::max(0, static_cast<int>(currentImages.size()) - 1));
 					if (!currentImages.empty() && loadCurrentImage())
 					{
 						updateNavigationButtons(); // Update button states
@@ -5263,13 +5297,16 @@ public: //navigations and inputs
 	}
 
 	void previousFolder() {
+		if (!canSwitchFolder()) return;
+
+		// Interrupting a folder load releases its navigation lock
+		cancelFolderLoading();
+
 		NavigationHelper::executeIfNavigationAllowed(navLock, [this]() {
 			if (folders.empty()) return;
 
-			if (folderLoadingFuture.valid())
-			{
-				folderLoadingFuture.wait();
-			}
+			webtoonStrip.clear();
+			pagePrefetcher.reset();
 
 			if (isCurrentlyInArchive)
 			{
@@ -5289,8 +5326,9 @@ public: //navigations and inputs
 
 				try
 				{
-					loadImagesFromFolder(folders[currentFolderIndex]);
-					currentImageIndex = 0;
+					int resumePage = readingProgress.getResumePage(folders[currentFolderIndex].dir, getVisiblePageCount());
+					loadImagesFromFolder(folders[currentFolderIndex], resumePage);
+					currentImageIndex = std::clamp(resumePage, 0, std::max(0, static_cast<int>(currentImages.size()) - 1));
 					if (!currentImages.empty() && loadCurrentImage())
 					{
 						updateNavigationButtons(); // Update button states
@@ -5321,6 +5359,7 @@ public: //navigations and inputs
 		{
 			handleWindowResize(currentSize);
 			lastWindowSize = currentSize;
+			requestRedraw();
 		}
 
 		window.handleEvents(
@@ -5332,16 +5371,17 @@ public: //navigations and inputs
 			},
 			[&](const sf::Event::KeyPressed& kp) {
 				if (LockedMessageBox::isActive()) return;
+				requestRedraw();
 
 				switch (kp.code)
 				{
 				case sf::Keyboard::Key::Up:
 				case sf::Keyboard::Key::W:
-					if (navLock.isNavigationAllowed()) handleScroll(sf::Vector2f(0, -50));
+					if (webtoonMode || navLock.isNavigationAllowed()) handleScroll(sf::Vector2f(0, -50));
 					break;
 				case sf::Keyboard::Key::Down:
 				case sf::Keyboard::Key::S:
-					if (navLock.isNavigationAllowed()) handleScroll(sf::Vector2f(0, 50));
+					if (webtoonMode || navLock.isNavigationAllowed()) handleScroll(sf::Vector2f(0, 50));
 					break;
 				case sf::Keyboard::Key::Left:
 				case sf::Keyboard::Key::A:
@@ -5381,6 +5421,22 @@ public: //navigations and inputs
 				case sf::Keyboard::Key::Q:
 					if (navLock.isNavigationAllowed()) toggleSmoothing();
 					break;
+				case sf::Keyboard::Key::V:
+					if (navLock.isNavigationAllowed()) toggleWebtoonMode();
+					break;
+				case sf::Keyboard::Key::P:
+					if (navLock.isNavigationAllowed()) toggleSpreadMode();
+					break;
+				case sf::Keyboard::Key::L:
+					if (navLock.isNavigationAllowed()) toggleReadingDirection();
+					break;
+				case sf::Keyboard::Key::PageDown:
+				case sf::Keyboard::Key::Space:
+					if (webtoonMode) scrollWebtoon(window.getSize().y * 0.9f);
+					break;
+				case sf::Keyboard::Key::PageUp:
+					if (webtoonMode) scrollWebtoon(-(window.getSize().y * 0.9f));
+					break;
 				case sf::Keyboard::Key::F11:
 					toggleFullscreen();  // Changed from toggleMaximize()
 					saveCurrentSession(); // Save state change
@@ -5399,6 +5455,7 @@ public: //navigations and inputs
 			},
 			[&](const sf::Event::MouseWheelScrolled& mwhl) {
 				if (LockedMessageBox::isActive()) return;
+				requestRedraw();
 
 				if (mwhl.wheel == sf::Mouse::Wheel::Vertical)
 				{
@@ -5406,7 +5463,12 @@ public: //navigations and inputs
 						sf::Keyboard::isKeyPressed(sf::Keyboard::Key::RControl))
 					{
 						// Zoom with Ctrl + Mouse Wheel
-						if (navLock.isNavigationAllowed()) handleZoom(mwhl.delta);
+						if (navLock.isNavigationAllowed() && !webtoonMode) handleZoom(mwhl.delta);
+					}
+					else if (webtoonMode)
+					{
+						// Continuous scroll instead of page turns
+						scrollWebtoon(-mwhl.delta * WEBTOON_WHEEL_STEP);
 					}
 					else
 					{
@@ -5424,6 +5486,7 @@ public: //navigations and inputs
 			},
 			[&](const sf::Event::MouseButtonPressed& mb) {
 				if (LockedMessageBox::isActive()) return;
+				requestRedraw();
 
 				if (mb.button == sf::Mouse::Button::Middle)
 				{
@@ -5445,7 +5508,13 @@ public: //navigations and inputs
 
 				// Check if mouse is over memory warning for hover effect
 				sf::Vector2f mousePos = window.mapPixelToCoords(sf::Vector2i(mm.position.x, mm.position.y));
-				memoryWarningHovered = isMouseOverMemoryWarning(mousePos);
+				bool hovered = isMouseOverMemoryWarning(mousePos);
+				if (hovered != memoryWarningHovered)
+				{
+					memoryWarningHovered = hovered;
+					markOverlayDirty(OverlayPanel::MEMORY_WARNING);
+					requestRedraw();
+				}
 			},
 			[&](const sf::Event::MouseButtonReleased& mb) {
 				if (LockedMessageBox::isActive()) return;
@@ -5455,138 +5524,166 @@ public: //navigations and inputs
 				if (LockedMessageBox::isActive()) return;
 					handleWindowResize(sf::Vector2u(resize.size.x, resize.size.y));
 				saveCurrentSession(); // Save window size changes
+				requestRedraw();
 			},
 			[&](const sf::Event::FocusLost&) {
 				if (LockedMessageBox::isActive()) return;
 			},
 			[&](const sf::Event::FocusGained&) {
 				if (LockedMessageBox::isActive()) return;
+				// The compositor may have discarded our last frame
+				requestRedraw();
 			}
 		);
 	}
 
 public: //rendering
-	void drawLoadingOverlay(sf::RenderWindow& window) {
-		if (!isLoadingFolder) return;
+	void markOverlayDirty(OverlayPanel panel) {
+		overlayDirty[static_cast<size_t>(panel)] = true;
+	}
 
-		// Semi-transparent overlay
-		sf::RectangleShape overlay;
-		overlay.setSize(sf::Vector2f(static_cast<float>(window.getSize().x),
-			static_cast<float>(window.getSize().y)));
-		overlay.setFillColor(sf::Color(0, 0, 0, 150));
-		window.draw(overlay);
-
-		// Loading text background
-		sf::RectangleShape loadingBg;
-		loadingBg.setSize(sf::Vector2f(400.0f, 60.0f));
-		loadingBg.setPosition(sf::Vector2f(
-			(static_cast<float>(window.getSize().x) - 400.0f) / 2.0f,
-			(static_cast<float>(window.getSize().y) - 60.0f) / 2.0f
-		));
-		loadingBg.setFillColor(sf::Color(50, 50, 50, 200));
-		loadingBg.setOutlineThickness(2);
-		loadingBg.setOutlineColor(sf::Color::White);
-		window.draw(loadingBg);
-
-		// Center the loading text
-		loadingText.get()->setPosition(sf::Vector2f(
-			loadingBg.getPosition().x + 20.0f,
-			loadingBg.getPosition().y + 20.0f
-		));
-		window.draw(*loadingText.get());
+	void markAllOverlayDirty() {
+		overlayDirty.fill(true);
+	}
+
+	// Draws a panel's cached background, rebuilding it first if its content changed
+	void drawOverlayPanel(OverlayPanel panel) {
+		size_t index = static_cast<size_t>(panel);
+		if (overlayDirty[index])
+		{
+			overlayGeometry[index].clear();
+			rebuildOverlayPanel(panel, overlayGeometry[index]);
+			overlayDirty[index] = false;
+		}
+		overlayGeometry[index].draw(window);
+	}
+
+	// Lays out one panel's background and positions its text
+	void rebuildOverlayPanel(OverlayPanel panel, OverlayGeometry& geometry) {
+		const sf::Vector2f windowSize(static_cast<float>(window.getSize().x), static_cast<float>(window.getSize().y));
+
+		switch (panel)
+		{
+		case OverlayPanel::STATUS:
+			geometry.addRect(sf::FloatRect({ 5.0f, 5.0f }, { 450.0f, 100.0f }), sf::Color(0, 0, 0, 150));
+			break;
+		case OverlayPanel::DETAILED_INFO:
+		{
+			sf::FloatRect textBounds = detailedInfoText.get()->getLocalBounds();
+			sf::FloatRect background({ 5.0f, 115.0f }, { textBounds.size.x + 20.f, textBounds.size.y + 20.f });
+			geometry.addOutlinedRect(background, sf::Color(0, 0, 0, 180), 2.0f, sf::Color::Cyan);
+			detailedInfoText.get()->setPosition(sf::Vector2f(background.position.x + 10.f, background.position.y + 10.f));
+			break;
+		}
+		case OverlayPanel::HELP:
+		{
+			sf::FloatRect helpBounds = helpText.get()->getLocalBounds();
+			sf::Vector2f helpPosition = helpText.get()->getPosition();
+			geometry.addRect(sf::FloatRect({ helpPosition.x - 10.f, helpPosition.y - 10.f }, { helpBounds.size.x + 20.f, helpBounds.size.y + 20.f }),
+				sf::Color(0, 0, 0, 150));
+			break;
+		}
+		case OverlayPanel::MEMORY_WARNING:
+		{
+			// Make warning more visible if hovered
+			sf::Color bgColor = memoryWarningHovered ?
+				sf::Color(255, 100, 0, 240) :  // Brighter orange when hovered
+				sf::Color(255, 165, 0, 200);   // Normal orange
+			geometry.addOutlinedRect(sf::FloatRect(memoryWarningPosition, { memoryWarningSize, memoryWarningSize }), bgColor, 1.0f, sf::Color::White);
+			break;
+		}
+		case OverlayPanel::MEMORY_HOVER:
+		{
+			sf::FloatRect hoverBounds = memoryHoverText.get()->getLocalBounds();
+
+			// Position hover text to the left of the warning to avoid going off screen
+			float hoverX = memoryWarningPosition.x - hoverBounds.size.x - 30.0f;
+			if (hoverX < 10.0f)
+			{
+				hoverX = memoryWarningPosition.x + memoryWarningSize + 10.0f; // Show on right if no space on left
+			}
+
+			sf::FloatRect background({ hoverX, memoryWarningPosition.y - 10.0f }, { hoverBounds.size.x + 20.f, hoverBounds.size.y + 20.f });
+			geometry.addOutlinedRect(background, sf::Color(0, 0, 0, 220), 2.0f, sf::Color(255, 165, 0));
+			memoryHoverText.get()->setPosition(sf::Vector2f(background.position.x + 10.f, background.position.y + 10.f));
+			break;
+		}
+		case OverlayPanel::NAVIGATION_LOCK:
+		{
+			sf::FloatRect background({ (windowSize.x - 350.0f) / 2.0f, windowSize.y - 100.0f }, { 350.0f, 70.0f });
+			geometry.addOutlinedRect(background, sf::Color(255, 165, 0, 220), 3.0f, sf::Color::White); // Orange
+			lockText.get()->setPosition(sf::Vector2f(background.position.x + 20.0f, background.position.y + 15.0f));
+			break;
+		}
+		case OverlayPanel::LOADING:
+		{
+			// Semi-transparent overlay
+			geometry.addRect(sf::FloatRect({ 0.0f, 0.0f }, windowSize), sf::Color(0, 0, 0, 150));
+
+			sf::FloatRect background({ (windowSize.x - 400.0f) / 2.0f, (windowSize.y - 60.0f) / 2.0f }, { 400.0f, 60.0f });
+			geometry.addOutlinedRect(background, sf::Color(50, 50, 50, 200), 2.0f, sf::Color::White);
+			loadingText.get()->setPosition(sf::Vector2f(background.position.x + 20.0f, background.position.y + 20.0f));
+			break;
+		}
+		default:
+			break;
+		}
 	}
 
 	void render() {
 		window.clear(sf::Color::Black);
 
-		// Update memory warning status
-		updateMemoryWarning();
-
 		// Draw current image
-		if (currentSprite.get()->getTexture().getSize().x > 0)
+		if (webtoonMode)
+		{
+			webtoonStrip.draw(window);
+		}
+		else if (isTiledDisplay())
+		{
+			tiledPage.draw(window);
+			if (isSpreadActive())
+			{
+				companionPage.draw(window);
+			}
+		}
+		else if (currentSprite.get() && currentSprite.get()->getTexture().getSize().x > 0)
 		{
 			window.draw(*currentSprite.get());
+			if (isSpreadActive() && companionSprite.get() && companionScaledTexture.getSize().x > 0)
+			{
+				window.draw(*companionSprite.get());
+			}
 		}
 
 		// Draw UI
 		if (showUI)
 		{
-			// Semi-transparent background for status text
-			sf::RectangleShape statusBg;
-			statusBg.setSize(sf::Vector2f(450.0f, 100.0f));
-			statusBg.setPosition(sf::Vector2f(5.0f, 5.0f));
-			statusBg.setFillColor(sf::Color(0, 0, 0, 150));
-			window.draw(statusBg);
-
+			drawOverlayPanel(OverlayPanel::STATUS);
 			window.draw(*statusText.get());
 
 			// Draw detailed info if visible
 			if (buttonManager.isButtonToggled(ButtonID::INFO_BUTTON))
 			{
-				sf::RectangleShape detailedBg;
-				sf::FloatRect textBounds = detailedInfoText.get()->getLocalBounds();
-
-				detailedBg.setSize({ textBounds.size.x + 20.f, textBounds.size.y + 20.f });
-				detailedBg.setPosition(sf::Vector2f(5.0f, 115.0f));
-				detailedBg.setFillColor(sf::Color(0, 0, 0, 180));
-				detailedBg.setOutlineThickness(2);
-				detailedBg.setOutlineColor(sf::Color::Cyan);
-				window.draw(detailedBg);
-
-				detailedInfoText.get()->setPosition(sf::Vector2f(detailedBg.getPosition().x + 10.f,
-					detailedBg.getPosition().y + 10.f));
-
+				drawOverlayPanel(OverlayPanel::DETAILED_INFO);
 				window.draw(*detailedInfoText.get());
 			}
 
 			if (showHelpText && buttonManager.isButtonToggled(ButtonID::HELP_BUTTON))
 			{
-				// Optional: Add semi-transparent background for help text
-				sf::FloatRect helpBounds = helpText.get()->getLocalBounds();
-				sf::RectangleShape helpBg;
-				helpBg.setSize({ helpBounds.size.x + 20.f, helpBounds.size.y + 20.f });
-				helpBg.setPosition(sf::Vector2f(helpText.get()->getPosition().x - 10.f,
-					helpText.get()->getPosition().y - 10.f));
-				helpBg.setFillColor(sf::Color(0, 0, 0, 150));
-				window.draw(helpBg);
-
+				drawOverlayPanel(OverlayPanel::HELP);
 				window.draw(*helpText.get());
 			}
 
 			// Draw memory warning if needed
 			if (showMemoryWarning)
 			{
-				// Make warning more visible if hovered
-				sf::Color bgColor = memoryWarningHovered ?
-					sf::Color(255, 100, 0, 240) :  // Brighter orange when hovered
-					sf::Color(255, 165, 0, 200);   // Normal orange
-
-				memoryWarningBg.setFillColor(bgColor);
-				window.draw(memoryWarningBg);
+				drawOverlayPanel(OverlayPanel::MEMORY_WARNING);
 				window.draw(*memoryWarningText.get());
 
 				// Show hover text if mouse is over warning
 				if (memoryWarningHovered)
 				{
-					sf::FloatRect hoverBounds = memoryHoverText.get()->getLocalBounds();
-					sf::RectangleShape hoverBg;
-					hoverBg.setSize({ hoverBounds.size.x + 20.f, hoverBounds.size.y + 20.f });
-
-					// Position hover text to the left of the warning to avoid going off screen
-					float hoverX = memoryWarningPosition.x - hoverBounds.size.x - 30.0f;
-					if (hoverX < 10.0f)
-					{
-						hoverX = memoryWarningPosition.x + memoryWarningSize + 10.0f; // Show on right if no space on left
-					}
-
-					hoverBg.setPosition(sf::Vector2f(hoverX, memoryWarningPosition.y - 10.0f));
-					hoverBg.setFillColor(sf::Color(0, 0, 0, 220));
-					hoverBg.setOutlineThickness(2);
-					hoverBg.setOutlineColor(sf::Color(255, 165, 0));
-					window.draw(hoverBg);
-
-					memoryHoverText.get()->setPosition(sf::Vector2f(hoverBg.getPosition().x + 10.f,
-						hoverBg.getPosition().y + 10.f));
+					drawOverlayPanel(OverlayPanel::MEMORY_HOVER);
 					window.draw(*memoryHoverText.get());
 				}
 			}
@@ -5595,26 +5692,14 @@ public: //rendering
 		// SHOW NAVIGATION LOCK INDICATOR when locked
 		if (navLock.isNavigationLocked())
 		{
-			sf::RectangleShape lockIndicator;
-			lockIndicator.setSize(sf::Vector2f(350.0f, 70.0f));
-			lockIndicator.setPosition(sf::Vector2f(
-				(static_cast<float>(window.getSize().x) - 350.0f) / 2.0f,
-				static_cast<float>(window.getSize().y) - 100.0f
-			));
-			lockIndicator.setFillColor(sf::Color(255, 165, 0, 220)); // Orange
-			lockIndicator.setOutlineThickness(3);
-			lockIndicator.setOutlineColor(sf::Color::White);
-			window.draw(lockIndicator);
-
-			sf_text_wrapper lockText;
-			lockText.initialize(*font.get(), 18u);
-			std::string message = "NAVIGATION LOCKED\n" + navLock.getCurrentOperation() + "...";
-			lockText.get()->setString(message);
-			lockText.get()->setFillColor(sf::Color::White);
-			lockText.get()->setPosition(sf::Vector2f(
-				lockIndicator.getPosition().x + 20.0f,
-				lockIndicator.getPosition().y + 15.0f
-			));
+			std::string operation = navLock.getCurrentOperation();
+			if (operation != lockTextOperation)
+			{
+				lockTextOperation = operation;
+				lockText.get()->setString("NAVIGATION LOCKED\n" + operation + "...");
+			}
+
+			drawOverlayPanel(OverlayPanel::NAVIGATION_LOCK);
 			window.draw(*lockText.get());
 		}
 
@@ -5622,10 +5707,10 @@ public: //rendering
 		if (isLoadingFolder)
 		{
 			updateLoadingProgress();
-			drawLoadingOverlay(window);
+			drawOverlayPanel(OverlayPanel::LOADING);
+			window.draw(*loadingText.get());
 		}
 
-		// Draw loading overlay if loading folder
 		buttonManager.drawAll(window);
 
 		window.display();
@@ -5667,11 +5752,133 @@ public: //main aplication function
 		return L"";
 	}
 
+	void requestRedraw() {
+		needsRedraw = true;
+	}
+
+	// Safe from worker threads: marks the frame dirty and wakes the UI thread out of its wait
+	void wakeRenderLoop() {
+		needsRedraw = true;
+		HWND hwnd = window.getNativeHandle();
+		if (hwnd)
+		{
+			PostMessageW(hwnd, WM_NULL, 0, 0);
+		}
+	}
+
+	void applyFrameRateSettings() {
+		bool useVSync = config->getBool(CONFIG_VERTICAL_SYNC, false);
+		int frameLimit = std::max(0, config->getInt(CONFIG_FRAME_RATE_LIMIT, 60));
+
+		// SFML advises against combining the two
+		window.setVerticalSyncEnabled(useVSync);
+		window.setFramerateLimit(useVSync ? 0 : static_cast<unsigned int>(frameLimit));
+	}
+
+	// Work that still changes the screen without any input
+	bool hasPendingWork() {
+		return isLoadingFolder || navLock.isNavigationLocked() || !pageDecodeJobs.empty() || (webtoonMode && webtoonStrip.hasPendingWork()) ||
+			libraryScanner.isScanning() || libraryWatcher.hasPendingChanges();
+	}
+
+	// Block until there is input, a posted wake-up, or a timeout
+	void waitForWork() {
+		if (needsRedraw) return;
+
+		DWORD timeout = hasPendingWork() ? BUSY_WAKE_MS : IDLE_WAKE_MS;
+		MsgWaitForMultipleObjectsEx(0, nullptr, timeout, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+		renderStats.onWakeup();
+	}
+
+	void updateBackgroundState() {
+		publishDecodedPages();
+		reapPageDecodeJobs();
+		resolvePendingCompanion();
+
+		bool libraryChanged = mergeScannedFolders();
+		if (!libraryScanner.isScanning())
+		{
+			if (finishLibraryScan() || finishLibraryRefresh())
+			{
+				libraryChanged = true;
+			}
+
+			// Watcher changes wait for a running scan, which sees them anyway
+			LibraryWatcher::Changes changes;
+			int debounceMs = config ? config->getInt(CONFIG_LIBRARY_WATCH_DEBOUNCE_MS, 500) : 500;
+			if (libraryWatcher.takeChanges(changes, std::max(0, debounceMs)))
+			{
+				applyLibraryChanges(changes);
+				libraryChanged = true;
+			}
+		}
+		if (libraryChanged)
+		{
+			updateDetailedInfo();
+			requestRedraw();
+		}
+
+		if (pageUploads.update())
+		{
+			requestRedraw();
+		}
+
+		if (webtoonMode)
+		{
+			if (webtoonStrip.update())
+			{
+				requestRedraw();
+			}
+			syncCurrentImageFromStrip();
+		}
+
+		// Keep the progress overlay moving, and draw once more when it finishes
+		bool busy = hasPendingWork();
+		if (busy || wasBusyLastWake)
+		{
+			requestRedraw();
+		}
+		if (wasBusyLastWake && !busy)
+		{
+			// The neighbours were probably still decoding at the last turn
+			schedulePageUploads();
+		}
+		wasBusyLastWake = busy;
+
+		if (memoryCheckClock.getElapsedTime().asMilliseconds() >= MEMORY_CHECK_MS)
+		{
+			memoryCheckClock.restart();
+			if (updateMemoryWarning())
+			{
+				requestRedraw();
+			}
+			if (showMemoryWarning)
+			{
+				evictDistantPages();
+			}
+		}
+
+		if (renderStats.sample(std::chrono::milliseconds(MEMORY_CHECK_MS)) &&
+			showUI && buttonManager.isButtonToggled(ButtonID::INFO_BUTTON))
+		{
+			updateDetailedInfo();
+			requestRedraw();
+		}
+	}
+
 	void run() {
 		while (window.isOpen())
 		{
+			waitForWork();
 			handleInput();
-			render();
+			updateBackgroundState();
+
+			if (needsRedraw.exchange(false))
+			{
+				render();
+				renderStats.onFrame();
+				noteFirstPixel();
+			}
 		}
 	}
 
@@ -5801,4 +6008,4 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
 	}
 
 	return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,31 @@
+﻿#include "MangaReaderCore.h"
+
+#ifdef _WIN32
+HWND LockedMessageBox::mainWindowHandle = NULL;
+bool LockedMessageBox::isMessageBoxActive = false;
+thread_local int LockedMessageBox::silentDepth = 0;
+LONG LockedMessageBox::originalWindowStyle = 0;
+bool LockedMessageBox::wasMaximized = false;
+RECT LockedMessageBox::originalWindowRect = { 0, 0, 0, 0 };
+#endif
+
+// Extension checks only filter candidate entries, the decoder is picked from the file content
+bool IsImgExtValid(std::string_view ext) {
+	return extensionInList(ext, supportedExtensions);
+}
+
+bool IsImgExtValid(std::wstring_view ext) {
+	return extensionInList(ext, supportedExtensions);
+}
+
+bool IsArchiveExtValid(std::string_view ext) {
+	return extensionInList(ext, supportedArchives);
+}
+
+bool IsArchiveExtValid(std::wstring_view ext) {
+	return extensionInList(ext, supportedArchives);
+}
+
+// Conservative defaults until the window reports the real limit
+std::atomic<unsigned int> ImageLoader::maxTextureDimension(8192);
+std::atomic<unsigned int> ImageLoader::stripeTargetWidth(0);
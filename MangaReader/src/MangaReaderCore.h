@@ -0,0 +1,5174 @@
+﻿#pragma once
+
+// The reader's core: archives, decoding, scaling, the library and the config. It only touches
+// Win32 behind _WIN32, so it builds on any platform; CMakeLists.txt builds it as the
+// mangareader_core library that the reader and the benchmarks link against.
+// MANGAREADER_COUNT_CONVERSIONS counts UTF-8/UTF-16 conversions for the conversions benchmark
+// and shows the count of the last page turn in the detailed info; normal builds leave it out.
+
+#include <SFML/Graphics.hpp>
+#include <SFML/System.hpp>
+
+#include <iostream>
+#include <filesystem>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <set>
+#ifdef _WIN32
+#include <windows.h>
+#include <commdlg.h>
+#include <shlobj.h>
+#include <objbase.h>
+#include <psapi.h>
+#else
+#include <unistd.h>
+#endif
+#include <codecvt>
+#include <locale>
+#include <future>
+#include <fstream>
+#include <map>
+#include <shared_mutex>
+#include <array>
+#include <cstring>
+#include <string_view>
+#include <cmath>
+#include <chrono>
+#include <unordered_map>
+#include <deque>
+#include <list>
+#include <memory>
+#include <atomic>
+#include <condition_variable>
+
+// Define SFML_STATIC if not already defined (for static linking)
+#ifndef SFML_STATIC
+#define SFML_STATIC
+#endif
+
+#include <archive.h>
+#include <archive_entry.h>
+
+#include <webp/decode.h>
+#include <cstdio>
+#include <csetjmp>
+#include <jpeglib.h>
+#include <png.h>
+
+#ifdef _WIN32
+class LockedMessageBox {
+private:
+	static HWND mainWindowHandle;
+	static bool isMessageBoxActive;
+	static thread_local int silentDepth;
+	static LONG originalWindowStyle;
+	static bool wasMaximized;
+	static RECT originalWindowRect;
+
+public:
+	// Set the main window handle (call this in your constructor)
+	static void setMainWindow(HWND hwnd) {
+		mainWindowHandle = hwnd;
+	}
+
+	// Check if message box is currently active
+	static bool isActive() {
+		return isMessageBoxActive;
+	}
+
+	// Lock the main window completely (disable moving, resizing, etc.)
+	static void lockMainWindow() {
+		if (!mainWindowHandle) return;
+
+		// Store original window state
+		wasMaximized = IsZoomed(mainWindowHandle);
+		GetWindowRect(mainWindowHandle, &originalWindowRect);
+
+		// Get current window style and store it
+		originalWindowStyle = GetWindowLongW(mainWindowHandle, GWL_STYLE);
+
+		// Remove resizing, moving, and system menu capabilities
+		LONG newStyle = originalWindowStyle;
+		newStyle &= ~(WS_SIZEBOX | WS_MAXIMIZEBOX | WS_MINIMIZEBOX);
+		newStyle &= ~WS_SYSMENU; // Remove system menu (prevents moving via title bar)
+
+		SetWindowLongW(mainWindowHandle, GWL_STYLE, newStyle);
+
+		// Disable the window completely
+		EnableWindow(mainWindowHandle, FALSE);
+
+		// Force window to stay in place
+		SetWindowPos(mainWindowHandle, HWND_NOTOPMOST,
+			originalWindowRect.left, originalWindowRect.top,
+			originalWindowRect.right - originalWindowRect.left,
+			originalWindowRect.bottom - originalWindowRect.top,
+			SWP_NOSIZE | SWP_NOMOVE | SWP_FRAMECHANGED);
+	}
+
+	// Unlock the main window and restore original state
+	static void unlockMainWindow() {
+		if (!mainWindowHandle) return;
+
+		// Restore original window style
+		SetWindowLongW(mainWindowHandle, GWL_STYLE, originalWindowStyle);
+
+		// Re-enable the window
+		EnableWindow(mainWindowHandle, TRUE);
+
+		// Restore window position and size
+		if (wasMaximized)
+		{
+			ShowWindow(mainWindowHandle, SW_MAXIMIZE);
+		}
+		else
+		{
+			SetWindowPos(mainWindowHandle, HWND_NOTOPMOST,
+				originalWindowRect.left, originalWindowRect.top,
+				originalWindowRect.right - originalWindowRect.left,
+				originalWindowRect.bottom - originalWindowRect.top,
+				SWP_FRAMECHANGED);
+		}
+
+		// Bring window back to front
+		SetForegroundWindow(mainWindowHandle);
+		SetActiveWindow(mainWindowHandle);
+	}
+
+	// Suppresses message boxes on the current thread, for speculative background work whose
+	// errors are reported again if the user actually navigates there
+	class SilentScope {
+	public:
+		SilentScope() { ++silentDepth; }
+		~SilentScope() { --silentDepth; }
+	};
+
+	// Enhanced MessageBox that locks everything and stays on top
+	static int showMessageBox(const std::wstring& message, const std::wstring& title, UINT type = MB_OK | MB_ICONINFORMATION) {
+		if (silentDepth > 0)
+		{
+			return 0; // Not IDYES/IDOK, callers treat it as declined
+		}
+
+		isMessageBoxActive = true;
+
+		// Completely lock the main window
+		lockMainWindow();
+
+		int result;
+
+		// Force message box to stay on top with all possible flags
+		UINT flags = type | MB_TASKMODAL | MB_TOPMOST | MB_SETFOREGROUND | MB_SYSTEMMODAL;
+
+		if (mainWindowHandle)
+		{
+			// Show message box as modal to main window but force it to top
+			result = MessageBoxW(mainWindowHandle, message.c_str(), title.c_str(), flags);
+		}
+		else
+		{
+			// Fallback with maximum priority
+			result = MessageBoxW(NULL, message.c_str(), title.c_str(), flags);
+		}
+
+		// Unlock the main window and restore state
+		unlockMainWindow();
+
+		isMessageBoxActive = false;
+		return result;
+	}
+
+	// Convenience methods for different message types
+	static int showError(const std::wstring& message, const std::wstring& title = L"Error") {
+		return showMessageBox(message, title, MB_OK | MB_ICONERROR);
+	}
+
+	static int showWarning(const std::wstring& message, const std::wstring& title = L"Warning") {
+		return showMessageBox(message, title, MB_OK | MB_ICONWARNING);
+	}
+
+	static int showInfo(const std::wstring& message, const std::wstring& title = L"Information") {
+		return showMessageBox(message, title, MB_OK | MB_ICONINFORMATION);
+	}
+
+	static int showQuestion(const std::wstring& message, const std::wstring& title = L"Question") {
+		return showMessageBox(message, title, MB_YESNO | MB_ICONQUESTION);
+	}
+};
+#else
+// Without a window the messages go to stderr and questions count as declined
+class LockedMessageBox {
+private:
+	static inline thread_local int silentDepth = 0;
+
+	static int print(const std::wstring& message, const std::wstring& title) {
+		if (silentDepth == 0)
+		{
+			std::wcerr << title << L": " << message << L"\n";
+		}
+		return 0;
+	}
+
+public:
+	static bool isActive() {
+		return false;
+	}
+
+	class SilentScope {
+	public:
+		SilentScope() { ++silentDepth; }
+		~SilentScope() { --silentDepth; }
+	};
+
+	static int showError(const std::wstring& message, const std::wstring& title = L"Error") {
+		return print(message, title);
+	}
+
+	static int showWarning(const std::wstring& message, const std::wstring& title = L"Warning") {
+		return print(message, title);
+	}
+
+	static int showInfo(const std::wstring& message, const std::wstring& title = L"Information") {
+		return print(message, title);
+	}
+
+	static int showQuestion(const std::wstring& message, const std::wstring& title = L"Question") {
+		return print(message, title);
+	}
+};
+#endif
+
+class NavigationLockManager {
+private:
+	std::atomic<bool> isLocked;
+	std::string currentOperation;
+	std::mutex lockMutex;
+
+public:
+	NavigationLockManager() : isLocked(false), currentOperation("") { }
+
+	// Lock navigation with operation description
+	void lock(const std::string& operation = "Loading") {
+		std::lock_guard<std::mutex> guard(lockMutex);
+		isLocked = true;
+		currentOperation = operation;
+	}
+
+	// Unlock navigation
+	void unlock() {
+		std::lock_guard<std::mutex> guard(lockMutex);
+		isLocked = false;
+		currentOperation = "";
+	}
+
+	// Check if navigation is currently locked
+	bool isNavigationLocked() const {
+		return isLocked.load();
+	}
+
+	// Check if navigation is allowed (includes message box check)
+	bool isNavigationAllowed() const {
+		return !isLocked.load() && !LockedMessageBox::isActive();
+	}
+
+	// Get current operation description
+	std::string getCurrentOperation() const {
+		std::lock_guard<std::mutex> guard(const_cast<std::mutex&>(lockMutex));
+		return currentOperation;
+	}
+
+	// Force unlock (emergency use)
+	void forceUnlock() {
+		isLocked = false;
+		currentOperation = "";
+	}
+};
+
+// Unicode utility functions
+class UnicodeUtils {
+public:
+
+	static std::string trim(const std::string& str) {
+		size_t first = str.find_first_not_of(' ');
+		if (first == std::string::npos) return "";
+		size_t last = str.find_last_not_of(' ');
+		return str.substr(first, (last - first + 1));
+	}
+
+#ifdef MANGAREADER_COUNT_CONVERSIONS
+	// UTF-8/UTF-16 conversions done by this thread, so a benchmark build can see what a code path does
+	static inline thread_local size_t conversionCount = 0;
+#endif
+
+	static std::wstring stringToWstring(const std::string& str) {
+		if (str.empty()) return std::wstring();
+#ifdef MANGAREADER_COUNT_CONVERSIONS
+		conversionCount++;
+#endif
+
+#ifdef _WIN32
+		int sizeNeeded = MultiByteToWideChar(CP_UTF8, 0, str.c_str(), -1, NULL, 0);
+		if (sizeNeeded <= 0) return std::wstring();
+
+		std::wstring result(sizeNeeded - 1, 0);
+		MultiByteToWideChar(CP_UTF8, 0, str.c_str(), -1, &result[0], sizeNeeded);
+		return result;
+#else
+		// wchar_t holds a whole code point here. Like MultiByteToWideChar, each byte of a malformed
+		// sequence (bad lead or continuation byte, overlong form, surrogate, above U+10FFFF)
+		// becomes U+FFFD and decoding resumes at the next byte.
+		static constexpr uint32_t minimumForLength[] = { 0, 0, 0x80, 0x800, 0x10000 };
+		std::wstring result;
+		result.reserve(str.size());
+		for (size_t i = 0; i < str.size();)
+		{
+			unsigned char lead = static_cast<unsigned char>(str[i]);
+			int length = lead < 0x80 ? 1 : (lead >> 5) == 0x6 ? 2 : (lead >> 4) == 0xE ? 3 : (lead >> 3) == 0x1E ? 4 : 0;
+			bool valid = length != 0 && i + length <= str.size();
+
+			uint32_t codePoint = length == 1 ? lead : lead & (0x7F >> length);
+			for (int k = 1; valid && k < length; ++k)
+			{
+				unsigned char next = static_cast<unsigned char>(str[i + k]);
+				valid = (next & 0xC0) == 0x80;
+				codePoint = (codePoint << 6) | (next & 0x3F);
+			}
+			valid = valid && codePoint >= minimumForLength[length] && codePoint <= 0x10FFFF && (codePoint < 0xD800 || codePoint > 0xDFFF);
+
+			if (!valid)
+			{
+				result.push_back(static_cast<wchar_t>(0xFFFD));
+				i++;
+				continue;
+			}
+			result.push_back(static_cast<wchar_t>(codePoint));
+			i += length;
+		}
+		return result;
+#endif
+	}
+
+	static std::string wstringToString(const std::wstring& wstr) {
+		if (wstr.empty()) return std::string();
+#ifdef MANGAREADER_COUNT_CONVERSIONS
+		conversionCount++;
+#endif
+
+#ifdef _WIN32
+		int sizeNeeded = WideCharToMultiByte(CP_UTF8, 0, wstr.c_str(), -1, NULL, 0, NULL, NULL);
+		if (sizeNeeded <= 0) return std::string();
+
+		std::string result(sizeNeeded - 1, 0);
+		WideCharToMultiByte(CP_UTF8, 0, wstr.c_str(), -1, &result[0], sizeNeeded, NULL, NULL);
+		return result;
+#else
+		std::string result;
+		result.reserve(wstr.size());
+		for (wchar_t ch : wstr)
+		{
+			uint32_t codePoint = static_cast<uint32_t>(ch);
+			if ((codePoint >= 0xD800 && codePoint <= 0xDFFF) || codePoint > 0x10FFFF)
+			{
+				codePoint = 0xFFFD;
+			}
+
+			if (codePoint < 0x80)
+			{
+				result.push_back(static_cast<char>(codePoint));
+			}
+			else if (codePoint < 0x800)
+			{
+				result.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+				result.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+			}
+			else if (codePoint < 0x10000)
+			{
+				result.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+				result.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+				result.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+			}
+			else
+			{
+				result.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+				result.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+				result.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+				result.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+			}
+		}
+		return result;
+#endif
+	}
+
+	static sf::String stringToSFString(const std::string& str) {
+		std::wstring wstr = stringToWstring(str);
+		return sf::String(wstr);
+	}
+
+	// Separators are ASCII, so the UTF-8 path is split without converting it
+	static std::string getFilenameOnly(const std::string& path) {
+		size_t slash = path.find_last_of("/\\");
+		return slash == std::string::npos ? path : path.substr(slash + 1);
+	}
+};
+
+struct ArchiveEntry {
+	std::string name;
+	size_t size;
+	int index; // Index in archive
+};
+
+//TODO : L".tif", L".tiff"
+static constexpr std::array<const char*, 7u> supportedExtensions = {
+	".jpg", ".jpeg", ".png", ".bmp", ".tga", ".gif", ".webp"
+};
+
+static constexpr std::array<const char*, 8u> supportedArchives = {
+	 ".zip", ".cbz", ".rar", ".cbr", ".7z", ".cb7", ".tar", ".gz"
+};
+
+// ASCII case-insensitive extension compare, works on narrow and native wide paths without copying
+template<typename CharT>
+bool extensionEquals(std::basic_string_view<CharT> ext, const char* candidate) {
+	const size_t length = std::char_traits<char>::length(candidate);
+	if (ext.size() != length) return false;
+
+	for (size_t i = 0; i < length; ++i)
+	{
+		CharT c = ext[i];
+		if (c >= 'A' && c <= 'Z')
+		{
+			c = static_cast<CharT>(c - 'A' + 'a');
+		}
+		if (c != static_cast<CharT>(candidate[i]))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+template<typename CharT, size_t N>
+bool extensionInList(std::basic_string_view<CharT> ext, const std::array<const char*, N>& list) {
+	for (auto& supp : list)
+	{
+		if (extensionEquals(ext, supp))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+// Extension of the last path component including the dot, or empty; works on UTF-8 archive
+// entry names and wide file names alike without building a path object
+template<typename CharT>
+std::basic_string_view<CharT> getPathExtension(std::basic_string_view<CharT> path) {
+	size_t dot = path.rfind(static_cast<CharT>('.'));
+	if (dot == std::basic_string_view<CharT>::npos || dot == 0) return {};
+
+	CharT before = path[dot - 1];
+	if (before == '/' || before == '\\') return {}; // dot files have no extension
+	for (size_t i = dot + 1; i < path.size(); ++i)
+	{
+		if (path[i] == '/' || path[i] == '\\') return {};
+	}
+	return path.substr(dot);
+}
+
+// Extension checks only filter candidate entries, the decoder is picked from the file content
+bool IsImgExtValid(std::string_view ext);
+bool IsImgExtValid(std::wstring_view ext);
+bool IsArchiveExtValid(std::string_view ext);
+bool IsArchiveExtValid(std::wstring_view ext);
+
+enum class ImageFormat {
+	UNKNOWN,
+	JPEG,
+	PNG,
+	GIF,
+	BMP,
+	WEBP,
+	TGA
+};
+
+// Identifies the image format from its leading bytes, so a PNG saved as .jpg still
+// goes straight to the right decoder
+class ImageFormatDetector {
+public:
+	static constexpr size_t SNIFF_SIZE = 16;
+
+	static ImageFormat detect(const uint8_t* data, size_t size) {
+		if (!data || size < 3) return ImageFormat::UNKNOWN;
+
+		if (data[0] == 0xFF && data[1] == 0xD8 && data[2] == 0xFF)
+		{
+			return ImageFormat::JPEG;
+		}
+
+		static constexpr uint8_t pngSignature[8] = { 0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A };
+		if (size >= 8 && std::memcmp(data, pngSignature, 8) == 0)
+		{
+			return ImageFormat::PNG;
+		}
+
+		if (size >= 6 && std::memcmp(data, "GIF8", 4) == 0 && (data[4] == '7' || data[4] == '9') && data[5] == 'a')
+		{
+			return ImageFormat::GIF;
+		}
+
+		if (size >= 12 && std::memcmp(data, "RIFF", 4) == 0 && std::memcmp(data + 8, "WEBP", 4) == 0)
+		{
+			return ImageFormat::WEBP;
+		}
+
+		if (size >= 14 && data[0] == 'B' && data[1] == 'M')
+		{
+			return ImageFormat::BMP;
+		}
+
+		// TGA has no signature, accept only plausible headers
+		if (size >= 18 && isPlausibleTga(data))
+		{
+			return ImageFormat::TGA;
+		}
+
+		return ImageFormat::UNKNOWN;
+	}
+
+	static ImageFormat detect(const std::vector<uint8_t>& data) {
+		return detect(data.data(), data.size());
+	}
+
+	static const char* getFormatName(ImageFormat format) {
+		switch (format)
+		{
+		case ImageFormat::JPEG: return "JPEG";
+		case ImageFormat::PNG: return "PNG";
+		case ImageFormat::GIF: return "GIF";
+		case ImageFormat::BMP: return "BMP";
+		case ImageFormat::WEBP: return "WebP";
+		case ImageFormat::TGA: return "TGA";
+		default: return "Unknown";
+		}
+	}
+
+private:
+	static bool isPlausibleTga(const uint8_t* header) {
+		const uint8_t colorMapType = header[1];
+		const uint8_t imageType = header[2];
+		const uint8_t pixelDepth = header[16];
+
+		if (colorMapType > 1) return false;
+
+		switch (imageType)
+		{
+		case 1: case 2: case 3: case 9: case 10: case 11:
+			break;
+		default:
+			return false;
+		}
+
+		const uint16_t width = static_cast<uint16_t>(header[12] | (header[13] << 8));
+		const uint16_t height = static_cast<uint16_t>(header[14] | (header[15] << 8));
+		if (width == 0 || height == 0) return false;
+
+		return pixelDepth == 8 || pixelDepth == 15 || pixelDepth == 16 || pixelDepth == 24 || pixelDepth == 32;
+	}
+};
+
+// Physical memory as the OS reports it, for the size checks before big allocations
+struct SystemMemory {
+	static bool query(uint64_t& availableBytes, uint64_t& totalBytes) {
+#ifdef _WIN32
+		MEMORYSTATUSEX memInfo;
+		memInfo.dwLength = sizeof(MEMORYSTATUSEX);
+		if (!GlobalMemoryStatusEx(&memInfo)) return false;
+
+		availableBytes = memInfo.ullAvailPhys;
+		totalBytes = memInfo.ullTotalPhys;
+		return true;
+#else
+		long pageSize = sysconf(_SC_PAGESIZE);
+		long availablePages = sysconf(_SC_AVPHYS_PAGES);
+		long totalPages = sysconf(_SC_PHYS_PAGES);
+		if (pageSize <= 0 || availablePages < 0 || totalPages <= 0) return false;
+
+		availableBytes = static_cast<uint64_t>(availablePages) * pageSize;
+		totalBytes = static_cast<uint64_t>(totalPages) * pageSize;
+		return true;
+#endif
+	}
+};
+
+class ErrorDisplayHelper {
+public:
+	enum class ErrorType {
+		CRITICAL,
+		WARNING,
+		INFO,
+		MEMORY,
+		CORRUPTION
+	};
+
+	struct ErrorContext {
+		std::wstring archivePath;
+		std::string operation;
+		std::string details;
+		size_t memorySize = 0;
+		int entryIndex = -1;
+		std::string fileName;
+
+		ErrorContext& setArchive(const std::wstring& path) { archivePath = path; return *this; }
+		ErrorContext& setOperation(const std::string& op) { operation = op; return *this; }
+		ErrorContext& setDetails(const std::string& det) { details = det; return *this; }
+		ErrorContext& setMemorySize(size_t size) { memorySize = size; return *this; }
+		ErrorContext& setEntry(int index, const std::string& file) {
+			entryIndex = index;
+			fileName = file;
+			return *this;
+		}
+	};
+
+	static void showError(ErrorType type, const ErrorContext& context) {
+		std::wstring message;
+		std::wstring title;
+
+		switch (type)
+		{
+		case ErrorType::CRITICAL:
+			message = L"CRITICAL ARCHIVE ERROR\n\n";
+			title = L"Archive Error";
+			break;
+		case ErrorType::WARNING:
+			message = L"ARCHIVE ERROR (Skipping):\n\n";
+			title = L"Archive Skipped";
+			break;
+		case ErrorType::MEMORY:
+			message = L"MEMORY ERROR\n\n";
+			title = L"Memory Error";
+			appendMemoryInfo(message, context);
+			break;
+		case ErrorType::CORRUPTION:
+			message = L"IMAGE CORRUPTION DETECTED\n\n";
+			title = L"Image Corruption";
+			appendCorruptionInfo(message, context);
+			break;
+		}
+
+		// Common fields
+		if (!context.archivePath.empty())
+		{
+			message += L"Archive: " + context.archivePath + L"\n";
+		}
+		if (!context.operation.empty())
+		{
+			message += L"Operation: " + UnicodeUtils::stringToWstring(context.operation) + L"\n";
+		}
+		if (!context.details.empty())
+		{
+			message += L"Error: " + UnicodeUtils::stringToWstring(context.details) + L"\n\n";
+		}
+
+		// Type-specific suffixes
+		switch (type)
+		{
+		case ErrorType::CRITICAL:
+			message += L"This archive may be corrupted or incompatible.";
+			LockedMessageBox::showError(message, title);
+			break;
+		case ErrorType::WARNING:
+			message += L"This archive will be skipped and the next one will be tried.";
+			LockedMessageBox::showWarning(message, title);
+			break;
+		default:
+			LockedMessageBox::showWarning(message, title);
+			break;
+		}
+	}
+
+private:
+	static void appendMemoryInfo(std::wstring& message, const ErrorContext& context) {
+		if (context.memorySize > 0)
+		{
+			message += L"Requested Size: " + std::to_wstring(context.memorySize / 1024 / 1024) + L" MB\n\n";
+		}
+
+		uint64_t availableBytes = 0;
+		uint64_t totalBytes = 0;
+		if (SystemMemory::query(availableBytes, totalBytes))
+		{
+			message += L"Available Memory: " + std::to_wstring(availableBytes / 1024 / 1024) + L" MB\n";
+			message += L"Total Memory: " + std::to_wstring(totalBytes / 1024 / 1024) + L" MB\n\n";
+		}
+
+		message += L"The image is too large or system is low on memory.\n";
+		message += L"Try closing other applications or skip this image.";
+	}
+
+	static void appendCorruptionInfo(std::wstring& message, const ErrorContext& context) {
+		if (!context.fileName.empty())
+		{
+			message += L"Image: " + UnicodeUtils::stringToWstring(context.fileName) + L"\n";
+		}
+		if (context.entryIndex >= 0)
+		{
+			message += L"Entry Index: " + std::to_wstring(context.entryIndex) + L"\n\n";
+		}
+		message += L"This image appears to be corrupted and will be skipped.";
+	}
+};
+
+// A libjpeg(-turbo) decompressor that is created once and reset between images, so a thread
+// decoding page after page skips the allocator setup of jpeg_create_decompress. libjpeg reports
+// fatal errors through error_exit, which must not return: it jumps back into the method that
+// made the failing call, and every method that calls libjpeg sets that point up first.
+class JpegDecompressor {
+private:
+	struct ErrorManager {
+		jpeg_error_mgr base;
+		jmp_buf jump;
+	};
+
+	jpeg_decompress_struct info;
+	ErrorManager errors;
+	bool created;
+
+	static void onError(j_common_ptr common) {
+		longjmp(reinterpret_cast<ErrorManager*>(common->err)->jump, 1);
+	}
+
+	static void onMessage(j_common_ptr) {
+		// Warnings about recoverable stream damage are not worth a console line per page
+	}
+
+public:
+	JpegDecompressor() : info(), errors(), created(false) { }
+
+	JpegDecompressor(const JpegDecompressor&) = delete;
+	JpegDecompressor& operator=(const JpegDecompressor&) = delete;
+
+	~JpegDecompressor() {
+		if (created)
+		{
+			jpeg_destroy_decompress(&info);
+		}
+	}
+
+	// Reads the header and starts an RGBA decode; rows then come from readRow
+	bool start(const uint8_t* data, size_t size, sf::Vector2u& dimensions) {
+		if (setjmp(errors.jump))
+		{
+			jpeg_abort_decompress(&info);
+			return false;
+		}
+
+		if (!created)
+		{
+			info.err = jpeg_std_error(&errors.base);
+			errors.base.error_exit = onError;
+			errors.base.output_message = onMessage;
+			jpeg_create_decompress(&info);
+			created = true;
+		}
+
+		jpeg_mem_src(&info, data, static_cast<unsigned long>(size));
+		jpeg_read_header(&info, TRUE);
+		info.out_color_space = JCS_EXT_RGBA;
+		jpeg_start_decompress(&info);
+		dimensions = sf::Vector2u(info.output_width, info.output_height);
+		return dimensions.x > 0 && dimensions.y > 0;
+	}
+
+	bool readRow(uint8_t* row) {
+		if (setjmp(errors.jump))
+		{
+			jpeg_abort_decompress(&info);
+			return false;
+		}
+
+		JSAMPROW rows[1] = { row };
+		return jpeg_read_scanlines(&info, rows, 1) == 1;
+	}
+
+	// Skips the end-of-image checks; the rows that were asked for are complete either way
+	void finish() {
+		if (created)
+		{
+			jpeg_abort_decompress(&info);
+		}
+	}
+};
+
+// Reusable scratch state for decoders, one instance per thread
+struct DecoderContext {
+	std::vector<uint8_t> pixelBuffer;
+	JpegDecompressor jpeg;
+	size_t decodeCount = 0;
+
+	// Don't keep a huge page's buffer alive on an idle worker
+	static constexpr size_t MAX_RETAINED_BUFFER = 128 * 1024 * 1024;
+
+	uint8_t* acquirePixels(size_t size) {
+		if (pixelBuffer.size() < size)
+		{
+			pixelBuffer.resize(size);
+		}
+		return pixelBuffer.data();
+	}
+
+	void trim() {
+		if (pixelBuffer.capacity() > MAX_RETAINED_BUFFER)
+		{
+			pixelBuffer.clear();
+			pixelBuffer.shrink_to_fit();
+		}
+	}
+};
+
+// Whole-image resampling, bilinear or nearest neighbour. Static so the page upload workers can
+// run it without touching reader state.
+class ImageScaler {
+public:
+	static sf::Image scaleImage(const sf::Image& originalImage, sf::Vector2u newSize, bool smooth) {
+		sf::Vector2u originalSize = originalImage.getSize();
+
+		if (originalSize == newSize)
+		{
+			return originalImage;
+		}
+
+		sf::Image scaledImage(newSize);
+
+		float scaleX = static_cast<float>(originalSize.x) / static_cast<float>(newSize.x);
+		float scaleY = static_cast<float>(originalSize.y) / static_cast<float>(newSize.y);
+
+		if (smooth)
+		{
+			// Bilinear interpolation for better quality
+			for (unsigned int y = 0; y < newSize.y; ++y)
+			{
+				for (unsigned int x = 0; x < newSize.x; ++x)
+				{
+					float srcX = x * scaleX;
+					float srcY = y * scaleY;
+
+					// Get surrounding pixels
+					int x1 = static_cast<int>(srcX);
+					int y1 = static_cast<int>(srcY);
+					int x2 = std::min(x1 + 1, static_cast<int>(originalSize.x - 1));
+					int y2 = std::min(y1 + 1, static_cast<int>(originalSize.y - 1));
+
+					// Calculate interpolation weights
+					float fx = srcX - x1;
+					float fy = srcY - y1;
+
+					// Get pixel colors
+					sf::Color c11 = originalImage.getPixel(sf::Vector2u(x1, y1));
+					sf::Color c21 = originalImage.getPixel(sf::Vector2u(x2, y1));
+					sf::Color c12 = originalImage.getPixel(sf::Vector2u(x1, y2));
+					sf::Color c22 = originalImage.getPixel(sf::Vector2u(x2, y2));
+
+					// Bilinear interpolation
+					std::uint8_t r = static_cast<std::uint8_t>(
+						c11.r * (1 - fx) * (1 - fy) + c21.r * fx * (1 - fy) +
+						c12.r * (1 - fx) * fy + c22.r * fx * fy);
+					std::uint8_t g = static_cast<std::uint8_t>(
+						c11.g * (1 - fx) * (1 - fy) + c21.g * fx * (1 - fy) +
+						c12.g * (1 - fx) * fy + c22.g * fx * fy);
+					std::uint8_t b = static_cast<std::uint8_t>(
+						c11.b * (1 - fx) * (1 - fy) + c21.b * fx * (1 - fy) +
+						c12.b * (1 - fx) * fy + c22.b * fx * fy);
+					std::uint8_t a = static_cast<std::uint8_t>(
+						c11.a * (1 - fx) * (1 - fy) + c21.a * fx * (1 - fy) +
+						c12.a * (1 - fx) * fy + c22.a * fx * fy);
+
+					scaledImage.setPixel(sf::Vector2u(x, y), sf::Color(r, g, b, a));
+				}
+			}
+		}
+		else
+		{
+			// Nearest neighbor (faster but lower quality)
+			for (unsigned int y = 0; y < newSize.y; ++y)
+			{
+				for (unsigned int x = 0; x < newSize.x; ++x)
+				{
+					int srcX = static_cast<int>(x * scaleX);
+					int srcY = static_cast<int>(y * scaleY);
+
+					srcX = std::min(srcX, static_cast<int>(originalSize.x - 1));
+					srcY = std::min(srcY, static_cast<int>(originalSize.y - 1));
+
+					scaledImage.setPixel(sf::Vector2u(x, y), originalImage.getPixel(sf::Vector2u(srcX, srcY)));
+				}
+			}
+		}
+
+		return scaledImage;
+	}
+};
+
+// Cuts a page into horizontal stripes, downscaling to the target width on the way. Source rows
+// are fed top to bottom and only two of them plus the stripe being filled are held, so a decoder
+// that produces rows one at a time never needs the full-resolution page in memory.
+class ImageStripeBuilder {
+private:
+	sf::Vector2u sourceSize;
+	unsigned int targetWidth;
+	unsigned int targetHeight;
+	unsigned int stripeHeight;
+	std::vector<sf::Image>& stripes;
+
+	float scaleX;
+	float scaleY;
+	// The last two source rows, already resampled to the target width
+	std::vector<float> previousRow;
+	std::vector<float> currentRow;
+	std::vector<uint8_t> stripePixels;
+	unsigned int stripeRows;
+	unsigned int sourceRow;
+	unsigned int outputRow;
+
+	bool isPassthrough() const {
+		return targetWidth == sourceSize.x;
+	}
+
+	uint8_t* beginOutputRow() {
+		if (stripeRows == 0)
+		{
+			unsigned int rows = std::min(stripeHeight, targetHeight - outputRow);
+			stripePixels.resize(static_cast<size_t>(targetWidth) * rows * 4);
+		}
+		return stripePixels.data() + static_cast<size_t>(stripeRows) * targetWidth * 4;
+	}
+
+	void endOutputRow() {
+		++outputRow;
+		++stripeRows;
+		if (stripeRows * static_cast<size_t>(targetWidth) * 4 == stripePixels.size())
+		{
+			stripes.emplace_back(sf::Vector2u(targetWidth, stripeRows), stripePixels.data());
+			stripeRows = 0;
+		}
+	}
+
+	// Horizontal half of the bilinear filter; the vertical half mixes two of these
+	void resampleRow(const uint8_t* row, std::vector<float>& out) const {
+		out.resize(static_cast<size_t>(targetWidth) * 4);
+		for (unsigned int x = 0; x < targetWidth; ++x)
+		{
+			float srcX = x * scaleX;
+			unsigned int x1 = std::min(static_cast<unsigned int>(srcX), sourceSize.x - 1);
+			unsigned int x2 = std::min(x1 + 1, sourceSize.x - 1);
+			float fx = srcX - x1;
+
+			for (int c = 0; c < 4; ++c)
+			{
+				out[x * 4 + c] = row[x1 * 4 + c] * (1.0f - fx) + row[x2 * 4 + c] * fx;
+			}
+		}
+	}
+
+public:
+	ImageStripeBuilder(sf::Vector2u sourceSize, unsigned int targetWidth, unsigned int stripeHeight, std::vector<sf::Image>& stripes)
+		: sourceSize(sourceSize)
+		, targetWidth(targetWidth == 0 || targetWidth > sourceSize.x ? sourceSize.x : targetWidth)
+		, targetHeight(0)
+		, stripeHeight(stripeHeight)
+		, stripes(stripes)
+		, scaleX(1.0f)
+		, scaleY(1.0f)
+		, previousRow()
+		, currentRow()
+		, stripePixels()
+		, stripeRows(0)
+		, sourceRow(0)
+		, outputRow(0) {
+		const double scale = sourceSize.x > 0 ? static_cast<double>(this->targetWidth) / sourceSize.x : 0.0;
+		targetHeight = std::max(1u, static_cast<unsigned int>(std::lround(sourceSize.y * scale)));
+		if (this->targetWidth > 0)
+		{
+			scaleX = static_cast<float>(sourceSize.x) / this->targetWidth;
+			scaleY = static_cast<float>(sourceSize.y) / targetHeight;
+		}
+
+		stripes.clear();
+		if (stripeHeight > 0)
+		{
+			stripes.reserve((targetHeight + stripeHeight - 1) / stripeHeight);
+		}
+	}
+
+	bool isValid() const {
+		return sourceSize.x > 0 && sourceSize.y > 0 && stripeHeight > 0;
+	}
+
+	// Next source row, sourceSize.x RGBA pixels. Same sampling as ImageScaler::scaleImage.
+	void addRow(const uint8_t* row) {
+		if (sourceRow >= sourceSize.y) return;
+
+		if (isPassthrough())
+		{
+			std::memcpy(beginOutputRow(), row, static_cast<size_t>(targetWidth) * 4);
+			endOutputRow();
+			++sourceRow;
+			return;
+		}
+
+		std::swap(previousRow, currentRow);
+		resampleRow(row, currentRow);
+
+		// The target is never taller than the source, so an output row's two source rows are
+		// always the last two fed in by the time the lower one arrives
+		while (outputRow < targetHeight)
+		{
+			float srcY = outputRow * scaleY;
+			unsigned int y1 = std::min(static_cast<unsigned int>(srcY), sourceSize.y - 1);
+			unsigned int y2 = std::min(y1 + 1, sourceSize.y - 1);
+			if (y2 > sourceRow) break;
+
+			float fy = srcY - y1;
+			const float* top = y1 == sourceRow ? currentRow.data() : previousRow.data();
+			const float* bottom = y2 == sourceRow ? currentRow.data() : previousRow.data();
+			uint8_t* out = beginOutputRow();
+			for (size_t i = 0; i < static_cast<size_t>(targetWidth) * 4; ++i)
+			{
+				out[i] = static_cast<uint8_t>(top[i] * (1.0f - fy) + bottom[i] * fy + 0.5f);
+			}
+			endOutputRow();
+		}
+
+		++sourceRow;
+	}
+
+	// True once every stripe has been produced
+	bool finish() const {
+		return isValid() && outputRow == targetHeight;
+	}
+
+	// A page that is already fully decoded
+	static bool build(const uint8_t* pixels, sf::Vector2u sourceSize, unsigned int targetWidth, unsigned int stripeHeight, std::vector<sf::Image>& stripes) {
+		ImageStripeBuilder builder(sourceSize, targetWidth, stripeHeight, stripes);
+		if (!pixels || !builder.isValid()) return false;
+
+		const size_t stride = static_cast<size_t>(sourceSize.x) * 4;
+		for (unsigned int y = 0; y < sourceSize.y; ++y)
+		{
+			builder.addRow(pixels + y * stride);
+		}
+		return builder.finish();
+	}
+};
+
+class ImageDecoder {
+public:
+	virtual ~ImageDecoder() = default;
+
+	virtual const char* getName() const = 0;
+
+	// Cheap check on the leading bytes
+	virtual bool probe(const uint8_t* data, size_t size) const = 0;
+
+	// Read width/height from the header without decoding pixels
+	virtual bool readDimensions(const uint8_t* data, size_t size, sf::Vector2u& dimensions) const = 0;
+
+	// Decode into the target image, using the thread's context for scratch memory
+	virtual bool decode(const uint8_t* data, size_t size, DecoderContext& context, sf::Image& target) const = 0;
+
+	// Decode a page too large for one texture into stripes at most stripeHeight rows tall.
+	// The default goes through a full decode; the row-streaming backends override this
+	// so the full-resolution page never has to exist in memory.
+	virtual bool decodeStripes(const uint8_t* data, size_t size, DecoderContext& context,
+		unsigned int targetWidth, unsigned int stripeHeight, std::vector<sf::Image>& stripes) const {
+		sf::Image full;
+		if (!decode(data, size, context, full))
+		{
+			return false;
+		}
+		return ImageStripeBuilder::build(full.getPixelsPtr(), full.getSize(), targetWidth, stripeHeight, stripes);
+	}
+};
+
+class ImageHeaderReader {
+public:
+	static bool readDimensions(ImageFormat format, const uint8_t* data, size_t size, sf::Vector2u& dimensions) {
+		switch (format)
+		{
+		case ImageFormat::PNG:
+			// IHDR is always the first chunk
+			if (size < 24) return false;
+			dimensions = sf::Vector2u(readBE32(data + 16), readBE32(data + 20));
+			break;
+		case ImageFormat::GIF:
+			if (size < 10) return false;
+			dimensions = sf::Vector2u(readLE16(data + 6), readLE16(data + 8));
+			break;
+		case ImageFormat::BMP:
+			if (!readBmpDimensions(data, size, dimensions)) return false;
+			break;
+		case ImageFormat::TGA:
+			if (size < 18) return false;
+			dimensions = sf::Vector2u(readLE16(data + 12), readLE16(data + 14));
+			break;
+		case ImageFormat::JPEG:
+			if (!readJpegDimensions(data, size, dimensions)) return false;
+			break;
+		case ImageFormat::WEBP:
+		{
+			int width = 0, height = 0;
+			if (!WebPGetInfo(data, size, &width, &height)) return false;
+			dimensions = sf::Vector2u(static_cast<unsigned int>(width), static_cast<unsigned int>(height));
+			break;
+		}
+		default:
+			return false;
+		}
+
+		return dimensions.x > 0 && dimensions.y > 0;
+	}
+
+private:
+	static uint32_t readBE16(const uint8_t* p) { return (static_cast<uint32_t>(p[0]) << 8) | p[1]; }
+	static uint32_t readLE16(const uint8_t* p) { return p[0] | (static_cast<uint32_t>(p[1]) << 8); }
+	static uint32_t readBE32(const uint8_t* p) { return (readBE16(p) << 16) | readBE16(p + 2); }
+	static uint32_t readLE32(const uint8_t* p) { return readLE16(p) | (readLE16(p + 2) << 16); }
+
+	static bool readBmpDimensions(const uint8_t* data, size_t size, sf::Vector2u& dimensions) {
+		if (size < 26) return false;
+
+		uint32_t headerSize = readLE32(data + 14);
+		if (headerSize == 12)
+		{
+			// OS/2 BITMAPCOREHEADER
+			dimensions = sf::Vector2u(readLE16(data + 18), readLE16(data + 20));
+			return true;
+		}
+
+		// Height is negative for top-down bitmaps
+		int32_t width = static_cast<int32_t>(readLE32(data + 18));
+		int32_t height = static_cast<int32_t>(readLE32(data + 22));
+		if (width <= 0 || height == 0) return false;
+
+		dimensions = sf::Vector2u(static_cast<unsigned int>(width), static_cast<unsigned int>(height < 0 ? -height : height));
+		return true;
+	}
+
+	static bool isStartOfFrame(uint8_t marker) {
+		return marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC;
+	}
+
+	static bool readJpegDimensions(const uint8_t* data, size_t size, sf::Vector2u& dimensions) {
+		size_t pos = 2;
+
+		while (pos + 4 <= size)
+		{
+			if (data[pos] != 0xFF) return false;
+
+			uint8_t marker = data[pos + 1];
+			if (marker == 0xFF)
+			{
+				// Fill byte
+				++pos;
+				continue;
+			}
+			if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD8))
+			{
+				// Standalone markers without a length
+				pos += 2;
+				continue;
+			}
+
+			uint32_t segmentLength = readBE16(data + pos + 2);
+			if (segmentLength < 2) return false;
+
+			if (isStartOfFrame(marker))
+			{
+				if (pos + 9 > size) return false;
+				dimensions = sf::Vector2u(readBE16(data + pos + 7), readBE16(data + pos + 5));
+				return true;
+			}
+
+			pos += 2 + segmentLength;
+		}
+
+		return false;
+	}
+};
+
+// Formats handled by SFML's built-in stb_image backend
+class SfmlImageDecoder : public ImageDecoder {
+private:
+	ImageFormat format;
+
+public:
+	explicit SfmlImageDecoder(ImageFormat imageFormat) : format(imageFormat) { }
+
+	const char* getName() const override {
+		return ImageFormatDetector::getFormatName(format);
+	}
+
+	bool probe(const uint8_t* data, size_t size) const override {
+		return ImageFormatDetector::detect(data, size) == format;
+	}
+
+	bool readDimensions(const uint8_t* data, size_t size, sf::Vector2u& dimensions) const override {
+		return ImageHeaderReader::readDimensions(format, data, size, dimensions);
+	}
+
+	// stb_image keeps no state between images, so there is nothing in the context for it
+	bool decode(const uint8_t* data, size_t size, DecoderContext&, sf::Image& target) const override {
+		return target.loadFromMemory(data, size);
+	}
+};
+
+// sf::Image only hands out its pixels as const. The storage belongs to the non-const image the
+// decoders were given, so they write the rows straight into it instead of copying a buffer over.
+inline uint8_t* getWritablePixels(sf::Image& image, sf::Vector2u dimensions) {
+	image.resize(dimensions);
+	return const_cast<uint8_t*>(image.getPixelsPtr());
+}
+
+// JPEG through libjpeg-turbo with the thread's reusable decompressor. Streams it cannot convert
+// to RGBA (CMYK) go to stb_image instead.
+class JpegImageDecoder : public SfmlImageDecoder {
+public:
+	JpegImageDecoder() : SfmlImageDecoder(ImageFormat::JPEG) { }
+
+	bool decode(const uint8_t* data, size_t size, DecoderContext& context, sf::Image& target) const override {
+		sf::Vector2u dimensions;
+		if (!context.jpeg.start(data, size, dimensions))
+		{
+			return SfmlImageDecoder::decode(data, size, context, target);
+		}
+
+		uint8_t* pixels = getWritablePixels(target, dimensions);
+		const size_t stride = static_cast<size_t>(dimensions.x) * 4;
+		for (unsigned int y = 0; y < dimensions.y; ++y)
+		{
+			if (!context.jpeg.readRow(pixels + y * stride))
+			{
+				context.jpeg.finish();
+				return false;
+			}
+		}
+		context.jpeg.finish();
+		return true;
+	}
+
+	// Scanlines go straight into the stripe builder, one source row alive at a time
+	bool decodeStripes(const uint8_t* data, size_t size, DecoderContext& context,
+		unsigned int targetWidth, unsigned int stripeHeight, std::vector<sf::Image>& stripes) const override {
+		sf::Vector2u dimensions;
+		if (!context.jpeg.start(data, size, dimensions))
+		{
+			return ImageDecoder::decodeStripes(data, size, context, targetWidth, stripeHeight, stripes);
+		}
+
+		ImageStripeBuilder builder(dimensions, targetWidth, stripeHeight, stripes);
+		uint8_t* row = context.acquirePixels(static_cast<size_t>(dimensions.x) * 4);
+		for (unsigned int y = 0; y < dimensions.y; ++y)
+		{
+			if (!context.jpeg.readRow(row))
+			{
+				context.jpeg.finish();
+				return false;
+			}
+			builder.addRow(row);
+		}
+		context.jpeg.finish();
+		return builder.finish();
+	}
+};
+
+// Row-at-a-time PNG reading through libpng, converted to 8-bit RGBA. Like JpegDecompressor,
+// each method that calls into libpng sets up the jump point its error handler returns to.
+class PngRowReader {
+private:
+	png_structp png;
+	png_infop info;
+	const uint8_t* data;
+	size_t size;
+	size_t offset;
+
+	static void readData(png_structp png, png_bytep out, png_size_t length) {
+		PngRowReader* reader = static_cast<PngRowReader*>(png_get_io_ptr(png));
+		if (length > reader->size - reader->offset)
+		{
+			png_error(png, "Truncated PNG");
+		}
+		std::memcpy(out, reader->data + reader->offset, length);
+		reader->offset += length;
+	}
+
+	static void onError(png_structp png, png_const_charp) {
+		png_longjmp(png, 1);
+	}
+
+	static void onWarning(png_structp, png_const_charp) {
+	}
+
+public:
+	PngRowReader() : png(nullptr), info(nullptr), data(nullptr), size(0), offset(0) {
+		png = png_create_read_struct(PNG_LIBPNG_VER_STRING, this, onError, onWarning);
+		if (png)
+		{
+			info = png_create_info_struct(png);
+		}
+	}
+
+	PngRowReader(const PngRowReader&) = delete;
+	PngRowReader& operator=(const PngRowReader&) = delete;
+
+	~PngRowReader() {
+		if (png)
+		{
+			png_destroy_read_struct(&png, info ? &info : nullptr, nullptr);
+		}
+	}
+
+	// Fails for interlaced images too: their rows only come out complete after the last pass
+	bool start(const uint8_t* pngData, size_t pngSize, sf::Vector2u& dimensions) {
+		if (!png || !info) return false;
+		if (setjmp(png_jmpbuf(png)))
+		{
+			return false;
+		}
+
+		data = pngData;
+		size = pngSize;
+		offset = 0;
+		png_set_read_fn(png, this, readData);
+		png_read_info(png, info);
+
+		if (png_get_interlace_type(png, info) != PNG_INTERLACE_NONE)
+		{
+			return false;
+		}
+
+		png_byte colorType = png_get_color_type(png, info);
+		png_set_expand(png);
+		png_set_strip_16(png);
+		if (colorType == PNG_COLOR_TYPE_GRAY || colorType == PNG_COLOR_TYPE_GRAY_ALPHA)
+		{
+			png_set_gray_to_rgb(png);
+		}
+		if (!(colorType & PNG_COLOR_MASK_ALPHA) && !png_get_valid(png, info, PNG_INFO_tRNS))
+		{
+			png_set_add_alpha(png, 0xFF, PNG_FILLER_AFTER);
+		}
+		png_read_update_info(png, info);
+
+		dimensions = sf::Vector2u(png_get_image_width(png, info), png_get_image_height(png, info));
+		return dimensions.x > 0 && dimensions.y > 0 &&
+			png_get_rowbytes(png, info) == static_cast<size_t>(dimensions.x) * 4;
+	}
+
+	bool readRow(uint8_t* row) {
+		if (setjmp(png_jmpbuf(png)))
+		{
+			return false;
+		}
+		png_read_row(png, row, nullptr);
+		return true;
+	}
+};
+
+// PNG pages go through stb_image; only striped pages are read a row at a time, because that
+// is where the full-resolution buffer hurts. libpng keeps no state worth reusing between images.
+class PngImageDecoder : public SfmlImageDecoder {
+public:
+	PngImageDecoder() : SfmlImageDecoder(ImageFormat::PNG) { }
+
+	bool decodeStripes(const uint8_t* data, size_t size, DecoderContext& context,
+		unsigned int targetWidth, unsigned int stripeHeight, std::vector<sf::Image>& stripes) const override {
+		PngRowReader reader;
+		sf::Vector2u dimensions;
+		if (!reader.start(data, size, dimensions))
+		{
+			return ImageDecoder::decodeStripes(data, size, context, targetWidth, stripeHeight, stripes);
+		}
+
+		ImageStripeBuilder builder(dimensions, targetWidth, stripeHeight, stripes);
+		uint8_t* row = context.acquirePixels(static_cast<size_t>(dimensions.x) * 4);
+		for (unsigned int y = 0; y < dimensions.y; ++y)
+		{
+			if (!reader.readRow(row))
+			{
+				return false;
+			}
+			builder.addRow(row);
+		}
+		return builder.finish();
+	}
+};
+
+class WebPImageDecoder : public ImageDecoder {
+public:
+	const char* getName() const override {
+		return "WebP";
+	}
+
+	bool probe(const uint8_t* data, size_t size) const override {
+		return ImageFormatDetector::detect(data, size) == ImageFormat::WEBP;
+	}
+
+	bool readDimensions(const uint8_t* data, size_t size, sf::Vector2u& dimensions) const override {
+		return ImageHeaderReader::readDimensions(ImageFormat::WEBP, data, size, dimensions);
+	}
+
+	// Decodes straight into the image instead of a libwebp allocation that would then be copied
+	bool decode(const uint8_t* data, size_t size, DecoderContext&, sf::Image& target) const override {
+		sf::Vector2u dimensions;
+		if (!readDimensions(data, size, dimensions))
+		{
+			return false;
+		}
+
+		const size_t stride = static_cast<size_t>(dimensions.x) * 4;
+		uint8_t* pixels = getWritablePixels(target, dimensions);
+		return WebPDecodeRGBAInto(data, size, pixels, stride * dimensions.y, static_cast<int>(stride)) != nullptr;
+	}
+
+	// libwebp cannot hand out rows, but it can scale while decoding, so only the downscaled
+	// page is ever allocated before it is cut into stripes
+	bool decodeStripes(const uint8_t* data, size_t size, DecoderContext& context,
+		unsigned int targetWidth, unsigned int stripeHeight, std::vector<sf::Image>& stripes) const override {
+		sf::Vector2u dimensions;
+		if (!readDimensions(data, size, dimensions) || dimensions.x == 0)
+		{
+			return false;
+		}
+
+		if (targetWidth == 0 || targetWidth > dimensions.x)
+		{
+			targetWidth = dimensions.x;
+		}
+		const double scale = static_cast<double>(targetWidth) / dimensions.x;
+		const sf::Vector2u scaledSize(targetWidth, std::max(1u, static_cast<unsigned int>(std::lround(dimensions.y * scale))));
+
+		WebPDecoderConfig config;
+		if (!WebPInitDecoderConfig(&config))
+		{
+			return false;
+		}
+
+		const size_t stride = static_cast<size_t>(scaledSize.x) * 4;
+		const size_t bufferSize = stride * scaledSize.y;
+		config.options.use_scaling = scaledSize != dimensions;
+		config.options.scaled_width = static_cast<int>(scaledSize.x);
+		config.options.scaled_height = static_cast<int>(scaledSize.y);
+		config.output.colorspace = MODE_RGBA;
+		config.output.is_external_memory = 1;
+		config.output.u.RGBA.rgba = context.acquirePixels(bufferSize);
+		config.output.u.RGBA.stride = static_cast<int>(stride);
+		config.output.u.RGBA.size = bufferSize;
+
+		bool decoded = WebPDecode(data, size, &config) == VP8_STATUS_OK;
+		WebPFreeDecBuffer(&config.output);
+		return decoded && ImageStripeBuilder::build(config.output.u.RGBA.rgba, scaledSize, scaledSize.x, stripeHeight, stripes);
+	}
+};
+
+// Decoders are probed in registration order; new backends only need to register here
+class ImageDecoderRegistry {
+private:
+	std::vector<std::unique_ptr<ImageDecoder>> decoders;
+	mutable std::shared_mutex registryMutex;
+
+	ImageDecoderRegistry() : decoders(), registryMutex() {
+		decoders.push_back(std::make_unique<JpegImageDecoder>());
+		decoders.push_back(std::make_unique<PngImageDecoder>());
+		decoders.push_back(std::make_unique<WebPImageDecoder>());
+		decoders.push_back(std::make_unique<SfmlImageDecoder>(ImageFormat::GIF));
+		decoders.push_back(std::make_unique<SfmlImageDecoder>(ImageFormat::BMP));
+		decoders.push_back(std::make_unique<SfmlImageDecoder>(ImageFormat::TGA));
+	}
+
+public:
+	static ImageDecoderRegistry& instance() {
+		static ImageDecoderRegistry registry;
+		return registry;
+	}
+
+	// A decoder registered for an already handled format takes precedence
+	void registerDecoder(std::unique_ptr<ImageDecoder> decoder) {
+		std::unique_lock<std::shared_mutex> lock(registryMutex);
+		decoders.insert(decoders.begin(), std::move(decoder));
+	}
+
+	const ImageDecoder* findDecoder(const uint8_t* data, size_t size) const {
+		std::shared_lock<std::shared_mutex> lock(registryMutex);
+		for (const auto& decoder : decoders)
+		{
+			if (decoder->probe(data, size))
+			{
+				return decoder.get();
+			}
+		}
+		return nullptr;
+	}
+
+	static DecoderContext& getThreadContext() {
+		thread_local DecoderContext context;
+		return context;
+	}
+};
+
+class ImageLoader {
+public:
+	struct LoadResult {
+		sf::Image image;
+		std::vector<sf::Image> stripes;	// set instead of image when the page exceeds the texture limit
+		sf::Vector2u sourceSize;		// original page size, also for striped pages
+		bool success;
+		std::string errorMessage;
+
+		LoadResult() : image() , sourceSize(0, 0), success(false) { }
+		LoadResult(sf::Image img) : image(std::move(img)), sourceSize(image.getSize()), success(true) { }
+		LoadResult(std::vector<sf::Image> imageStripes, sf::Vector2u size) : image(), stripes(std::move(imageStripes)), sourceSize(size), success(true) { }
+		LoadResult(const std::string& error) : image(), sourceSize(0, 0), success(false), errorMessage(error) { }
+
+		bool isStriped() const { return !stripes.empty(); }
+	};
+
+	// Output rows per stripe texture
+	static constexpr unsigned int STRIPE_HEIGHT = 2048;
+
+	// Largest image file read into memory, the limit the WebP loader always had
+	static constexpr std::streamsize MAX_FILE_BYTES = 100 * 1024 * 1024;
+
+	// Bytes read to find the dimensions. The first read covers nearly every file; the second
+	// one is for JPEGs whose EXIF/ICC segments push the frame header further back.
+	static constexpr size_t HEADER_PROBE_BYTES = 16 * 1024;
+	static constexpr size_t HEADER_PROBE_MAX_BYTES = 256 * 1024;
+
+	// Set from the UI thread once the GL context exists; decode threads only read them
+	static void setStripeLimits(unsigned int maxTextureSize, unsigned int targetWidth) {
+		maxTextureDimension.store(maxTextureSize);
+		stripeTargetWidth.store(targetWidth);
+	}
+
+	static bool needsStripes(sf::Vector2u dimensions) {
+		unsigned int limit = maxTextureDimension.load();
+		return dimensions.x > limit || dimensions.y > limit;
+	}
+
+	// Unified image loading from file or memory
+	static LoadResult loadImage(const std::wstring& filePath) {
+		try
+		{
+			std::vector<uint8_t> buffer;
+			if (!readFileToMemory(filePath, buffer))
+			{
+				return LoadResult("Failed to read image file: " + UnicodeUtils::wstringToString(filePath));
+			}
+
+			LoadResult result = decodeFromMemory(buffer.data(), buffer.size());
+			if (!result.success)
+			{
+				result.errorMessage = "Failed to load image: " + UnicodeUtils::wstringToString(filePath);
+			}
+			return result;
+		} catch (const std::exception& e)
+		{
+			return LoadResult("Exception loading image: " + std::string(e.what()));
+		}
+	}
+
+	static LoadResult loadImageFromMemory(const std::vector<uint8_t>& data, const std::string& filename) {
+		try
+		{
+			LoadResult result = decodeFromMemory(data.data(), data.size());
+			if (!result.success)
+			{
+				result.errorMessage = "Failed to decode image data: " + filename;
+			}
+			return result;
+		} catch (const std::exception& e)
+		{
+			return LoadResult("Exception decoding image: " + std::string(e.what()));
+		}
+	}
+
+	// Dispatch on the sniffed format instead of the extension.
+	// Pages larger than the texture limit come back as downscaled stripes.
+	static LoadResult decodeFromMemory(const uint8_t* data, size_t size) {
+		const ImageDecoder* decoder = ImageDecoderRegistry::instance().findDecoder(data, size);
+		if (!decoder)
+		{
+			return LoadResult();
+		}
+
+		DecoderContext& context = ImageDecoderRegistry::getThreadContext();
+		LoadResult result;
+
+		sf::Vector2u dimensions;
+		if (decoder->readDimensions(data, size, dimensions) && needsStripes(dimensions))
+		{
+			unsigned int targetWidth = std::min(stripeTargetWidth.load(), maxTextureDimension.load());
+			std::vector<sf::Image> stripes;
+			if (decoder->decodeStripes(data, size, context, targetWidth, STRIPE_HEIGHT, stripes))
+			{
+				result = LoadResult(std::move(stripes), dimensions);
+			}
+		}
+		else
+		{
+			sf::Image image;
+			if (decoder->decode(data, size, context, image))
+			{
+				result = LoadResult(std::move(image));
+			}
+		}
+
+		context.decodeCount++;
+		context.trim();
+		return result;
+	}
+
+	// Header-only size lookup, no pixel decode
+	static sf::Vector2u readDimensions(const uint8_t* data, size_t size) {
+		const ImageDecoder* decoder = ImageDecoderRegistry::instance().findDecoder(data, size);
+		sf::Vector2u dimensions(0, 0);
+		if (!decoder || !decoder->readDimensions(data, size, dimensions))
+		{
+			return sf::Vector2u(0, 0);
+		}
+		return dimensions;
+	}
+
+	static sf::Vector2u readFileDimensions(const std::wstring& filePath) {
+		std::vector<uint8_t> buffer;
+		for (size_t probeBytes : { HEADER_PROBE_BYTES, HEADER_PROBE_MAX_BYTES })
+		{
+			if (!readFilePrefix(filePath, probeBytes, buffer))
+			{
+				break;
+			}
+
+			sf::Vector2u dimensions = readDimensions(buffer.data(), buffer.size());
+			if ((dimensions.x > 0 && dimensions.y > 0) || buffer.size() < probeBytes)
+			{
+				return dimensions; // Found, or the whole file was read
+			}
+		}
+		return sf::Vector2u(0, 0);
+	}
+
+	// Up to maxBytes from the start of the file
+	static bool readFilePrefix(const std::wstring& filePath, size_t maxBytes, std::vector<uint8_t>& buffer) {
+		std::ifstream file(std::filesystem::path(filePath), std::ios::binary);
+		if (!file.is_open())
+		{
+			return false;
+		}
+
+		buffer.resize(maxBytes);
+		file.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(maxBytes));
+		buffer.resize(static_cast<size_t>(file.gcount()));
+		return !buffer.empty();
+	}
+
+	static bool readFileToMemory(const std::wstring& filePath, std::vector<uint8_t>& buffer, std::streamsize sizeLimit = MAX_FILE_BYTES) {
+		std::ifstream file(std::filesystem::path(filePath), std::ios::binary | std::ios::ate);
+		if (!file.is_open())
+		{
+			return false;
+		}
+
+		std::streamsize size = file.tellg();
+		if (size <= 0 || size >= sizeLimit)
+		{
+			return false;
+		}
+
+		file.seekg(0, std::ios::beg);
+		buffer.resize(static_cast<size_t>(size));
+		if (!file.read(reinterpret_cast<char*>(buffer.data()), size) || file.gcount() != size)
+		{
+			buffer.clear();
+			return false;
+		}
+
+		return true;
+	}
+
+private:
+	static std::atomic<unsigned int> maxTextureDimension;
+	static std::atomic<unsigned int> stripeTargetWidth;
+};
+
+class NavigationHelper {
+public:
+	static bool canNavigate(const NavigationLockManager& navLock) {
+		return navLock.isNavigationAllowed() && !LockedMessageBox::isActive();
+	}
+
+	static bool executeIfNavigationAllowed(const NavigationLockManager& navLock,
+		const std::function<void()>& action) {
+		if (canNavigate(navLock))
+		{
+			action();
+			return true;
+		}
+		return false;
+	}
+};
+
+// Natural ordering ("page2" before "page10") through keys computed once per name. A digit run
+// becomes a marker, its significant length and the digits, ASCII letters are case folded and
+// path separators sort first, so comparing two keys is a plain string compare.
+struct NaturalSort {
+	template<typename CharT>
+	static std::basic_string<CharT> makeKey(std::basic_string_view<CharT> name) {
+		std::basic_string<CharT> key;
+		key.reserve(name.size() + 4);
+
+		for (size_t i = 0; i < name.size();)
+		{
+			CharT c = name[i];
+			if (c >= '0' && c <= '9')
+			{
+				size_t start = i;
+				while (i < name.size() && name[i] >= '0' && name[i] <= '9') ++i;
+				while (start + 1 < i && name[start] == '0') ++start; // "007" and "7" compare equal
+
+				key += static_cast<CharT>(1);
+				key += static_cast<CharT>(std::min<size_t>(i - start, 0x7F));
+				key.append(name.substr(start, i - start));
+				continue;
+			}
+
+			if (c == '/' || c == '\\')
+			{
+				c = static_cast<CharT>(2);
+			}
+			else if (c >= 'A' && c <= 'Z')
+			{
+				c = static_cast<CharT>(c - 'A' + 'a');
+			}
+			key += c;
+			++i;
+		}
+		return key;
+	}
+
+	template<typename CharT>
+	static std::basic_string<CharT> makeKey(const std::basic_string<CharT>& name) {
+		return makeKey(std::basic_string_view<CharT>(name));
+	}
+
+	// Sorts items by makeItemKey(item), computing each key once; equal keys keep their order
+	template<typename T, typename KeyFunction>
+	static void sort(std::vector<T>& items, KeyFunction makeItemKey) {
+		using Key = decltype(makeItemKey(items.front()));
+		std::vector<std::pair<Key, size_t>> keys;
+		keys.reserve(items.size());
+		for (size_t i = 0; i < items.size(); ++i)
+		{
+			keys.emplace_back(makeItemKey(items[i]), i);
+		}
+		std::sort(keys.begin(), keys.end());
+
+		std::vector<T> sorted;
+		sorted.reserve(items.size());
+		for (auto& [key, index] : keys)
+		{
+			sorted.push_back(std::move(items[index]));
+		}
+		items = std::move(sorted);
+	}
+};
+
+// Lists a directory through FindFirstFileExW. The basic info level skips the 8.3 name, large
+// fetch asks for bigger batches, and the attributes that come with each entry tell files from
+// folders, so there is no stat and no path object per entry. Only reparse points (symlinks,
+// junctions) are resolved with a stat, since their attributes describe the link. Elsewhere it
+// falls back to directory_iterator, whose entries carry the type readdir already reported.
+class DirectoryEnumerator {
+public:
+	enum class EntryType {
+		FILE,
+		DIRECTORY,
+		OTHER
+	};
+
+	// Calls visit(name, type) for every entry but . and ..; the name is only valid during the call
+	template<typename Visitor>
+	static std::error_code forEach(const std::wstring& dir, Visitor&& visit) {
+#ifdef _WIN32
+		std::wstring pattern = dir;
+		if (!pattern.empty() && pattern.back() != L'\\' && pattern.back() != L'/')
+		{
+			pattern += L'\\';
+		}
+		pattern += L'*';
+
+		WIN32_FIND_DATAW data;
+		HANDLE find = FindFirstFileExW(pattern.c_str(), FindExInfoBasic, &data, FindExSearchNameMatch, nullptr, FIND_FIRST_EX_LARGE_FETCH);
+		if (find == INVALID_HANDLE_VALUE)
+		{
+			DWORD error = GetLastError();
+			// An empty drive root has no . entry to return
+			return error == ERROR_FILE_NOT_FOUND ? std::error_code() : std::error_code(static_cast<int>(error), std::system_category());
+		}
+
+		do
+		{
+			std::wstring_view name(data.cFileName);
+			if (name == L"." || name == L"..") continue;
+
+			visit(name, getType(dir, name, data.dwFileAttributes));
+		} while (FindNextFileW(find, &data));
+
+		DWORD error = GetLastError();
+		FindClose(find);
+		return error == ERROR_NO_MORE_FILES ? std::error_code() : std::error_code(static_cast<int>(error), std::system_category());
+#else
+		std::error_code ec;
+		std::filesystem::directory_iterator it(dir, ec);
+		for (; !ec && it != std::filesystem::directory_iterator(); it.increment(ec))
+		{
+			std::error_code typeError;
+			EntryType type = it->is_directory(typeError) ? EntryType::DIRECTORY :
+				it->is_regular_file(typeError) ? EntryType::FILE : EntryType::OTHER;
+			std::wstring name = it->path().filename().wstring();
+			visit(std::wstring_view(name), type);
+		}
+		return ec;
+#endif
+	}
+
+	static std::wstring joinPath(const std::wstring& dir, std::wstring_view name) {
+		std::wstring path;
+		path.reserve(dir.size() + 1 + name.size());
+		path += dir;
+		if (!path.empty() && path.back() != L'\\' && path.back() != L'/')
+		{
+			path += static_cast<wchar_t>(std::filesystem::path::preferred_separator);
+		}
+		path += name;
+		return path;
+	}
+
+	static std::wstring_view getExtension(std::wstring_view name) {
+		return getPathExtension(name);
+	}
+
+private:
+#ifdef _WIN32
+	static EntryType getType(const std::wstring& dir, std::wstring_view name, DWORD attributes) {
+		if (attributes & FILE_ATTRIBUTE_REPARSE_POINT)
+		{
+			std::error_code ec;
+			auto status = std::filesystem::status(joinPath(dir, name), ec);
+			if (ec) return EntryType::OTHER;
+			if (std::filesystem::is_directory(status)) return EntryType::DIRECTORY;
+			return std::filesystem::is_regular_file(status) ? EntryType::FILE : EntryType::OTHER;
+		}
+
+		return (attributes & FILE_ATTRIBUTE_DIRECTORY) ? EntryType::DIRECTORY : EntryType::FILE;
+	}
+#endif
+};
+
+// The pages of one source: the folder or archive path is stored once, page names sit back to
+// back in a UTF-8 pool and each page costs a 32-bit offset. Folder pages are file names inside
+// the folder, archive pages are entry paths inside the archive (as libarchive reports them).
+// Folder pages also keep the name as it was listed, so opening a file needs no conversion and
+// names that aren't valid UTF-16 (unpaired surrogates) still open.
+class PageList {
+private:
+	std::wstring sourcePath;
+	bool archive;
+	std::string pool;
+	std::vector<uint32_t> offsets;      // Page i is pool[offsets[i], offsets[i + 1])
+	std::wstring listedPool;            // Folder pages only, indexed by listedOffsets
+	std::vector<uint32_t> listedOffsets;
+
+public:
+	PageList() : sourcePath(), archive(false), pool(), offsets(), listedPool(), listedOffsets() { }
+
+	void reset(const std::wstring& source, bool isArchive) {
+		sourcePath = source;
+		archive = isArchive;
+		pool.clear();
+		offsets.assign(1, 0);
+		listedPool.clear();
+		listedOffsets.assign(1, 0);
+	}
+
+	void clear() {
+		reset(L"", false);
+	}
+
+	void add(std::string_view name) {
+		if (offsets.empty()) offsets.push_back(0);
+		pool.append(name);
+		offsets.push_back(static_cast<uint32_t>(pool.size()));
+	}
+
+	// A folder page: the UTF-8 name for display and the name the directory listing gave
+	void add(std::string_view name, std::wstring_view listedName) {
+		add(name);
+		if (listedOffsets.empty()) listedOffsets.push_back(0);
+		listedPool.append(listedName);
+		listedOffsets.push_back(static_cast<uint32_t>(listedPool.size()));
+	}
+
+	size_t size() const {
+		return offsets.empty() ? 0 : offsets.size() - 1;
+	}
+
+	bool empty() const {
+		return size() == 0;
+	}
+
+	bool isArchive() const {
+		return archive;
+	}
+
+	const std::wstring& getSourcePath() const {
+		return sourcePath;
+	}
+
+	// UTF-8 name of the page: file name, or entry path inside the archive
+	std::string_view getName(size_t index) const {
+		return std::string_view(pool).substr(offsets[index], offsets[index + 1] - offsets[index]);
+	}
+
+	// Last path component of the name
+	std::string_view getFileName(size_t index) const {
+		std::string_view name = getName(index);
+		size_t slash = name.find_last_of("/\\");
+		return slash == std::string_view::npos ? name : name.substr(slash + 1);
+	}
+
+	// Path of a folder page for the OS; archive pages give "archive#entry" for messages only
+	std::wstring getFullPath(size_t index) const {
+		if (archive)
+		{
+			return sourcePath + L"#" + UnicodeUtils::stringToWstring(std::string(getName(index)));
+		}
+		if (index + 1 >= listedOffsets.size())
+		{
+			return DirectoryEnumerator::joinPath(sourcePath, UnicodeUtils::stringToWstring(std::string(getName(index))));
+		}
+		std::wstring_view name = std::wstring_view(listedPool).substr(listedOffsets[index], listedOffsets[index + 1] - listedOffsets[index]);
+		return DirectoryEnumerator::joinPath(sourcePath, name);
+	}
+
+	size_t getMemoryBytes() const {
+		return (sourcePath.capacity() + listedPool.capacity()) * sizeof(wchar_t) + pool.capacity() +
+			(offsets.capacity() + listedOffsets.capacity()) * sizeof(uint32_t);
+	}
+};
+
+class FileSystemHelper {
+public:
+	static std::string getFileSizeString(size_t fileSize) {
+		if (fileSize < 1024)
+		{
+			return std::to_string(fileSize) + " B";
+		}
+		else if (fileSize < 1024 * 1024)
+		{
+			return std::to_string(fileSize / 1024) + " KB";
+		}
+		else
+		{
+			return std::to_string(fileSize / (1024 * 1024)) + " MB";
+		}
+	}
+
+	static std::string getFileSizeString(const std::wstring& filePath) {
+		try
+		{
+			auto fileSize = std::filesystem::file_size(filePath);
+			return getFileSizeString(static_cast<size_t>(fileSize));
+		} catch (...)
+		{
+			return "Unknown";
+		}
+	}
+
+	// Image files directly inside a folder, naturally sorted; throws std::filesystem::filesystem_error
+	static PageList listImageFiles(const std::wstring& folderPath) {
+		std::vector<std::wstring> names;
+		std::error_code ec = DirectoryEnumerator::forEach(folderPath, [&](std::wstring_view name, DirectoryEnumerator::EntryType type) {
+			if (type == DirectoryEnumerator::EntryType::FILE && IsImgExtValid(DirectoryEnumerator::getExtension(name)))
+			{
+				names.emplace_back(name);
+			}
+			});
+		if (ec)
+		{
+			throw std::filesystem::filesystem_error("Cannot list folder", std::filesystem::path(folderPath), ec);
+		}
+
+		NaturalSort::sort(names, [](const std::wstring& name) { return NaturalSort::makeKey(name); });
+
+		PageList pages;
+		pages.reset(folderPath, false);
+		for (const auto& name : names)
+		{
+			pages.add(UnicodeUtils::wstringToString(name), name);
+		}
+		return pages;
+	}
+
+	static PageList listArchivePages(const std::wstring& archivePath, const std::vector<ArchiveEntry>& entries) {
+		PageList pages;
+		pages.reset(archivePath, true);
+		for (const auto& entry : entries)
+		{
+			pages.add(entry.name);
+		}
+		return pages;
+	}
+};
+
+#ifdef _WIN32
+struct PathLimitChecker {
+
+	static bool isRunningAsAdmin() {
+		BOOL isAdmin = FALSE;
+		HANDLE hToken = NULL;
+
+		if (OpenProcessToken(GetCurrentProcess(), TOKEN_QUERY, &hToken))
+		{
+			TOKEN_ELEVATION elevation;
+			DWORD cbSize = sizeof(TOKEN_ELEVATION);
+
+			if (GetTokenInformation(hToken, TokenElevation, &elevation, sizeof(elevation), &cbSize))
+			{
+				isAdmin = elevation.TokenIsElevated;
+			}
+			CloseHandle(hToken);
+		}
+
+		return isAdmin == TRUE;
+	}
+
+	static bool enableLongPathSupport() {
+		if (!isRunningAsAdmin())
+		{
+			return false; // Need admin privileges
+		}
+
+		HKEY hKey;
+		LONG result = RegOpenKeyExW(
+			HKEY_LOCAL_MACHINE,
+			L"SYSTEM\\CurrentControlSet\\Control\\FileSystem",
+			0,
+			KEY_SET_VALUE,
+			&hKey
+		);
+
+		if (result == ERROR_SUCCESS)
+		{
+			DWORD value = 1;
+			result = RegSetValueExW(
+				hKey,
+				L"LongPathsEnabled",
+				0,
+				REG_DWORD,
+				reinterpret_cast<const BYTE*>(&value),
+				sizeof(DWORD)
+			);
+
+			RegCloseKey(hKey);
+			return (result == ERROR_SUCCESS);
+		}
+
+		return false;
+	}
+
+	static bool isLongPathSupportEnabled() {
+		HKEY hKey;
+		DWORD dwValue = 0;
+		DWORD dwSize = sizeof(DWORD);
+
+		// Open the registry key
+		LONG result = RegOpenKeyExW(
+			HKEY_LOCAL_MACHINE,
+			L"SYSTEM\\CurrentControlSet\\Control\\FileSystem",
+			0,
+			KEY_READ,
+			&hKey
+		);
+
+		if (result == ERROR_SUCCESS)
+		{
+			// Query the LongPathsEnabled value
+			result = RegQueryValueExW(
+				hKey,
+				L"LongPathsEnabled",
+				nullptr,
+				nullptr,
+				reinterpret_cast<LPBYTE>(&dwValue),
+				&dwSize
+			);
+
+			RegCloseKey(hKey);
+
+			if (result == ERROR_SUCCESS)
+			{
+				return (dwValue == 1);
+			}
+		}
+
+		return false; // Default to disabled if can't read
+	}
+
+	static void showPathLimitInfo() {
+		bool longPathsEnabled = PathLimitChecker::isLongPathSupportEnabled();
+		bool isAdmin = PathLimitChecker::getIsRunningAsAdmin();
+
+		std::wstring message = L"PATH LENGTH INFORMATION:\n\n";
+		message += L"Current Path Limit: " + std::to_wstring(PathLimitChecker::getMaxPathLength()) + L" characters\n";
+		message += L"Long Path Support: " + std::wstring(longPathsEnabled ? L"ENABLED" : L"DISABLED") + L"\n";
+		message += L"Running as Administrator: " + std::wstring(isAdmin ? L"YES" : L"NO") + L"\n\n";
+
+		if (!longPathsEnabled)
+		{
+			if (isAdmin)
+			{
+				message += L"Long path support can be enabled automatically.\n";
+				message += L"Click 'YES' to enable it now, or 'NO' for manual instructions.";
+
+				int result = LockedMessageBox::showQuestion(message, L"Enable Long Path Support?");
+
+				if (result == IDYES)
+				{
+					if (PathLimitChecker::tryEnableLongPaths())
+					{
+						LockedMessageBox::showInfo(
+							L"Long path support has been enabled successfully!\n\n"
+							L"Note: You may need to restart the application for changes to take full effect.",
+							L"Success"
+						);
+					}
+					else
+					{
+						LockedMessageBox::showError(
+							L"Failed to enable long path support.\n"
+							L"Please enable it manually using the instructions below.",
+							L"Enable Failed"
+						);
+						showManualInstructions();
+					}
+				}
+				else
+				{
+					showManualInstructions();
+				}
+			}
+			else
+			{
+				message += L"To enable long path support, administrator privileges are required.\n";
+				message += L"Click 'YES' to restart as administrator, or 'NO' for manual instructions.";
+
+				int result = LockedMessageBox::showQuestion(message, L"Restart as Administrator?");
+
+				if (result == IDYES)
+				{
+					if (PathLimitChecker::restartAsAdmin())
+					{
+						// Application will restart with elevation
+						std::exit(0);
+					}
+					else
+					{
+						LockedMessageBox::showError(
+							L"Failed to restart with administrator privileges.\n"
+							L"Please run the application as administrator manually.",
+							L"Elevation Failed"
+						);
+					}
+				}
+				else
+				{
+					showManualInstructions();
+				}
+			}
+		}
+		else
+		{
+			LockedMessageBox::showInfo(message, L"Path Length Settings");
+		}
+	}
+
+	static void showManualInstructions() {
+		std::wstring message = L"MANUAL SETUP INSTRUCTIONS:\n\n";
+		message += L"Method 1 - Group Policy Editor:\n";
+		message += L"1. Press Win+R, type 'gpedit.msc', press Enter\n";
+		message += L"2. Navigate to: Computer Configuration > Administrative Templates > System > Filesystem\n";
+		message += L"3. Double-click 'Enable NTFS long paths'\n";
+		message += L"4. Select 'Enabled', click OK\n";
+		message += L"5. Restart this application\n\n";
+
+		message += L"Method 2 - Registry Editor:\n";
+		message += L"1. Press Win+R, type 'regedit', press Enter\n";
+		message += L"2. Navigate to: HKEY_LOCAL_MACHINE\\SYSTEM\\CurrentControlSet\\Control\\FileSystem\n";
+		message += L"3. Create or modify DWORD: LongPathsEnabled\n";
+		message += L"4. Set value to: 1\n";
+		message += L"5. Restart this application\n\n";
+
+		message += L"Method 3 - Command Line (Run as Administrator):\n";
+		message += L"reg add \"HKLM\\SYSTEM\\CurrentControlSet\\Control\\FileSystem\" /v LongPathsEnabled /t REG_DWORD /d 1";
+
+		LockedMessageBox::showInfo(message, L"Manual Setup Instructions");
+	}
+
+	static size_t getMaxComponentLength() {
+		// Component length limit doesn't change
+		return 255;
+	}
+
+	static size_t getMaxPathLength() {
+		if (isLongPathSupportEnabled())
+		{
+			return 32767;
+		}
+		else
+		{
+			return 260;
+		}
+	}
+
+	static size_t getSafePathLength() {
+		size_t maxPath = getMaxPathLength();
+		return maxPath > 260 ? maxPath - 50 : 240;
+	}
+
+	// Try to enable long path support
+	static bool tryEnableLongPaths() {
+		if (isLongPathSupportEnabled())
+		{
+			return true; // Already enabled
+		}
+
+		if (isRunningAsAdmin())
+		{
+			return enableLongPathSupport();
+		}
+
+		return false; // Need elevation
+	}
+
+	// Restart application with admin privileges
+	static bool restartAsAdmin() {
+		wchar_t exePath[MAX_PATH];
+		GetModuleFileNameW(NULL, exePath, MAX_PATH);
+
+		// Preserve current command line arguments and add --enable-long-paths
+		std::wstring params = L"--enable-long-paths";
+
+		// Add other relevant arguments if needed
+		// You could store original argc/argv to reconstruct them here
+
+		SHELLEXECUTEINFOW sei = {};
+		sei.cbSize = sizeof(SHELLEXECUTEINFOW);
+		sei.lpVerb = L"runas";
+		sei.lpFile = exePath;
+		sei.lpParameters = params.c_str();
+		sei.nShow = SW_NORMAL;
+		sei.fMask = SEE_MASK_NOCLOSEPROCESS;
+
+		return ShellExecuteExW(&sei) == TRUE;
+	}
+
+	static bool getIsRunningAsAdmin() {
+		return isRunningAsAdmin();
+	}
+
+
+	static void handleEnableLongPaths() {
+
+		if (PathLimitChecker::isLongPathSupportEnabled())
+		{
+			LockedMessageBox::showInfo(
+				L"Long path support is already enabled.\n"
+				L"Maximum path length: " + std::to_wstring(PathLimitChecker::getMaxPathLength()) + L" characters",
+				L"Already Enabled"
+			);
+			return;
+		}
+
+		if (!PathLimitChecker::getIsRunningAsAdmin())
+		{
+			LockedMessageBox::showError(
+				L"Administrator privileges required to enable long path support.\n"
+				L"Please run the application as administrator with --enable-long-paths flag.",
+				L"Admin Required"
+			);
+			return;
+		}
+
+		if (PathLimitChecker::tryEnableLongPaths())
+		{
+			LockedMessageBox::showInfo(
+				L"Long path support has been enabled successfully!\n\n"
+				L"New maximum path length: " + std::to_wstring(PathLimitChecker::getMaxPathLength()) + L" characters\n"
+				L"The application will now start with long path support.",
+				L"Long Paths Enabled"
+			);
+		}
+		else
+		{
+			LockedMessageBox::showError(
+				L"Failed to enable long path support.\n"
+				L"Please try enabling it manually through Group Policy or Registry Editor.",
+				L"Enable Failed"
+			);
+		}
+	}
+
+	static void showPathInfoConsole() {
+		// For console output (useful for command line usage)
+		std::wcout << L"Path Length Information:\n";
+		std::wcout << L"Current Limit: " << PathLimitChecker::getMaxPathLength() << L" characters\n";
+		std::wcout << L"Long Path Support: " << (PathLimitChecker::isLongPathSupportEnabled() ? L"ENABLED" : L"DISABLED") << L"\n";
+		std::wcout << L"Running as Admin: " << (PathLimitChecker::getIsRunningAsAdmin() ? L"YES" : L"NO") << L"\n";
+
+		if (!PathLimitChecker::isLongPathSupportEnabled())
+		{
+			std::wcout << L"\nTo enable long path support, run with administrator privileges:\n";
+			std::wcout << L"manga_reader.exe --enable-long-paths\n";
+		}
+	}
+
+};
+#else
+// Only the limits the archive checks use; POSIX paths have no registry switch to flip
+struct PathLimitChecker {
+	static size_t getMaxComponentLength() {
+		return 255;
+	}
+
+	static size_t getMaxPathLength() {
+		return 4096;
+	}
+
+	static size_t getSafePathLength() {
+		return getMaxPathLength() - 50;
+	}
+};
+#endif
+
+class ArchiveHandler {
+private:
+	struct archive* archive;
+	std::string archivePath;
+	std::wstring archivePathW;
+	std::vector<ArchiveEntry> imageEntries;
+	std::vector<std::vector<uint8_t>> cachedImages; // Cache extracted images
+	bool isArchiveOpen;  // Add state tracking
+	std::mutex archiveMutex;
+	std::set<int> corruptedEntries;
+
+public:
+	ArchiveHandler() : archive(nullptr), archivePath(), archivePathW(), imageEntries(), cachedImages(), isArchiveOpen(false), archiveMutex(), corruptedEntries() { }
+
+	~ArchiveHandler() {
+		closeArchive();
+	}
+
+	bool openArchive(const std::wstring& path) {
+		std::lock_guard<std::mutex> lock(archiveMutex);
+
+		archivePathW = path;
+
+		// Run compatibility test first - if fails, return false to skip
+		if (!testArchiveCompatibility())
+		{
+			return false; // This will cause the caller to skip to next archive
+		}
+
+		try
+		{
+			// Always close existing archive first
+			closeArchiveInternal();
+
+			archivePath = UnicodeUtils::wstringToString(path);
+
+			// Check if file exists and is readable
+			if (!std::filesystem::exists(path))
+			{
+				ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
+					ErrorDisplayHelper::ErrorContext()
+					.setArchive(archivePathW)
+					.setOperation("File Check")
+					.setDetails("Archive file does not exist: " + archivePath));
+				return false;
+			}
+
+			// Check file size
+			auto fileSize = std::filesystem::file_size(path);
+			if (fileSize == 0)
+			{
+				ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
+					ErrorDisplayHelper::ErrorContext()
+					.setArchive(archivePathW)
+					.setOperation("File Check")
+					.setDetails("Archive file is empty"));
+				return false;
+			}
+
+			archive = archive_read_new();
+			if (!archive)
+			{
+				ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
+					ErrorDisplayHelper::ErrorContext()
+					.setArchive(archivePathW)
+					.setOperation("Archive Creation")
+					.setDetails("Failed to create archive object"));
+				return false;
+			}
+
+			// Enable all supported formats and filters
+			archive_read_support_filter_all(archive);
+			archive_read_support_format_all(archive);
+			archive_read_set_option(archive, NULL, "hdrcharset", "UTF-8");
+
+			std::string ext = std::string(getPathExtension(std::string_view(archivePath)));
+			std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+
+			// Format-specific optimizations
+			if (ext == ".rar" || ext == ".cbr")
+			{
+				archive_read_set_option(archive, "rar", "hdrcharset", "UTF-8");
+				archive_read_set_option(archive, "rar", "pwdfile", NULL);
+			}
+			else if (ext == ".7z" || ext == ".cb7")
+			{
+				archive_read_set_option(archive, "7zip", "hdrcharset", "UTF-8");
+			}
+			else if (ext == ".tar" || ext == ".gz")
+			{
+				archive_read_set_option(archive, "tar", "hdrcharset", "UTF-8");
+			}
+
+			int result = archive_read_open_filename_w(archive, path.c_str(), 10240);
+			if (result != ARCHIVE_OK)
+			{
+				std::string errorMsg = "Failed to open archive";
+				if (archive_error_string(archive))
+				{
+					errorMsg += "\nLibarchive error: " + std::string(archive_error_string(archive));
+				}
+				ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
+					ErrorDisplayHelper::ErrorContext()
+					.setArchive(archivePathW)
+					.setOperation("Archive Opening")
+					.setDetails(errorMsg));
+				closeArchiveInternal();
+				return false;
+			}
+
+			isArchiveOpen = true;
+
+			if (!loadImageEntries())
+			{
+				closeArchiveInternal();
+				return false;
+			}
+
+			return true;
+
+		} catch (const std::filesystem::filesystem_error& e)
+		{
+			ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
+				ErrorDisplayHelper::ErrorContext()
+				.setArchive(archivePathW)
+				.setOperation("Filesystem Error")
+				.setDetails(e.what()));
+			closeArchiveInternal();
+			return false;
+		} catch (const std::exception& e)
+		{
+			ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
+				ErrorDisplayHelper::ErrorContext()
+				.setArchive(archivePathW)
+				.setOperation("Exception in openArchive")
+				.setDetails(e.what()));
+			closeArchiveInternal();
+			return false;
+		} catch (...)
+		{
+			ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
+				ErrorDisplayHelper::ErrorContext()
+				.setArchive(archivePathW)
+				.setOperation("Unknown Exception")
+				.setDetails("Unknown exception occurred in openArchive"));
+			closeArchiveInternal();
+			return false;
+		}
+	}
+
+	void closeArchive() {
+		std::lock_guard<std::mutex> lock(archiveMutex);
+		closeArchiveInternal();
+	}
+
+	bool hasKnownIssues() const {
+		return !corruptedEntries.empty();
+	}
+
+	std::string getCorruptionReport() const {
+		if (corruptedEntries.empty()) return "";
+
+		std::string report = "Corrupted entries in " + archivePath + ":\n";
+		for (int index : corruptedEntries)
+		{
+			if (index < imageEntries.size())
+			{
+				report += "- Entry " + std::to_string(index) + ": " + imageEntries[index].name + "\n";
+			}
+		}
+		return report;
+	}
+
+	const std::vector<ArchiveEntry>& getImageEntries() const {
+		return imageEntries;
+	}
+
+	const bool getIsArchiveOpen() const {
+		return isArchiveOpen;
+	}
+
+	// Exchanges the open archive, entries and cache with another handler, used to adopt an
+	// archive the folder prefetcher already opened
+	void swapWith(ArchiveHandler& other) {
+		if (&other == this) return;
+
+		std::scoped_lock lock(archiveMutex, other.archiveMutex);
+		std::swap(archive, other.archive);
+		std::swap(archivePath, other.archivePath);
+		std::swap(archivePathW, other.archivePathW);
+		std::swap(imageEntries, other.imageEntries);
+		std::swap(cachedImages, other.cachedImages);
+		std::swap(isArchiveOpen, other.isArchiveOpen);
+		std::swap(corruptedEntries, other.corruptedEntries);
+	}
+
+	void clearCache(int index = -1) {
+		std::lock_guard<std::mutex> lock(archiveMutex);
+		try
+		{
+			if (index >= 0 && index < static_cast<int>(cachedImages.size()))
+			{
+				cachedImages[index].clear();
+				cachedImages[index].shrink_to_fit();
+			}
+			else if (index == -1)
+			{
+				for (auto& cache : cachedImages)
+				{
+					cache.clear();
+					cache.shrink_to_fit();
+				}
+				cachedImages.clear();
+			}
+		} catch (const std::exception& e)
+		{
+			ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
+				ErrorDisplayHelper::ErrorContext()
+				.setArchive(archivePathW)
+				.setOperation("clearCache")
+				.setDetails(e.what()));
+		}
+	}
+
+	// Extracts an entry into the cache for a later page turn without copying it out. The read is
+	// speculative, so a failure shows nothing and is not remembered as corruption; the page turn
+	// that needs the entry reads it again and reports it then.
+	bool prefetchEntry(int entryIndex) {
+		std::lock_guard<std::mutex> lock(archiveMutex);
+		if (!isArchiveOpen || entryIndex < 0 || entryIndex >= imageEntries.size()) return false;
+		if (corruptedEntries.find(entryIndex) != corruptedEntries.end()) return false;
+		if (entryIndex < cachedImages.size() && !cachedImages[entryIndex].empty()) return true;
+
+		LockedMessageBox::SilentScope silent;
+		try
+		{
+			return extractAndCacheImageInternal(entryIndex);
+		} catch (...)
+		{
+			return false;
+		}
+	}
+
+	bool isCached(int index) {
+		std::lock_guard<std::mutex> lock(archiveMutex);
+		return index >= 0 && index < static_cast<int>(cachedImages.size()) && !cachedImages[index].empty();
+	}
+
+	size_t getCacheBytes() {
+		std::lock_guard<std::mutex> lock(archiveMutex);
+		size_t total = 0;
+		for (const auto& cache : cachedImages)
+		{
+			total += cache.size();
+		}
+		return total;
+	}
+
+	std::vector<int> getCachedIndices() {
+		std::lock_guard<std::mutex> lock(archiveMutex);
+		std::vector<int> indices;
+		for (int i = 0; i < static_cast<int>(cachedImages.size()); ++i)
+		{
+			if (!cachedImages[i].empty()) indices.push_back(i);
+		}
+		return indices;
+	}
+
+	bool extractImageToMemory(int entryIndex, std::vector<uint8_t>& buffer) {
+		std::lock_guard<std::mutex> lock(archiveMutex);
+
+		try
+		{
+			if (!isArchiveOpen || entryIndex < 0 || entryIndex >= imageEntries.size())
+			{
+				std::string error = "Invalid extraction parameters. Index: " + std::to_string(entryIndex) +
+					", Archive open: " + (isArchiveOpen ? "true" : "false") +
+					", Entries: " + std::to_string(imageEntries.size());
+				ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
+					ErrorDisplayHelper::ErrorContext()
+					.setArchive(archivePathW)
+					.setOperation("Parameter Validation")
+					.setDetails(error));
+				return false;
+			}
+
+			// Check if this entry was previously marked as corrupted
+			if (corruptedEntries.find(entryIndex) != corruptedEntries.end())
+			{
+				std::wstring message = L"Skipping previously corrupted image:\n\n";
+				message += L"Entry: " + std::to_wstring(entryIndex) + L"\n";
+				message += L"File: " + UnicodeUtils::stringToWstring(imageEntries[entryIndex].name);
+
+				LockedMessageBox::showError(message, L"Corrupted Image Skipped");
+				return false;
+			}
+
+			// Check if image is already cached
+			if (entryIndex < cachedImages.size() && !cachedImages[entryIndex].empty())
+			{
+				buffer = cachedImages[entryIndex];
+				return true;
+			}
+
+			// Extract using the main archive instance with error checking
+			if (!extractAndCacheImageInternal(entryIndex))
+			{
+				corruptedEntries.insert(entryIndex); // Mark as corrupted
+				ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CORRUPTION,
+					ErrorDisplayHelper::ErrorContext()
+					.setArchive(archivePathW)
+					.setEntry(entryIndex, imageEntries[entryIndex].name));
+				return false;
+			}
+
+			// Return cached data
+			if (entryIndex < cachedImages.size() && !cachedImages[entryIndex].empty())
+			{
+				buffer = cachedImages[entryIndex];
+				return true;
+			}
+
+			ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
+				ErrorDisplayHelper::ErrorContext()
+				.setArchive(archivePathW)
+				.setOperation("Cache Error")
+				.setDetails("Cache is empty after successful extraction for entry: " + std::to_string(entryIndex)));
+			return false;
+
+		} catch (const std::bad_alloc& e)
+		{
+			corruptedEntries.insert(entryIndex);
+			ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::MEMORY,
+				ErrorDisplayHelper::ErrorContext()
+				.setArchive(archivePathW)
+				.setOperation("extractImageToMemory")
+				.setMemorySize(0));
+			return false;
+		} catch (const std::exception& e)
+		{
+			corruptedEntries.insert(entryIndex);
+			ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
+				ErrorDisplayHelper::ErrorContext()
+				.setArchive(archivePathW)
+				.setOperation("extractImageToMemory Exception")
+				.setDetails("Entry: " + std::to_string(entryIndex) + " - " + e.what()));
+			return false;
+		} catch (...)
+		{
+			corruptedEntries.insert(entryIndex);
+			ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
+				ErrorDisplayHelper::ErrorContext()
+				.setArchive(archivePathW)
+				.setOperation("extractImageToMemory Unknown Exception")
+				.setDetails("Unknown exception for entry: " + std::to_string(entryIndex)));
+			return false;
+		}
+	}
+
+	// The first maxBytes of an entry that is already extracted; false when it is not cached
+	bool readCachedPrefix(int entryIndex, size_t maxBytes, std::vector<uint8_t>& buffer) {
+		std::lock_guard<std::mutex> lock(archiveMutex);
+		if (!isArchiveOpen || entryIndex < 0 || entryIndex >= imageEntries.size()) return false;
+		if (entryIndex >= cachedImages.size() || cachedImages[entryIndex].empty()) return false;
+
+		const auto& cached = cachedImages[entryIndex];
+		buffer.assign(cached.begin(), cached.begin() + std::min(maxBytes, cached.size()));
+		return true;
+	}
+
+	// The first maxBytes of an entry, for reading its header. Uses a handle of its own so the
+	// extraction handle keeps its position, and inflates no more of the entry than asked for.
+	// The header walk can decompress every earlier entry of a solid archive, so it runs without
+	// archiveMutex and extraction on other threads goes on meanwhile.
+	bool readEntryPrefix(int entryIndex, size_t maxBytes, std::vector<uint8_t>& buffer) {
+		if (readCachedPrefix(entryIndex, maxBytes, buffer)) return true;
+
+		std::wstring path;
+		int wantedImage = 0;
+		{
+			std::lock_guard<std::mutex> lock(archiveMutex);
+			if (!isArchiveOpen || entryIndex < 0 || entryIndex >= imageEntries.size()) return false;
+			path = archivePathW;
+			wantedImage = imageEntries[entryIndex].index;
+		}
+
+		struct archive* reader = archive_read_new();
+		if (!reader) return false;
+
+		archive_read_support_filter_all(reader);
+		archive_read_support_format_all(reader);
+		archive_read_set_option(reader, NULL, "hdrcharset", "UTF-8");
+
+		bool found = false;
+		if (archive_read_open_filename_w(reader, path.c_str(), 10240) == ARCHIVE_OK)
+		{
+			// Same image numbering as extractAndCacheImageInternal
+			struct archive_entry* entry;
+			int imageCount = 0;
+			while (archive_read_next_header(reader, &entry) == ARCHIVE_OK)
+			{
+				const char* pathname = archive_entry_pathname(entry);
+				la_int64_t size = archive_entry_size(entry);
+				if (archive_entry_filetype(entry) != AE_IFREG || !pathname || size <= 0 ||
+					!IsImgExtValid(getPathExtension(std::string_view(pathname))))
+				{
+					continue;
+				}
+				if (imageCount++ != wantedImage)
+				{
+					continue;
+				}
+
+				buffer.resize(std::min(maxBytes, static_cast<size_t>(size)));
+				la_ssize_t bytesRead = archive_read_data(reader, buffer.data(), buffer.size());
+				found = bytesRead > 0;
+				buffer.resize(found ? static_cast<size_t>(bytesRead) : 0);
+				break;
+			}
+		}
+
+		archive_read_free(reader);
+		return found;
+	}
+
+	bool isSafeToAllocate(size_t requestedSize) {
+		const size_t MAX_SINGLE_ALLOCATION = 200 * 1024 * 1024; // 200MB max per image
+		const size_t MIN_FREE_MEMORY = 500 * 1024 * 1024; // Keep 500MB free
+
+		if (requestedSize > MAX_SINGLE_ALLOCATION)
+		{
+			ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::MEMORY,
+				ErrorDisplayHelper::ErrorContext()
+				.setArchive(archivePathW)
+				.setOperation("Size Check")
+				.setMemorySize(requestedSize));
+			return false;
+		}
+
+		uint64_t availableBytes = 0;
+		uint64_t totalBytes = 0;
+		if (SystemMemory::query(availableBytes, totalBytes))
+		{
+			if (availableBytes < (requestedSize + MIN_FREE_MEMORY))
+			{
+				ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::MEMORY,
+					ErrorDisplayHelper::ErrorContext()
+					.setArchive(archivePathW)
+					.setOperation("Memory Check")
+					.setMemorySize(requestedSize));
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	std::vector<uint8_t> safeAllocateVector(size_t size) {
+		if (!isSafeToAllocate(size))
+		{
+			throw std::bad_alloc();
+		}
+
+		try
+		{
+			return std::vector<uint8_t>(size);
+		} catch (const std::bad_alloc& e)
+		{
+			ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
+				ErrorDisplayHelper::ErrorContext()
+				.setArchive(archivePathW)
+				.setOperation("Vector Allocation")
+				.setDetails(e.what()));
+			throw;
+		}
+	}
+
+private:
+
+	bool loadImageEntries() {
+		try
+		{
+			imageEntries.clear();
+
+			if (!archive || !isArchiveOpen) return false;
+
+			struct archive_entry* entry;
+			int index = 0;
+			int totalEntries = 0;
+			int maxFolderDepth = 0;
+			size_t maxPathLength = 0;
+
+			while (archive_read_next_header(archive, &entry) == ARCHIVE_OK)
+			{
+				totalEntries++;
+
+				// Get entry info
+				const char* pathname = archive_entry_pathname(entry);
+				la_int64_t entry_type = archive_entry_filetype(entry);
+				la_int64_t entry_size = archive_entry_size(entry);
+
+				// Skip directories
+				if (entry_type == AE_IFDIR)
+				{
+					archive_read_data_skip(archive);
+					continue;
+				}
+
+				// Skip non-regular files
+				if (entry_type != AE_IFREG)
+				{
+					archive_read_data_skip(archive);
+					continue;
+				}
+
+				// Handle pathname
+				std::string currentPath;
+				if (!pathname)
+				{
+					currentPath = "unknown_" + std::to_string(index);
+				}
+				else
+				{
+					currentPath = std::string(pathname);
+				}
+
+				// Normalize path
+				std::replace(currentPath.begin(), currentPath.end(), '\\', '/');
+
+				// Calculate folder depth and path length
+				int folderDepth = std::count(currentPath.begin(), currentPath.end(), '/');
+				maxFolderDepth = std::max(maxFolderDepth, folderDepth);
+				maxPathLength = std::max(maxPathLength, currentPath.length());
+
+				// Check if it's an image file
+				if (IsImgExtValid(getPathExtension(std::string_view(currentPath))) && entry_size > 0)
+				{
+					ArchiveEntry archiveEntryStruct;
+					archiveEntryStruct.name = currentPath;
+					archiveEntryStruct.size = static_cast<size_t>(entry_size);
+					archiveEntryStruct.index = index++;
+
+					imageEntries.push_back(archiveEntryStruct);
+				}
+
+				archive_read_data_skip(archive);
+			}
+
+			// Check if the internal structure is too complex
+			const int MAX_FOLDER_DEPTH = 5;
+			const size_t MAX_INTERNAL_PATH = 150;
+
+			if (maxFolderDepth > MAX_FOLDER_DEPTH || maxPathLength > MAX_INTERNAL_PATH)
+			{
+				std::wstring message = L"ARCHIVE SKIPPED - COMPLEX STRUCTURE:\n\n";
+				message += L"Max folder depth: " + std::to_wstring(maxFolderDepth) + L" (limit: " + std::to_wstring(MAX_FOLDER_DEPTH) + L")\n";
+				message += L"Max internal path: " + std::to_wstring(maxPathLength) + L" chars (limit: " + std::to_wstring(MAX_INTERNAL_PATH) + L")\n";
+				message += L"Images found: " + std::to_wstring(imageEntries.size()) + L"\n\n";
+				message += L"Moving to next archive...";
+
+				LockedMessageBox::showError(message, L"Archive Skipped - Complex Structure");
+				return false;
+			}
+
+			// Pages follow the natural order of the entry names; index keeps the position in the
+			// archive, which is what extraction matches on
+			NaturalSort::sort(imageEntries, [](const ArchiveEntry& entry) {
+				return NaturalSort::makeKey(entry.name);
+				});
+
+			if (imageEntries.empty())
+			{
+				std::wstring message = L"No images found in archive.\n";
+				message += L"Moving to next archive...";
+				LockedMessageBox::showError(message, L"No Images Found");
+				return false;
+			}
+
+			return true;
+
+		} catch (const std::exception& e)
+		{
+			ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
+				ErrorDisplayHelper::ErrorContext()
+				.setArchive(archivePathW)
+				.setOperation("loadImageEntries Exception")
+				.setDetails(e.what()));
+			return false;
+		} catch (...)
+		{
+			ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
+				ErrorDisplayHelper::ErrorContext()
+				.setArchive(archivePathW)
+				.setOperation("loadImageEntries")
+				.setDetails("Unknown exception occurred"));
+			return false;
+		}
+	}
+
+	void closeArchiveInternal() {
+		if (archive)
+		{
+			archive_read_free(archive);
+			archive = nullptr;
+		}
+		isArchiveOpen = false;
+		archivePath.clear();
+		imageEntries.clear();
+		cachedImages.clear();
+		corruptedEntries.clear();
+	}
+
+	bool testArchiveCompatibility() {
+		std::string archiveName = UnicodeUtils::wstringToString(archivePathW);
+
+		std::filesystem::path archivePath(archiveName);
+		std::string archiveFilename = archivePath.filename().string();
+		std::string archiveDir = archivePath.parent_path().string();
+
+		size_t archivePathLength = archiveName.length();
+		size_t basePathLength = archiveDir.length();
+
+		// Dynamic limits based on system configuration
+		const size_t MAX_TOTAL_PATH = PathLimitChecker::getSafePathLength();
+		const size_t MAX_SINGLE_COMPONENT = PathLimitChecker::getMaxComponentLength();
+		const size_t MAX_ESTIMATED_INTERNAL_PATH = 120; // Keep this as estimate
+
+		bool pathTooLong = false;
+		bool componentTooLong = false;
+		bool estimatedOverflow = false;
+
+		// Check if archive path is already too long
+		if (archivePathLength > MAX_TOTAL_PATH)
+		{
+			pathTooLong = true;
+		}
+
+		// Check if archive filename itself is too long
+		if (archiveFilename.length() > MAX_SINGLE_COMPONENT)
+		{
+			componentTooLong = true;
+		}
+
+		// Estimate if internal paths might cause overflow
+		size_t estimatedMaxPath = basePathLength + archiveFilename.length() + MAX_ESTIMATED_INTERNAL_PATH;
+		if (estimatedMaxPath > MAX_TOTAL_PATH)
+		{
+			estimatedOverflow = true;
+		}
+
+		if (pathTooLong || componentTooLong || estimatedOverflow)
+		{
+			std::wstring message = L"ARCHIVE SKIPPED - PATH LENGTH ISSUE:\n\n";
+			message += L"Archive: " + UnicodeUtils::stringToWstring(archiveFilename) + L"\n\n";
+			message += L"System Path Limit: " + std::to_wstring(PathLimitChecker::getMaxPathLength()) + L" chars\n";
+			message += L"Long Path Support: " + std::wstring(PathLimitChecker::getMaxPathLength() > 260 ? L"ENABLED" : L"DISABLED") + L"\n\n";
+
+			if (pathTooLong)
+			{
+				message += L"• Archive path too long: " + std::to_wstring(archivePathLength) +
+					L" chars (max " + std::to_wstring(MAX_TOTAL_PATH) + L")\n";
+			}
+			if (componentTooLong)
+			{
+				message += L"• Archive filename too long: " + std::to_wstring(archiveFilename.length()) +
+					L" chars (max " + std::to_wstring(MAX_SINGLE_COMPONENT) + L")\n";
+			}
+			if (estimatedOverflow)
+			{
+				message += L"• Estimated total path would exceed limit\n";
+			}
+
+			LockedMessageBox::showError(message, L"Archive Skipped - Path Too Long");
+			return false;
+		}
+
+		return true;
+	}
+
+	bool extractAndCacheImageInternal(int targetIndex) {
+		try
+		{
+			if (!archive || targetIndex < 0 || targetIndex >= imageEntries.size())
+			{
+				return false;
+			}
+
+			// Ensure cache is properly sized
+			if (cachedImages.size() < imageEntries.size())
+			{
+				cachedImages.resize(imageEntries.size());
+			}
+
+			// If already cached, return success
+			if (!cachedImages[targetIndex].empty())
+			{
+				return true;
+			}
+
+			// Reopen the archive to reset position
+			// Close current archive
+			if (archive)
+			{
+				archive_read_free(archive);
+				archive = nullptr;
+			}
+
+			// Reopen archive with error checking
+			archive = archive_read_new();
+			if (!archive)
+			{
+				isArchiveOpen = false;
+				ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
+					ErrorDisplayHelper::ErrorContext()
+					.setArchive(archivePathW)
+					.setOperation("Archive Reopen")
+					.setDetails("Failed to create new archive object for extraction"));
+				return false;
+			}
+
+			archive_read_support_filter_all(archive);
+			archive_read_support_format_all(archive);
+			archive_read_set_option(archive, NULL, "hdrcharset", "UTF-8");
+
+			if (archive_read_open_filename_w(archive, archivePathW.c_str(), 10240) != ARCHIVE_OK)
+			{
+				std::string errorMsg = "Failed to reopen archive for extraction";
+				if (archive_error_string(archive))
+				{
+					errorMsg += ": " + std::string(archive_error_string(archive));
+				}
+				ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
+					ErrorDisplayHelper::ErrorContext()
+					.setArchive(archivePathW)
+					.setOperation("Archive Reopen")
+					.setDetails(errorMsg));
+				archive_read_free(archive);
+				archive = nullptr;
+				isArchiveOpen = false;
+				return false;
+			}
+
+			struct archive_entry* entry;
+			bool found = false;
+			int imageCount = 0; // Count only image files
+			std::vector<std::string> foundPaths; // Debug: the first few images seen
+
+			// Extract by position - much simpler and more reliable
+			while (archive_read_next_header(archive, &entry) == ARCHIVE_OK)
+			{
+				const char* pathname = archive_entry_pathname(entry);
+
+				// Get entry info
+				la_int64_t entry_type = archive_entry_filetype(entry);
+				la_int64_t size = archive_entry_size(entry);
+
+				// Skip directories
+				if (entry_type == AE_IFDIR)
+				{
+					archive_read_data_skip(archive);
+					continue;
+				}
+
+				// Skip non-regular files
+				if (entry_type != AE_IFREG)
+				{
+					archive_read_data_skip(archive);
+					continue;
+				}
+
+				// Skipped entries are only looked at through a view; a copy is made for messages
+				std::string_view entryPath = pathname ? std::string_view(pathname) : std::string_view();
+
+				if (IsImgExtValid(getPathExtension(entryPath)) && size > 0)
+				{
+					if (foundPaths.size() < 5)
+					{
+						foundPaths.emplace_back(entryPath);
+					}
+
+					// Is this our target image? (by position in the archive's image sequence)
+					if (imageCount == imageEntries[targetIndex].index)
+					{
+						const std::string currentPath(entryPath);
+
+						// This is our target image - extract it
+						if (size > 500 * 1024 * 1024)
+						{
+							ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::MEMORY,
+								ErrorDisplayHelper::ErrorContext()
+								.setArchive(archivePathW)
+								.setOperation("Image Too Large")
+								.setMemorySize(static_cast<size_t>(size)));
+							break;
+						}
+
+						try
+						{
+							cachedImages[targetIndex] = safeAllocateVector(static_cast<size_t>(size));
+
+							la_ssize_t bytesRead = archive_read_data(archive,
+								cachedImages[targetIndex].data(), cachedImages[targetIndex].size());
+
+							if (bytesRead == size)
+							{
+								found = true;
+
+								// Success message with debug info
+								//std::wstring successMsg = L"EXTRACTION SUCCESS!\n\n";
+								//successMsg += L"Target index: " + std::to_wstring(targetIndex) + L"\n";
+								//successMsg += L"Image count: " + std::to_wstring(imageCount) + L"\n";
+								//successMsg += L"Path found: " + UnicodeUtils::stringToWstring(currentPath) + L"\n";
+								//successMsg += L"Size: " + std::to_wstring(size) + L" bytes\n";
+								//successMsg += L"Bytes read: " + std::to_wstring(bytesRead);
+
+								//MessageBoxW(NULL, successMsg.c_str(), L"Extraction Success", MB_OK | MB_ICONINFORMATION);
+
+							}
+							else if (bytesRead < 0)
+							{
+								std::string error = "Archive read error for: " + currentPath;
+								if (archive_error_string(archive))
+								{
+									error += " - " + std::string(archive_error_string(archive));
+								}
+								ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
+									ErrorDisplayHelper::ErrorContext()
+									.setArchive(archivePathW)
+									.setOperation("Archive Read Error")
+									.setDetails(error));
+								cachedImages[targetIndex].clear();
+							}
+							else
+							{
+								std::string error = "Partial read for: " + currentPath +
+									". Expected: " + std::to_string(size) +
+									", Got: " + std::to_string(bytesRead);
+								ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
+									ErrorDisplayHelper::ErrorContext()
+									.setArchive(archivePathW)
+									.setOperation("Partial Read")
+									.setDetails(error));
+								cachedImages[targetIndex].clear();
+							}
+						} catch (const std::bad_alloc& e)
+						{
+							ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::MEMORY,
+								ErrorDisplayHelper::ErrorContext()
+								.setArchive(archivePathW)
+								.setOperation("Allocation Failed")
+								.setMemorySize(static_cast<size_t>(size)));
+							cachedImages[targetIndex].clear();
+							found = false;
+						}
+						break; // Found our target, stop here
+					}
+
+					imageCount++; // Count this as an image
+				}
+
+				// Skip the data for this entry
+				archive_read_data_skip(archive);
+			}
+
+			if (!found)
+			{
+				// Show debug info about what was found
+				std::wstring message = L"EXTRACTION FAILED - DEBUG INFO:\n\n";
+				message += L"Target index: " + std::to_wstring(targetIndex) + L"\n";
+				message += L"Total images found during extraction: " + std::to_wstring(imageCount) + L"\n";
+				message += L"Target path from loadImageEntries: " + UnicodeUtils::stringToWstring(imageEntries[targetIndex].name) + L"\n\n";
+
+				message += L"Images found during extraction:\n";
+				for (int i = 0; i < std::min(5, (int)foundPaths.size()); i++)
+				{
+					message += L"[" + std::to_wstring(i) + L"] " + UnicodeUtils::stringToWstring(foundPaths[i]) + L"\n";
+				}
+				if (imageCount > 5)
+				{
+					message += L"... and " + std::to_wstring(imageCount - 5) + L" more\n";
+				}
+
+				LockedMessageBox::showError(message, L"Extraction Debug");
+			}
+
+			return found;
+
+		} catch (const std::exception& e)
+		{
+			ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
+				ErrorDisplayHelper::ErrorContext()
+				.setArchive(archivePathW)
+				.setOperation("extractAndCacheImageInternal Exception")
+				.setDetails(e.what()));
+			return false;
+		} catch (...)
+		{
+			ErrorDisplayHelper::showError(ErrorDisplayHelper::ErrorType::CRITICAL,
+				ErrorDisplayHelper::ErrorContext()
+				.setArchive(archivePathW)
+				.setOperation("extractAndCacheImageInternal")
+				.setDetails("Unknown exception occurred"));
+			return false;
+		}
+	}
+};
+
+// Ties background work to the folder it was queued for. A folder switch advances the
+// generation and every task holding an older token stops at its next check.
+class CancellationToken {
+private:
+	const std::atomic<uint64_t>* generation;
+	uint64_t issuedAt;
+
+public:
+	CancellationToken() : generation(nullptr), issuedAt(0) { }
+	explicit CancellationToken(const std::atomic<uint64_t>& source) : generation(&source), issuedAt(source.load()) { }
+
+	bool isCancelled() const {
+		return generation && generation->load() != issuedAt;
+	}
+};
+
+class FolderGeneration {
+private:
+	std::atomic<uint64_t> value;
+
+public:
+	FolderGeneration() : value(0) { }
+
+	CancellationToken token() const {
+		return CancellationToken(value);
+	}
+
+	void advance() {
+		value++;
+	}
+};
+
+class ImageLoadingDispatcher {
+public:
+	struct LoadContext {
+		bool isArchive;
+		ArchiveHandler* archiveHandler;
+		const PageList* currentImages;
+		int imageIndex;
+		CancellationToken cancel;
+
+		LoadContext(bool archive, ArchiveHandler* handler,
+			const PageList* images, int index, CancellationToken token = CancellationToken())
+			: isArchive(archive), archiveHandler(handler),
+			currentImages(images), imageIndex(index), cancel(token) { }
+	};
+
+	static ImageLoader::LoadResult loadImageAtIndex(const LoadContext& context) {
+		if (!context.currentImages || context.imageIndex < 0 ||
+			context.imageIndex >= context.currentImages->size())
+		{
+			return ImageLoader::LoadResult("Invalid image index");
+		}
+
+		if (context.cancel.isCancelled())
+		{
+			return ImageLoader::LoadResult("Cancelled");
+		}
+
+		if (context.isArchive && context.archiveHandler)
+		{
+			return loadFromArchive(context);
+		}
+		else
+		{
+			return loadFromFile(context);
+		}
+	}
+
+	// Reads only the image header; falls back to a full decode for headers we can't parse
+	static sf::Vector2u getImageDimensionsAtIndex(const LoadContext& context) {
+		if (!context.currentImages || context.imageIndex < 0 ||
+			context.imageIndex >= context.currentImages->size())
+		{
+			return sf::Vector2u(0, 0);
+		}
+
+		sf::Vector2u dimensions(0, 0);
+		if (context.isArchive && context.archiveHandler)
+		{
+			std::vector<uint8_t> header;
+			if (context.archiveHandler->readEntryPrefix(context.imageIndex, ImageLoader::HEADER_PROBE_MAX_BYTES, header))
+			{
+				dimensions = ImageLoader::readDimensions(header.data(), header.size());
+			}
+		}
+		else
+		{
+			dimensions = ImageLoader::readFileDimensions(context.currentImages->getFullPath(context.imageIndex));
+		}
+
+		if (dimensions.x > 0 && dimensions.y > 0)
+		{
+			return dimensions;
+		}
+
+		ImageLoader::LoadResult result = loadImageAtIndex(context);
+		if (result.success)
+		{
+			return result.sourceSize;
+		}
+		return sf::Vector2u(0, 0);
+	}
+
+private:
+	static ImageLoader::LoadResult loadFromArchive(const LoadContext& context) {
+		std::vector<uint8_t> rawData;
+		if (context.archiveHandler->extractImageToMemory(context.imageIndex, rawData))
+		{
+			// Extraction can be slow on solid archives; don't decode for a folder that is gone
+			if (context.cancel.isCancelled())
+			{
+				return ImageLoader::LoadResult("Cancelled");
+			}
+
+			return ImageLoader::loadImageFromMemory(rawData, std::string(context.currentImages->getFileName(context.imageIndex)));
+		}
+		return ImageLoader::LoadResult("Failed to extract from archive");
+	}
+
+	static ImageLoader::LoadResult loadFromFile(const LoadContext& context) {
+		return ImageLoader::loadImage(context.currentImages->getFullPath(context.imageIndex));
+	}
+};
+
+struct FoldersIdent {
+	std::wstring dir;
+	bool isArchieve;
+	std::wstring sortKey;             // Natural order key of dir, computed once
+
+	FoldersIdent(std::wstring path, bool isArchive)
+		: dir(std::move(path)), isArchieve(isArchive), sortKey(NaturalSort::makeKey(dir)) { }
+
+	bool operator<(const FoldersIdent& other) const {
+		int order = sortKey.compare(other.sortKey);
+		return order != 0 ? order < 0 : dir < other.dir;
+	}
+};
+
+// Runs file writes on a background thread. request() replaces a write that is still waiting,
+// and the thread waits until no further request came in for the debounce window, so a burst
+// of changes ends up as one write of the latest state. Writes are ordered: one overtaken by a
+// newer write (writeNow on the caller's thread) is skipped instead of replacing it on disk.
+class DebouncedWriter {
+public:
+	using Write = std::function<bool()>;	// Returns whether the file was written
+
+private:
+	std::chrono::milliseconds debounce;
+	std::mutex writerMutex;             // Guards the pending write and the thread state
+	std::condition_variable writerWake;
+	std::future<void> writer;
+	Write pendingWrite;
+	uint64_t pendingGeneration;
+	uint64_t nextGeneration;
+	uint64_t writtenGeneration;         // Guarded by fileMutex
+	bool stopWriter;
+	std::chrono::steady_clock::time_point writeDue;
+	std::mutex fileMutex;               // One write of the file at a time
+	std::atomic<size_t> requests;
+	std::atomic<size_t> writes;
+
+public:
+	explicit DebouncedWriter(std::chrono::milliseconds debounceTime) : debounce(debounceTime), writerMutex(), writerWake(), writer(), pendingWrite(),
+		pendingGeneration(0), nextGeneration(0), writtenGeneration(0), stopWriter(false), writeDue(), fileMutex(), requests(0), writes(0) { }
+
+	~DebouncedWriter() {
+		stop();
+	}
+
+	void request(Write write) {
+		requests++;
+		{
+			std::lock_guard<std::mutex> lock(writerMutex);
+			pendingWrite = std::move(write);
+			pendingGeneration = ++nextGeneration;
+			writeDue = std::chrono::steady_clock::now() + debounce;
+
+			if (!writer.valid())
+			{
+				stopWriter = false;
+				writer = std::async(std::launch::async, [this]() { writerLoop(); });
+			}
+		}
+		writerWake.notify_all();
+	}
+
+	// Runs write on the calling thread once a write in progress is done; a pending one is dropped
+	bool writeNow(const Write& write) {
+		uint64_t generation;
+		{
+			std::lock_guard<std::mutex> lock(writerMutex);
+			pendingWrite = nullptr; // Superseded by this write
+			generation = ++nextGeneration;
+		}
+		return run(write, generation);
+	}
+
+	// Stops the thread; a pending write is dropped, the owner writes its final state with writeNow
+	void stop() {
+		{
+			std::lock_guard<std::mutex> lock(writerMutex);
+			stopWriter = true;
+			pendingWrite = nullptr;
+		}
+		writerWake.notify_all();
+		if (writer.valid())
+		{
+			writer.wait();
+			writer = std::future<void>();
+		}
+	}
+
+	size_t getRequestCount() const { return requests.load(); }
+	size_t getWriteCount() const { return writes.load(); }
+
+private:
+	void writerLoop() {
+		std::unique_lock<std::mutex> lock(writerMutex);
+		while (true)
+		{
+			writerWake.wait(lock, [this]() { return stopWriter || pendingWrite; });
+			if (stopWriter) break;
+
+			// Every request moves writeDue, so this returns once the changes have settled
+			while (!stopWriter && pendingWrite && std::chrono::steady_clock::now() < writeDue)
+			{
+				writerWake.wait_until(lock, writeDue);
+			}
+			if (stopWriter) break;
+			if (!pendingWrite) continue;
+
+			Write write = std::move(pendingWrite);
+			uint64_t generation = pendingGeneration;
+			pendingWrite = nullptr;
+
+			lock.unlock();
+			run(write, generation);
+			lock.lock();
+		}
+	}
+
+	bool run(const Write& write, uint64_t generation) {
+		std::lock_guard<std::mutex> lock(fileMutex);
+		if (generation < writtenGeneration) return true; // A newer state is already on disk
+		if (!write()) return false;
+
+		writtenGeneration = generation;
+		writes++;
+		return true;
+	}
+};
+
+// What the last library scan saw, persisted next to the config file so the next start can show
+// the library immediately and only list directories whose mtime changed. A directory's mtime
+// moves when entries are added, removed or renamed in it, so an unchanged directory keeps its
+// recorded subdirectories and archives; each of those subdirectories is still checked itself.
+// Sources also remember their size, mtime, page count and first-page dimensions once opened.
+// requestSave writes a copy on a DebouncedWriter; switching indexes and the destructor save
+// synchronously.
+class LibraryIndex {
+public:
+	struct DirectoryRecord {
+		int64_t mtime = -1;
+		bool hasImages = false;
+		std::vector<std::wstring> subdirectories;
+		std::vector<std::wstring> archives;
+	};
+
+	struct SourceRecord {
+		bool isArchive = false;
+		uint64_t size = 0;
+		int64_t mtime = -1;
+		int pageCount = 0;
+		sf::Vector2u firstPageSize;
+	};
+
+	using DirectoryMap = std::unordered_map<std::wstring, DirectoryRecord>;
+	using SourceMap = std::unordered_map<std::wstring, SourceRecord>;
+
+private:
+	std::wstring indexPath;
+	std::wstring root;
+	DirectoryMap directories;           // Only replaced between scans; workers read it during one
+	SourceMap sources;
+	uint64_t changeCount;               // Bumped by every change
+	uint64_t requestedChange;           // changeCount of the last background save requested
+	std::atomic<uint64_t> savedChange;  // changeCount of the state on disk, set by the write that put it there
+	DebouncedWriter writer;
+
+	static constexpr const char* INDEX_HEADER = "; Manga Reader Library Index v1";
+	static constexpr int SAVE_DEBOUNCE_MS = 500;
+
+public:
+	LibraryIndex() : indexPath(), root(), directories(), sources(), changeCount(0), requestedChange(0), savedChange(0),
+		writer(std::chrono::milliseconds(SAVE_DEBOUNCE_MS)) { }
+
+	// A background save that is still waiting or failed leaves the index dirty, so it is written here
+	~LibraryIndex() {
+		writer.stop();
+		save();
+	}
+
+	// Loads the index at path unless it is the one already loaded
+	void open(const std::wstring& path) {
+		if (path == indexPath) return;
+
+		save();
+		indexPath = path;
+		root.clear();
+		directories.clear();
+		sources.clear();
+		load();
+		requestedChange = changeCount;
+		savedChange = changeCount;
+	}
+
+	static int64_t getWriteTime(const std::wstring& path) {
+		std::error_code ec;
+		auto time = std::filesystem::last_write_time(path, ec);
+		return ec ? -1 : static_cast<int64_t>(time.time_since_epoch().count());
+	}
+
+	const DirectoryRecord* findDirectory(const std::wstring& dir) const {
+		auto it = directories.find(dir);
+		return it != directories.end() ? &it->second : nullptr;
+	}
+
+	// Sources recorded for root, sorted the way the library list is
+	std::vector<FoldersIdent> getSources(const std::wstring& scanRoot) const {
+		std::vector<FoldersIdent> result;
+		if (scanRoot != root) return result;
+
+		for (const auto& [dir, record] : directories)
+		{
+			if (record.hasImages)
+			{
+				result.push_back(FoldersIdent{ dir, false });
+			}
+			for (const auto& archive : record.archives)
+			{
+				result.push_back(FoldersIdent{ archive, true });
+			}
+		}
+		std::sort(result.begin(), result.end());
+		return result;
+	}
+
+	// Takes over the directories of a complete scan of scanRoot
+	void replaceDirectories(const std::wstring& scanRoot, DirectoryMap scanned) {
+		root = scanRoot;
+		directories = std::move(scanned);
+
+		// Forget sources that are no longer part of the library
+		std::set<std::wstring> live;
+		for (const auto& source : getSources(root))
+		{
+			live.insert(source.dir);
+		}
+		std::erase_if(sources, [&live](const auto& entry) { return live.count(entry.first) == 0; });
+		++changeCount;
+	}
+
+	// Live updates between scans; ignored unless they belong to the indexed root
+	void setDirectory(const std::wstring& scanRoot, const std::wstring& dir, DirectoryRecord record) {
+		if (scanRoot != root) return;
+		directories[dir] = std::move(record);
+		++changeCount;
+	}
+
+	void removeDirectoryTree(const std::wstring& scanRoot, const std::wstring& dir) {
+		if (scanRoot != root) return;
+
+		std::wstring prefix = dir + static_cast<wchar_t>(std::filesystem::path::preferred_separator);
+		size_t removed = std::erase_if(directories, [&](const auto& entry) {
+			return entry.first == dir || entry.first.compare(0, prefix.size(), prefix) == 0;
+			});
+		if (removed > 0) ++changeCount;
+	}
+
+	// Called when a source has been listed; the first-page size is dropped if it changed on disk
+	void recordSource(const FoldersIdent& folder, int pageCount) {
+		std::error_code ec;
+		uint64_t size = folder.isArchieve ? std::filesystem::file_size(folder.dir, ec) : 0;
+		if (ec) size = 0;
+		int64_t mtime = getWriteTime(folder.dir);
+
+		SourceRecord& record = sources[folder.dir];
+		if (record.isArchive == folder.isArchieve && record.size == size && record.mtime == mtime && record.pageCount == pageCount) return;
+
+		if (record.size != size || record.mtime != mtime)
+		{
+			record.firstPageSize = sf::Vector2u();
+		}
+		record.isArchive = folder.isArchieve;
+		record.size = size;
+		record.mtime = mtime;
+		record.pageCount = pageCount;
+		++changeCount;
+	}
+
+	void recordFirstPage(const std::wstring& dir, sf::Vector2u size) {
+		auto it = sources.find(dir);
+		if (it == sources.end() || it->second.firstPageSize == size) return;
+
+		it->second.firstPageSize = size;
+		++changeCount;
+	}
+
+	const SourceRecord* findSource(const std::wstring& dir) const {
+		auto it = sources.find(dir);
+		return it != sources.end() ? &it->second : nullptr;
+	}
+
+	size_t getDirectoryCount() const {
+		return directories.size();
+	}
+
+	bool isDirty() const {
+		return changeCount != savedChange.load();
+	}
+
+	// Saves on the calling thread
+	void save() {
+		if (!isDirty() || indexPath.empty()) return;
+
+		uint64_t change = changeCount;
+		writer.writeNow([this, change]() {
+			if (!writeIndex(indexPath, root, directories, sources)) return false;
+			savedChange = change;
+			return true;
+			});
+	}
+
+	// Saves a copy of the index in the background; the copy is cheap next to the file write. The
+	// index stays dirty until the write succeeds, so save() still writes it if the background
+	// write is dropped by stop() or fails.
+	void requestSave() {
+		if (!isDirty() || changeCount == requestedChange || indexPath.empty()) return;
+
+		requestedChange = changeCount;
+		writer.request([this, change = changeCount, path = indexPath, root = root, directories = directories, sources = sources]() {
+			if (!writeIndex(path, root, directories, sources)) return false;
+			savedChange = change;
+			return true;
+			});
+	}
+
+private:
+	// Writes a temporary file and renames it over the index, so a crash never leaves half an index
+	static bool writeIndex(const std::wstring& indexPath, const std::wstring& root, const DirectoryMap& directories, const SourceMap& sources) {
+		std::filesystem::path target(indexPath);
+		std::filesystem::path temporary = target;
+		temporary += L".tmp";
+
+		{
+			std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+			if (!file.is_open()) return false;
+
+			file << INDEX_HEADER << "\n";
+			file << "R\t" << UnicodeUtils::wstringToString(root) << "\n";
+			for (const auto& [dir, record] : directories)
+			{
+				file << "D\t" << record.mtime << "\t" << (record.hasImages ? 1 : 0) << "\t" << UnicodeUtils::wstringToString(dir) << "\n";
+				for (const auto& sub : record.subdirectories)
+				{
+					file << "d\t" << UnicodeUtils::wstringToString(sub) << "\n";
+				}
+				for (const auto& archive : record.archives)
+				{
+					file << "a\t" << UnicodeUtils::wstringToString(archive) << "\n";
+				}
+			}
+			for (const auto& [dir, record] : sources)
+			{
+				file << "S\t" << (record.isArchive ? 1 : 0) << "\t" << record.size << "\t" << record.mtime << "\t" << record.pageCount << "\t" <<
+					record.firstPageSize.x << "\t" << record.firstPageSize.y << "\t" << UnicodeUtils::wstringToString(dir) << "\n";
+			}
+			if (!file.good()) return false;
+		}
+
+		std::error_code ec;
+		std::filesystem::rename(temporary, target, ec);
+		return !ec;
+	}
+
+	// Fields are tab separated with the path last, so only tabs inside a path would confuse it
+	static std::vector<std::string> splitFields(const std::string& line, size_t count) {
+		std::vector<std::string> fields;
+		size_t start = 0;
+		while (fields.size() + 1 < count)
+		{
+			size_t tab = line.find('\t', start);
+			if (tab == std::string::npos) break;
+			fields.push_back(line.substr(start, tab - start));
+			start = tab + 1;
+		}
+		fields.push_back(line.substr(start));
+		return fields;
+	}
+
+	// A damaged index only costs a full scan, so parse errors just stop reading
+	void load() {
+		std::ifstream file(std::filesystem::path(indexPath), std::ios::binary);
+		if (!file.is_open()) return;
+
+		std::string line;
+		if (!std::getline(file, line) || line != INDEX_HEADER) return;
+
+		DirectoryRecord* current = nullptr;
+		try
+		{
+			while (std::getline(file, line))
+			{
+				if (line.size() < 2 || line[1] != '\t') continue;
+
+				switch (line[0])
+				{
+				case 'R':
+					root = UnicodeUtils::stringToWstring(line.substr(2));
+					break;
+				case 'D':
+				{
+					auto fields = splitFields(line.substr(2), 3);
+					if (fields.size() != 3) return;
+					current = &directories[UnicodeUtils::stringToWstring(fields[2])];
+					current->mtime = std::stoll(fields[0]);
+					current->hasImages = fields[1] == "1";
+					break;
+				}
+				case 'd':
+					if (current) current->subdirectories.push_back(UnicodeUtils::stringToWstring(line.substr(2)));
+					break;
+				case 'a':
+					if (current) current->archives.push_back(UnicodeUtils::stringToWstring(line.substr(2)));
+					break;
+				case 'S':
+				{
+					auto fields = splitFields(line.substr(2), 7);
+					if (fields.size() != 7) return;
+					SourceRecord& record = sources[UnicodeUtils::stringToWstring(fields[6])];
+					record.isArchive = fields[0] == "1";
+					record.size = std::stoull(fields[1]);
+					record.mtime = std::stoll(fields[2]);
+					record.pageCount = std::stoi(fields[3]);
+					record.firstPageSize = sf::Vector2u(static_cast<unsigned int>(std::stoul(fields[4])), static_cast<unsigned int>(std::stoul(fields[5])));
+					break;
+				}
+				}
+			}
+		} catch (const std::exception&)
+		{
+			directories.clear();
+			sources.clear();
+		}
+	}
+};
+
+// Reading position of every title opened, keyed by source path. Updates are appended to a log
+// as one line each, so a page turn costs a small write instead of rewriting a file; the log is
+// rewritten with only the latest record per title once it holds several times as many lines.
+// Both happen on a DebouncedWriter: a page turn only queues its line, and a run of turns ends up
+// as one append. The destructor and switching logs write what is queued synchronously.
+class ReadingProgress {
+public:
+	struct Record {
+		int page = 0;
+		int pageCount = 0;
+		bool completed = false;     // The last page was reached at some point
+		int64_t lastRead = 0;       // Seconds since the epoch
+	};
+
+private:
+	using RecordMap = std::unordered_map<std::wstring, Record>;
+
+	std::wstring logPath;
+	RecordMap records;
+	size_t logLines;
+	size_t appends;
+	size_t compactions;
+
+	std::mutex pendingMutex;            // Between the UI thread and the writer
+	std::string pendingLines;           // Records not appended yet
+	RecordMap pendingRewrite;           // The whole log to write instead, when compacting
+	bool rewritePending;
+	std::ofstream log;                  // Only used by the writer
+	DebouncedWriter writer;
+
+	static constexpr const char* LOG_HEADER = "; Manga Reader Progress Log v1";
+	static constexpr size_t COMPACT_MIN_LINES = 256;
+	static constexpr size_t COMPACT_FACTOR = 4;
+	static constexpr int WRITE_DEBOUNCE_MS = 500;
+
+public:
+	ReadingProgress() : logPath(), records(), logLines(0), appends(0), compactions(0), pendingMutex(), pendingLines(), pendingRewrite(),
+		rewritePending(false), log(), writer(std::chrono::milliseconds(WRITE_DEBOUNCE_MS)) { }
+
+	~ReadingProgress() {
+		flush();
+	}
+
+	// Loads the log at path unless it is the one already open
+	void open(const std::wstring& path) {
+		if (path == logPath) return;
+
+		flush();
+		logPath = path;
+		records.clear();
+		logLines = 0;
+		load();
+		if (needsCompaction() || logLines == 0)
+		{
+			compact();
+		}
+	}
+
+	const Record* find(const std::wstring& source) const {
+		auto it = records.find(source);
+		return it != records.end() ? &it->second : nullptr;
+	}
+
+	// Page to reopen source at: where it was left, or the start once it was read to the end
+	int getResumePage(const std::wstring& source, int visiblePages = 1) const {
+		const Record* record = find(source);
+		if (!record || record->page + visiblePages >= record->pageCount) return 0;
+		return record->page;
+	}
+
+	// Appends the position unless it is the one already recorded
+	void update(const std::wstring& source, int page, int pageCount, int visiblePages = 1) {
+		if (logPath.empty() || source.empty() || pageCount <= 0) return;
+
+		Record& record = records[source];
+		bool completed = record.completed || page + visiblePages >= pageCount;
+		if (record.page == page && record.pageCount == pageCount && record.completed == completed && record.lastRead != 0) return;
+
+		record.page = page;
+		record.pageCount = pageCount;
+		record.completed = completed;
+		record.lastRead = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+		logLines++;
+		appends++;
+
+		if (needsCompaction())
+		{
+			compact();
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(pendingMutex);
+			pendingLines += formatRecord(source, record);
+		}
+		requestWrite();
+	}
+
+	size_t getTitleCount() const {
+		return records.size();
+	}
+
+	std::string getStatsString() const {
+		return std::to_string(records.size()) + " titles, " + std::to_string(logLines) + " log lines, " +
+			std::to_string(appends) + " appends, " + std::to_string(compactions) + " compactions";
+	}
+
+private:
+	bool needsCompaction() const {
+		return logLines > std::max(COMPACT_MIN_LINES, records.size() * COMPACT_FACTOR);
+	}
+
+	static std::string formatRecord(const std::wstring& source, const Record& record) {
+		return "P\t" + std::to_string(record.page) + "\t" + std::to_string(record.pageCount) + "\t" + (record.completed ? "1" : "0") + "\t" +
+			std::to_string(record.lastRead) + "\t" + UnicodeUtils::wstringToString(source) + "\n";
+	}
+
+	// Queues a rewrite with the latest record per title; lines queued before it are part of it
+	void compact() {
+		if (logPath.empty()) return;
+		{
+			std::lock_guard<std::mutex> lock(pendingMutex);
+			pendingRewrite = records;
+			rewritePending = true;
+			pendingLines.clear();
+		}
+		logLines = records.size();
+		compactions++;
+		requestWrite();
+	}
+
+	void requestWrite() {
+		writer.request([this, path = logPath]() { return writePending(path); });
+	}
+
+	// Writes what is queued now and stops the writer, which the next request starts again
+	void flush() {
+		writer.stop();
+		if (!logPath.empty())
+		{
+			writer.writeNow([this, path = logPath]() { return writePending(path); });
+		}
+		log.close();
+	}
+
+	// Writer side: the rewrite first, with the same temporary-file-and-rename as the library
+	// index, then the lines queued since. When the rewrite fails its records are appended to the
+	// old log instead, where later lines win just the same.
+	bool writePending(const std::wstring& path) {
+		RecordMap rewrite;
+		bool hasRewrite = false;
+		std::string lines;
+		{
+			std::lock_guard<std::mutex> lock(pendingMutex);
+			std::swap(hasRewrite, rewritePending);
+			rewrite.swap(pendingRewrite);
+			lines.swap(pendingLines);
+		}
+
+		if (hasRewrite)
+		{
+			log.close(); // The log cannot be replaced while it is open
+			if (!writeLog(path, rewrite))
+			{
+				std::string records;
+				for (const auto& [source, record] : rewrite)
+				{
+					records += formatRecord(source, record);
+				}
+				lines.insert(0, records);
+			}
+		}
+		if (lines.empty()) return true;
+
+		if (!log.is_open())
+		{
+			std::error_code ec;
+			bool isNew = std::filesystem::file_size(path, ec) == 0 || ec;
+			log.open(std::filesystem::path(path), std::ios::binary | std::ios::app);
+			if (!log.is_open()) return false;
+			if (isNew) log << LOG_HEADER << "\n";
+		}
+		log << lines;
+		log.flush();
+		return log.good();
+	}
+
+	static bool writeLog(const std::wstring& path, const RecordMap& snapshot) {
+		std::filesystem::path target(path);
+		std::filesystem::path temporary = target;
+		temporary += L".tmp";
+
+		{
+			std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+			if (!file.is_open()) return false;
+
+			file << LOG_HEADER << "\n";
+			for (const auto& [source, record] : snapshot)
+			{
+				file << formatRecord(source, record);
+			}
+			if (!file.good()) return false;
+		}
+
+		std::error_code ec;
+		std::filesystem::rename(temporary, target, ec);
+		return !ec;
+	}
+
+	// Later lines replace earlier ones; a torn last line from a crash is skipped
+	void load() {
+		std::ifstream file(std::filesystem::path(logPath), std::ios::binary);
+		if (!file.is_open()) return;
+
+		std::string line;
+		if (!std::getline(file, line) || line != LOG_HEADER) return;
+
+		while (std::getline(file, line))
+		{
+			if (line.size() < 2 || line[0] != 'P' || line[1] != '\t') continue;
+
+			std::vector<std::string> fields;
+			size_t start = 2;
+			while (fields.size() < 4)
+			{
+				size_t tab = line.find('\t', start);
+				if (tab == std::string::npos) break;
+				fields.push_back(line.substr(start, tab - start));
+				start = tab + 1;
+			}
+			if (fields.size() != 4 || start >= line.size()) continue;
+
+			try
+			{
+				Record record;
+				record.page = std::stoi(fields[0]);
+				record.pageCount = std::stoi(fields[1]);
+				record.completed = fields[2] == "1";
+				record.lastRead = std::stoll(fields[3]);
+				records[UnicodeUtils::stringToWstring(line.substr(start))] = record;
+				logLines++;
+			} catch (const std::exception&)
+			{
+				continue;
+			}
+		}
+	}
+};
+
+// Walks the library on a pool of workers. Each directory is listed once: image files mark it as
+// an image folder, archives are reported directly and subdirectories are queued until maxDepth
+// (the root is depth 0). Results are buffered for the UI thread to merge while the scan runs.
+// With an index, directories whose mtime matches the recorded one are not listed again.
+// refresh() runs the same pool over the directories the watcher reported.
+class LibraryScanner {
+public:
+	struct WorkItem {
+		std::wstring dir;
+		int depth;
+	};
+
+private:
+	enum class Mode {
+		FULL,       // From the root; results stream out, the listing replaces the index
+		REFRESH     // Given directories; the listing is applied as a whole when done
+	};
+
+	std::mutex mutex;
+	std::condition_variable workAvailable;
+	std::condition_variable resultsAvailable;
+	std::deque<WorkItem> queue;
+	std::vector<FoldersIdent> results;
+	std::vector<std::future<void>> workers;
+	int busyWorkers;
+	int runningWorkers;
+	int maxDepth;
+	bool stopping;
+	std::string rootError;
+	std::atomic<size_t> directoriesScanned;
+	std::atomic<size_t> directoriesReused;
+	const LibraryIndex* index;          // Read only while the scan runs
+	LibraryIndex::DirectoryMap scanned; // Every directory visited, for the index
+	bool completed;                     // The scan ran to the end and scanned is unclaimed
+	Mode mode;
+
+public:
+	LibraryScanner() : mutex(), workAvailable(), resultsAvailable(), queue(), results(), workers(), busyWorkers(0),
+		runningWorkers(0), maxDepth(1), stopping(false), rootError(), directoriesScanned(0), directoriesReused(0),
+		index(nullptr), scanned(), completed(false), mode(Mode::FULL) { }
+
+	~LibraryScanner() {
+		cancel();
+	}
+
+	void start(const std::wstring& root, int depth, int threadCount, const LibraryIndex* libraryIndex = nullptr) {
+		directoriesScanned = 0;
+		directoriesReused = 0;
+		launch(Mode::FULL, { WorkItem{ root, 0 } }, depth, threadCount, libraryIndex);
+	}
+
+	// Lists dirs again, each with its depth below the root. Entries that are no longer
+	// directories are skipped, and subdirectories the index doesn't know yet (folders moved in)
+	// are walked down to depth. The listing is handed out by takeRefreshedDirectories.
+	void refresh(std::vector<WorkItem> dirs, int depth, int threadCount, const LibraryIndex* libraryIndex) {
+		if (dirs.empty()) return;
+		int threads = std::min(threadCount, static_cast<int>(dirs.size()));
+		launch(Mode::REFRESH, std::deque<WorkItem>(std::make_move_iterator(dirs.begin()), std::make_move_iterator(dirs.end())),
+			depth, threads, libraryIndex);
+	}
+
+	void cancel() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+		workAvailable.notify_all();
+
+		for (auto& worker : workers)
+		{
+			worker.wait();
+		}
+		workers.clear();
+	}
+
+	bool isScanning() {
+		std::lock_guard<std::mutex> lock(mutex);
+		return runningWorkers > 0;
+	}
+
+	// Moves everything found since the last call into out
+	size_t takeResults(std::vector<FoldersIdent>& out) {
+		std::lock_guard<std::mutex> lock(mutex);
+		size_t count = results.size();
+		std::move(results.begin(), results.end(), std::back_inserter(out));
+		results.clear();
+		return count;
+	}
+
+	// Blocks until something was found or the scan is over
+	void waitForResults() {
+		std::unique_lock<std::mutex> lock(mutex);
+		resultsAvailable.wait(lock, [this]() { return !results.empty() || runningWorkers == 0; });
+	}
+
+	void waitUntilDone() {
+		std::unique_lock<std::mutex> lock(mutex);
+		resultsAvailable.wait(lock, [this]() { return runningWorkers == 0; });
+	}
+
+	// Set when the root itself could not be listed
+	std::string getRootError() {
+		std::lock_guard<std::mutex> lock(mutex);
+		return rootError;
+	}
+
+	size_t getDirectoriesScanned() const {
+		return directoriesScanned;
+	}
+
+	size_t getDirectoriesReused() const {
+		return directoriesReused;
+	}
+
+	// Lists one directory into record: subdirectories, archives and whether it holds images
+	static std::error_code listDirectory(const std::wstring& dir, LibraryIndex::DirectoryRecord& record) {
+		record = LibraryIndex::DirectoryRecord();
+		record.mtime = LibraryIndex::getWriteTime(dir);
+
+		return DirectoryEnumerator::forEach(dir, [&](std::wstring_view name, DirectoryEnumerator::EntryType type) {
+			if (type == DirectoryEnumerator::EntryType::DIRECTORY)
+			{
+				record.subdirectories.push_back(DirectoryEnumerator::joinPath(dir, name));
+			}
+			else if (type == DirectoryEnumerator::EntryType::FILE)
+			{
+				std::wstring_view extension = DirectoryEnumerator::getExtension(name);
+				if (!record.hasImages && IsImgExtValid(extension))
+				{
+					record.hasImages = true;
+				}
+				else if (IsArchiveExtValid(extension))
+				{
+					record.archives.push_back(DirectoryEnumerator::joinPath(dir, name));
+				}
+			}
+			});
+	}
+
+	// Hands over the directories of a scan that finished without being cancelled, once
+	bool takeScannedDirectories(LibraryIndex::DirectoryMap& out) {
+		return takeListing(Mode::FULL, out);
+	}
+
+	// Same for a refresh: only the directories it listed
+	bool takeRefreshedDirectories(LibraryIndex::DirectoryMap& out) {
+		return takeListing(Mode::REFRESH, out);
+	}
+
+private:
+	void launch(Mode scanMode, std::deque<WorkItem> items, int depth, int threadCount, const LibraryIndex* libraryIndex) {
+		cancel();
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			queue = std::move(items);
+			results.clear();
+			scanned.clear();
+			completed = false;
+			mode = scanMode;
+			index = libraryIndex;
+			maxDepth = std::max(0, depth);
+			stopping = false;
+			busyWorkers = 0;
+			rootError.clear();
+			runningWorkers = std::max(1, threadCount);
+		}
+
+		for (int i = 0; i < std::max(1, threadCount); ++i)
+		{
+			workers.emplace_back(std::async(std::launch::async, [this]() { work(); }));
+		}
+	}
+
+	bool takeListing(Mode scanMode, LibraryIndex::DirectoryMap& out) {
+		std::lock_guard<std::mutex> lock(mutex);
+		if (!completed || runningWorkers > 0 || mode != scanMode) return false;
+
+		out = std::move(scanned);
+		scanned.clear();
+		completed = false;
+		return true;
+	}
+
+	void work() {
+		std::unique_lock<std::mutex> lock(mutex);
+		while (true)
+		{
+			workAvailable.wait(lock, [this]() { return stopping || !queue.empty() || busyWorkers == 0; });
+			if (stopping || queue.empty())
+			{
+				break; // cancelled, or nothing queued and nobody left to queue more
+			}
+
+			WorkItem item = std::move(queue.front());
+			queue.pop_front();
+			busyWorkers++;
+			lock.unlock();
+
+			std::vector<FoldersIdent> found;
+			std::vector<std::wstring> subdirectories;
+			LibraryIndex::DirectoryRecord record;
+			std::string error = scanDirectory(item, record, found, subdirectories);
+
+			lock.lock();
+			busyWorkers--;
+			if (item.depth == 0 && mode == Mode::FULL) rootError = error;
+			if (error.empty())
+			{
+				scanned[item.dir] = std::move(record);
+			}
+			for (auto& dir : subdirectories)
+			{
+				queue.push_back(WorkItem{ std::move(dir), item.depth + 1 });
+			}
+			if (!found.empty() && mode == Mode::FULL)
+			{
+				std::move(found.begin(), found.end(), std::back_inserter(results));
+				resultsAvailable.notify_all();
+			}
+			workAvailable.notify_all();
+		}
+
+		runningWorkers--;
+		if (runningWorkers == 0 && !stopping)
+		{
+			completed = true;
+		}
+		lock.unlock();
+		workAvailable.notify_all();
+		resultsAvailable.notify_all();
+	}
+
+	// Reuses the indexed record when the directory's mtime still matches, otherwise lists it once;
+	// unreadable entries are skipped rather than failing the scan. A refresh always lists, the
+	// watcher has seen the directory change.
+	std::string scanDirectory(const WorkItem& item, LibraryIndex::DirectoryRecord& record, std::vector<FoldersIdent>& found,
+		std::vector<std::wstring>& subdirectories) {
+		int64_t mtime = LibraryIndex::getWriteTime(item.dir);
+		const LibraryIndex::DirectoryRecord* cached = index ? index->findDirectory(item.dir) : nullptr;
+		std::error_code ec;
+
+		if (mode == Mode::FULL && cached && mtime >= 0 && cached->mtime == mtime)
+		{
+			record = *cached;
+			directoriesReused++;
+		}
+		else
+		{
+			ec = listDirectory(item.dir, record);
+		}
+
+		directoriesScanned++;
+		if (item.depth < maxDepth)
+		{
+			subdirectories = record.subdirectories;
+			if (mode == Mode::REFRESH)
+			{
+				std::erase_if(subdirectories, [this](const std::wstring& sub) { return index && index->findDirectory(sub); });
+			}
+		}
+		for (const auto& archive : record.archives)
+		{
+			found.push_back(FoldersIdent{ archive, true });
+		}
+		if (record.hasImages)
+		{
+			found.push_back(FoldersIdent{ item.dir, false });
+		}
+		return ec ? ec.message() : std::string();
+	}
+};
+
+#ifdef _WIN32
+// Watches the library root for files and folders being added, removed or renamed. Events are
+// collected on a worker and handed out once the tree has been quiet for the debounce time, so
+// copying a chapter in results in one update instead of one per file. Writes to files count as
+// activity too: an archive still being copied holds the changes back until its size settles.
+class LibraryWatcher {
+public:
+	struct Changes {
+		std::set<std::wstring> directories; // Directories to list again, including added ones
+		std::set<std::wstring> removed;     // Paths removed or renamed away
+		bool overflowed = false;            // Events were lost and the whole library needs a rescan
+	};
+
+private:
+	std::wstring root;
+	std::future<void> worker;
+	HANDLE stopEvent;
+	std::mutex mutex;
+	Changes pending;
+	bool hasPending;
+	std::chrono::steady_clock::time_point lastEvent;
+	std::atomic<size_t> eventCount;
+
+	static constexpr DWORD BUFFER_BYTES = 64 * 1024;
+
+public:
+	LibraryWatcher() : root(), worker(), stopEvent(nullptr), mutex(), pending(), hasPending(false), lastEvent(), eventCount(0) { }
+
+	~LibraryWatcher() {
+		stop();
+	}
+
+	void start(const std::wstring& path) {
+		stop();
+
+		root = path;
+		stopEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+		if (!stopEvent) return;
+
+		worker = std::async(std::launch::async, [this]() { watch(); });
+	}
+
+	void stop() {
+		if (worker.valid())
+		{
+			SetEvent(stopEvent);
+			worker.wait();
+			worker = std::future<void>();
+		}
+		if (stopEvent)
+		{
+			CloseHandle(stopEvent);
+			stopEvent = nullptr;
+		}
+
+		std::lock_guard<std::mutex> lock(mutex);
+		pending = Changes();
+		hasPending = false;
+	}
+
+	bool hasPendingChanges() {
+		std::lock_guard<std::mutex> lock(mutex);
+		return hasPending;
+	}
+
+	// Moves the collected changes into out once nothing happened for debounceMs
+	bool takeChanges(Changes& out, int debounceMs) {
+		std::lock_guard<std::mutex> lock(mutex);
+		if (!hasPending || std::chrono::steady_clock::now() - lastEvent < std::chrono::milliseconds(debounceMs))
+		{
+			return false;
+		}
+
+		out = std::move(pending);
+		pending = Changes();
+		hasPending = false;
+		return true;
+	}
+
+	size_t getEventCount() const {
+		return eventCount;
+	}
+
+private:
+	void watch() {
+		HANDLE directory = CreateFileW(root.c_str(), FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+			nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+		if (directory == INVALID_HANDLE_VALUE) return;
+
+		OVERLAPPED overlapped = {};
+		overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+		std::vector<DWORD> buffer(BUFFER_BYTES / sizeof(DWORD)); // FILE_NOTIFY_INFORMATION is DWORD aligned
+
+		while (overlapped.hEvent)
+		{
+			ResetEvent(overlapped.hEvent);
+			if (!ReadDirectoryChangesW(directory, buffer.data(), BUFFER_BYTES, TRUE,
+				FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE,
+				nullptr, &overlapped, nullptr))
+			{
+				break;
+			}
+
+			HANDLE handles[] = { overlapped.hEvent, stopEvent };
+			DWORD transferred = 0;
+			if (WaitForMultipleObjects(2, handles, FALSE, INFINITE) != WAIT_OBJECT_0)
+			{
+				CancelIoEx(directory, &overlapped);
+				GetOverlappedResult(directory, &overlapped, &transferred, TRUE);
+				break;
+			}
+			if (!GetOverlappedResult(directory, &overlapped, &transferred, FALSE))
+			{
+				break;
+			}
+
+			record(reinterpret_cast<const BYTE*>(buffer.data()), transferred);
+		}
+
+		if (overlapped.hEvent) CloseHandle(overlapped.hEvent);
+		CloseHandle(directory);
+	}
+
+	// An empty result means the buffer overflowed and events were dropped
+	void record(const BYTE* data, DWORD size) {
+		std::lock_guard<std::mutex> lock(mutex);
+		lastEvent = std::chrono::steady_clock::now();
+
+		if (size == 0)
+		{
+			pending.overflowed = true;
+			hasPending = true;
+			return;
+		}
+
+		for (DWORD offset = 0; offset < size;)
+		{
+			const auto* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(data + offset);
+			eventCount++;
+
+			// A write only postpones the update; the listing doesn't change
+			if (info->Action == FILE_ACTION_MODIFIED)
+			{
+				if (info->NextEntryOffset == 0) break;
+				offset += info->NextEntryOffset;
+				continue;
+			}
+
+			std::filesystem::path path = std::filesystem::path(root) / std::wstring(info->FileName, info->FileNameLength / sizeof(wchar_t));
+			hasPending = true;
+			pending.directories.insert(path.parent_path().wstring());
+			if (info->Action == FILE_ACTION_REMOVED || info->Action == FILE_ACTION_RENAMED_OLD_NAME)
+			{
+				pending.removed.insert(path.wstring());
+			}
+			else if (info->Action == FILE_ACTION_ADDED || info->Action == FILE_ACTION_RENAMED_NEW_NAME)
+			{
+				pending.directories.insert(path.wstring()); // Dropped later unless it is a folder
+			}
+
+			if (info->NextEntryOffset == 0) break;
+			offset += info->NextEntryOffset;
+		}
+	}
+};
+#endif
+
+// Opens a neighbouring folder or archive in the background, lists it and decodes its first
+// pages, so switching to it skips the cold open and the cold decode. Holds one source at a time.
+class FolderPrefetcher {
+public:
+	struct Result {
+		std::wstring dir;
+		bool isArchive = false;
+		PageList images;
+		std::vector<std::pair<int, ImageLoader::LoadResult>> pages;
+		bool success = false;
+	};
+
+private:
+	// Everything a fetch touches, owned jointly with its job so a superseded fetch can be
+	// left to finish on its own instead of being waited for
+	struct Fetch {
+		ArchiveHandler archive;         // Owns the prefetched archive until it is adopted
+		Result result;                  // Written by the job, read once the job is finished
+		std::atomic<bool> cancelled{ false };
+	};
+
+	std::shared_ptr<Fetch> current;
+	std::future<void> job;
+	std::vector<std::future<void>> retiredJobs;	// cancelled fetches, reaped once finished
+	std::wstring pendingDir;
+	std::atomic<int> adoptedCount;
+	std::atomic<int> discardedCount;
+
+public:
+	FolderPrefetcher() : current(), job(), retiredJobs(), pendingDir(), adoptedCount(0), discardedCount(0) { }
+
+	~FolderPrefetcher() {
+		cancel();
+		for (auto& retired : retiredJobs)
+		{
+			retired.wait();
+		}
+	}
+
+	// Starts fetching a source unless it is already fetched or in flight; replaces any other one.
+	// pageCount pages are decoded from firstPage on, the page the source will be opened at.
+	void request(const FoldersIdent& folder, int firstPage, int pageCount) {
+		if (folder.dir == pendingDir) return;
+
+		if (!pendingDir.empty())
+		{
+			discardedCount++;
+		}
+		cancel();
+
+		pendingDir = folder.dir;
+		current = std::make_shared<Fetch>();
+		std::shared_ptr<Fetch> fetch = current;
+		job = std::async(std::launch::async, [fetch, folder, firstPage, pageCount]() {
+			run(*fetch, folder, firstPage, pageCount);
+			});
+	}
+
+	// Hands the prefetched source over if it is the one being opened: the archive state is
+	// swapped into target and the listing plus decoded pages are moved into out. This is the
+	// one place that waits, since the caller is about to open that source anyway.
+	bool take(const std::wstring& dir, ArchiveHandler& target, Result& out) {
+		if (pendingDir.empty() || dir != pendingDir)
+		{
+			return false;
+		}
+
+		if (job.valid())
+		{
+			job.wait();
+		}
+
+		bool adopted = current->result.success;
+		if (adopted)
+		{
+			if (current->result.isArchive)
+			{
+				target.swapWith(current->archive);
+			}
+			out = std::move(current->result);
+			adoptedCount++;
+		}
+
+		job = std::future<void>();
+		reset();
+		return adopted;
+	}
+
+	// Doesn't block: a running fetch is told to stop and finishes in the background
+	void cancel() {
+		if (current)
+		{
+			current->cancelled = true;
+		}
+		if (job.valid())
+		{
+			retiredJobs.push_back(std::move(job));
+		}
+		reset();
+
+		std::erase_if(retiredJobs, [](std::future<void>& retired) {
+			return retired.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+			});
+	}
+
+	bool isPending(const std::wstring& dir) const {
+		return !pendingDir.empty() && dir == pendingDir;
+	}
+
+	std::string getStatusString() const {
+		std::string status = pendingDir.empty() ? "Idle" :
+			(job.valid() && job.wait_for(std::chrono::seconds(0)) != std::future_status::ready ? "Loading" : "Ready");
+		return status + " (" + std::to_string(adoptedCount.load()) + " used, " + std::to_string(discardedCount.load()) + " discarded)";
+	}
+
+private:
+	// The fetch's archive closes with its last owner, the job or this prefetcher
+	void reset() {
+		current.reset();
+		pendingDir.clear();
+	}
+
+	static void run(Fetch& fetch, const FoldersIdent& folder, int firstPage, int pageCount) {
+		LockedMessageBox::SilentScope silent;
+
+		Result fetched;
+		fetched.dir = folder.dir;
+		fetched.isArchive = folder.isArchieve;
+
+		try
+		{
+			if (folder.isArchieve)
+			{
+				if (!fetch.archive.openArchive(folder.dir)) return;
+
+				fetched.images = FileSystemHelper::listArchivePages(folder.dir, fetch.archive.getImageEntries());
+			}
+			else
+			{
+				fetched.images = FileSystemHelper::listImageFiles(folder.dir);
+			}
+
+			int total = static_cast<int>(fetched.images.size());
+			int first = std::clamp(firstPage, 0, std::max(0, total - 1));
+			int end = std::min(total, first + pageCount);
+			for (int i = first; i < end && !fetch.cancelled; ++i)
+			{
+				ImageLoadingDispatcher::LoadContext context(fetched.isArchive, &fetch.archive, &fetched.images, i);
+				ImageLoader::LoadResult page = ImageLoadingDispatcher::loadImageAtIndex(context);
+				if (page.success)
+				{
+					fetched.pages.emplace_back(i, std::move(page));
+				}
+			}
+		} catch (...)
+		{
+			return; // The real load will report it
+		}
+
+		fetched.success = !fetch.cancelled && !fetched.images.empty();
+		fetch.result = std::move(fetched);
+	}
+};
+
+// Extracts archive entries around the current page on a worker thread. The window follows the
+// reading direction and grows with the page-turn rate, so fast readers get a deeper lookahead;
+// entries outside the window are dropped once the cache goes over the memory budget.
+class PagePrefetcher {
+private:
+	static constexpr float LOOKAHEAD_SECONDS = 4.0f;    // Aim to cover this much reading time
+	static constexpr float DEFAULT_TURN_SECONDS = 5.0f;
+	static constexpr float TURN_SMOOTHING = 0.3f;
+	static constexpr int MIN_DEPTH = 2;
+	static constexpr int MAX_DEPTH = 12;
+	static constexpr int BEHIND_DEPTH = 1;
+	static constexpr int MAX_TRACKED_JUMP = 8;           // Larger jumps are seeks, not reading
+
+	ArchiveHandler* archive;
+	size_t budgetBytes;
+
+	// Reading pattern, UI thread only
+	std::chrono::steady_clock::time_point lastTurnTime;
+	int lastIndex;
+	int direction;
+	float averageTurnSeconds;
+	int hits;
+	int misses;
+
+	// Window shared with the worker
+	std::mutex stateMutex;
+	int windowIndex;
+	int windowAhead;
+	int windowBehind;
+	int windowDirection;
+	int windowCount;
+	CancellationToken folderToken;
+	uint64_t generation;
+	bool running;
+	std::future<void> job;
+
+public:
+	PagePrefetcher() : archive(nullptr), budgetBytes(256u * 1024u * 1024u), lastTurnTime(), lastIndex(-1), direction(1),
+		averageTurnSeconds(DEFAULT_TURN_SECONDS), hits(0), misses(0), stateMutex(), windowIndex(0), windowAhead(MIN_DEPTH),
+		windowBehind(BEHIND_DEPTH), windowDirection(1), windowCount(0), folderToken(), generation(0), running(false), job() { }
+
+	~PagePrefetcher() {
+		cancel();
+	}
+
+	void setArchive(ArchiveHandler* handler) {
+		archive = handler;
+	}
+
+	void setBudget(size_t bytes) {
+		budgetBytes = bytes;
+	}
+
+	// Called on every page turn; wasReady tells whether the page was already decoded or cached
+	void onPageTurn(int index, int pageCount, bool wasReady, CancellationToken token) {
+		auto now = std::chrono::steady_clock::now();
+		if (lastIndex >= 0 && index != lastIndex && std::abs(index - lastIndex) <= MAX_TRACKED_JUMP)
+		{
+			float seconds = std::chrono::duration<float>(now - lastTurnTime).count();
+			float perPage = seconds / static_cast<float>(std::abs(index - lastIndex));
+			averageTurnSeconds += (perPage - averageTurnSeconds) * TURN_SMOOTHING;
+			direction = index > lastIndex ? 1 : -1;
+
+			if (wasReady) hits++;
+			else misses++;
+		}
+		lastTurnTime = now;
+		lastIndex = index;
+
+		int depth = static_cast<int>(std::ceil(LOOKAHEAD_SECONDS / std::max(averageTurnSeconds, 0.05f)));
+		schedule(index, pageCount, std::clamp(depth, MIN_DEPTH, MAX_DEPTH), token);
+	}
+
+	// New source: forget the reading pattern but keep the hit statistics
+	void reset() {
+		cancel();
+		lastIndex = -1;
+		direction = 1;
+		averageTurnSeconds = DEFAULT_TURN_SECONDS;
+	}
+
+	// Must be called before the archive is closed or swapped
+	void cancel() {
+		{
+			std::lock_guard<std::mutex> lock(stateMutex);
+			generation++;
+			windowCount = 0;
+		}
+		if (job.valid())
+		{
+			job.wait();
+		}
+	}
+
+	int getLookahead() {
+		std::lock_guard<std::mutex> lock(stateMutex);
+		return windowAhead;
+	}
+
+	int getDirection() const {
+		return direction;
+	}
+
+	float getPagesPerMinute() const {
+		return 60.0f / std::max(averageTurnSeconds, 0.05f);
+	}
+
+	std::string getHitRateString() const {
+		int total = hits + misses;
+		if (total == 0) return "n/a";
+		return std::to_string(hits * 100 / total) + "% (" + std::to_string(hits) + "/" + std::to_string(total) + ")";
+	}
+
+private:
+	void schedule(int index, int pageCount, int depth, CancellationToken token) {
+		if (!archive) return;
+
+		std::lock_guard<std::mutex> lock(stateMutex);
+		folderToken = token;
+		windowIndex = index;
+		windowAhead = depth;
+		windowBehind = BEHIND_DEPTH;
+		windowDirection = direction;
+		windowCount = pageCount;
+		generation++;
+
+		if (!running)
+		{
+			running = true;
+			job = std::async(std::launch::async, [this]() { work(); });
+		}
+	}
+
+	// Pages in the reading direction first, nearest first, then the few behind
+	static std::vector<int> buildOrder(int index, int ahead, int behind, int dir, int count) {
+		std::vector<int> order;
+		for (int i = 1; i <= ahead; ++i)
+		{
+			int page = index + i * dir;
+			if (page >= 0 && page < count) order.push_back(page);
+		}
+		for (int i = 1; i <= behind; ++i)
+		{
+			int page = index - i * dir;
+			if (page >= 0 && page < count) order.push_back(page);
+		}
+		return order;
+	}
+
+	void work() {
+		LockedMessageBox::SilentScope silent;
+
+		while (true)
+		{
+			int index, ahead, behind, dir, count;
+			uint64_t seen;
+			CancellationToken token;
+			{
+				std::lock_guard<std::mutex> lock(stateMutex);
+				token = folderToken;
+				index = windowIndex;
+				ahead = windowAhead;
+				behind = windowBehind;
+				dir = windowDirection;
+				count = windowCount;
+				seen = generation;
+			}
+
+			std::vector<int> order = buildOrder(index, ahead, behind, dir, count);
+			evictOutside(index, order);
+
+			const auto& entries = archive->getImageEntries();
+			for (int page : order)
+			{
+				if (isStale(seen) || token.isCancelled()) break;
+				if (page >= entries.size() || archive->isCached(page)) continue;
+				if (archive->getCacheBytes() + entries[page].size > budgetBytes) break;
+
+				archive->prefetchEntry(page);
+			}
+
+			std::lock_guard<std::mutex> lock(stateMutex);
+			if (generation == seen || windowCount == 0)
+			{
+				running = false;
+				return;
+			}
+		}
+	}
+
+	bool isStale(uint64_t seen) {
+		std::lock_guard<std::mutex> lock(stateMutex);
+		return generation != seen;
+	}
+
+	// Over budget, drop cached entries that are neither the current page nor in the window
+	void evictOutside(int index, const std::vector<int>& window) {
+		if (archive->getCacheBytes() <= budgetBytes) return;
+
+		for (int cached : archive->getCachedIndices())
+		{
+			if (cached == index || std::find(window.begin(), window.end(), cached) != window.end()) continue;
+			archive->clearCache(cached);
+		}
+	}
+};
+
+// Settings live in configData on the UI thread. requestSave hands a copy to a DebouncedWriter,
+// so a burst of changes (a resize drag) ends up as one write. Writes go to a temporary file that
+// is renamed over the INI, and the destructor writes the final state synchronously.
+class ConfigManager {
+private:
+	using ConfigData = std::map<std::string, std::string>;
+
+	std::wstring configFilePath;
+	ConfigData configData;
+	DebouncedWriter writer;
+
+	static constexpr int SAVE_DEBOUNCE_MS = 500;
+
+public:
+	ConfigManager(const std::wstring& configPath = L"") : configFilePath() , configData(), writer(std::chrono::milliseconds(SAVE_DEBOUNCE_MS)) {
+
+		if (configPath.empty())
+		{
+			// Default to executable directory + "config.ini"
+#ifdef _WIN32
+			wchar_t exePath[MAX_PATH];
+			GetModuleFileNameW(NULL, exePath, MAX_PATH);
+			std::filesystem::path execDir = std::filesystem::path(exePath).parent_path();
+#else
+			std::error_code ec;
+			std::filesystem::path execDir = std::filesystem::read_symlink("/proc/self/exe", ec).parent_path();
+			if (ec) execDir = std::filesystem::current_path(ec);
+#endif
+			configFilePath = (execDir / "manga_reader_config.ini").wstring();
+		}
+		else
+		{
+			configFilePath = configPath;
+		}
+		loadConfig();
+	}
+
+	~ConfigManager() {
+		writer.stop();
+		saveConfig();
+	}
+
+	// Load configuration from INI file
+	bool loadConfig() {
+		configData.clear();
+
+		try
+		{
+			std::ifstream file(std::filesystem::path(configFilePath), std::ios::in);
+			if (!file.is_open())
+			{
+				// File doesn't exist yet, that's ok
+				return true;
+			}
+
+			std::string line;
+			std::string currentSection = "";
+
+			while (std::getline(file, line))
+			{
+				line = UnicodeUtils::trim(line);
+
+				// Skip empty lines and comments
+				if (line.empty() || line[0] == ';' || line[0] == '#')
+				{
+					continue;
+				}
+
+				// Check for section headers [section]
+				if (line[0] == '[' && line.back() == ']')
+				{
+					currentSection = line.substr(1, line.length() - 2);
+					continue;
+				}
+
+				// Parse key=value pairs
+				size_t equalPos = line.find('=');
+				if (equalPos != std::string::npos)
+				{
+					std::string key = UnicodeUtils::trim(line.substr(0, equalPos));
+					std::string value = UnicodeUtils::trim(line.substr(equalPos + 1));
+
+					// Remove quotes if present
+					if (value.length() >= 2 && value[0] == '"' && value.back() == '"')
+					{
+						value = value.substr(1, value.length() - 2);
+					}
+
+					// Store with section prefix if we have one
+					std::string fullKey = currentSection.empty() ? key : currentSection + "." + key;
+					configData[fullKey] = value;
+				}
+			}
+
+			file.close();
+			return true;
+
+		} catch (const std::exception& e)
+		{
+			return false;
+		}
+	}
+
+	// Save configuration to INI file now, on the calling thread
+	bool saveConfig() {
+		return writer.writeNow([this]() { return writeFile(configData); });
+	}
+
+	// Schedules a save on the background writer; repeated requests within the debounce window
+	// are coalesced into one write of the latest state
+	void requestSave() {
+		writer.request([this, snapshot = configData]() { return writeFile(snapshot); });
+	}
+
+	// Requests seen against files actually written, to check the coalescing
+	std::string getSaveStatsString() const {
+		return std::to_string(writer.getWriteCount()) + " writes for " + std::to_string(writer.getRequestCount()) + " requests";
+	}
+
+	// Get string value
+	std::string getString(const std::string& key, const std::string& defaultValue = "") {
+		auto it = configData.find(key);
+		return (it != configData.end()) ? it->second : defaultValue;
+	}
+
+	// Get wide string value
+	std::wstring getWString(const std::string& key, const std::wstring& defaultValue = L"") {
+		std::string value = getString(key);
+		return value.empty() ? defaultValue : UnicodeUtils::stringToWstring(value);
+	}
+
+	// Get integer value
+	int getInt(const std::string& key, int defaultValue = 0) {
+		std::string value = getString(key);
+		if (value.empty()) return defaultValue;
+
+		try
+		{
+			return std::stoi(value);
+		} catch (...)
+		{
+			return defaultValue;
+		}
+	}
+
+	// Get boolean value
+	bool getBool(const std::string& key, bool defaultValue = false) {
+		std::string value = getString(key);
+		if (value.empty()) return defaultValue;
+
+		std::transform(value.begin(), value.end(), value.begin(), ::tolower);
+		return (value == "true" || value == "1" || value == "yes" || value == "on");
+	}
+
+	// Get float value
+	float getFloat(const std::string& key, float defaultValue = 0.0f) {
+		std::string value = getString(key);
+		if (value.empty()) return defaultValue;
+
+		try
+		{
+			return std::stof(value);
+		} catch (...)
+		{
+			return defaultValue;
+		}
+	}
+
+	// Set string value
+	void setString(const std::string& key, const std::string& value) {
+		configData[key] = value;
+	}
+
+	// Set wide string value
+	void setWString(const std::string& key, const std::wstring& value) {
+		configData[key] = UnicodeUtils::wstringToString(value);
+	}
+
+	// Set integer value
+	void setInt(const std::string& key, int value) {
+		configData[key] = std::to_string(value);
+	}
+
+	// Set boolean value
+	void setBool(const std::string& key, bool value) {
+		configData[key] = value ? "true" : "false";
+	}
+
+	// Set float value
+	void setFloat(const std::string& key, float value) {
+		configData[key] = std::to_string(value);
+	}
+
+	// Check if key exists
+	bool hasKey(const std::string& key) {
+		return configData.find(key) != configData.end();
+	}
+
+	// Remove a key
+	void removeKey(const std::string& key) {
+		configData.erase(key);
+	}
+
+	// Get config file path
+	std::wstring getConfigFilePath() const {
+		return configFilePath;
+	}
+
+	// Force save config now
+	void forceSave() {
+		saveConfig();
+	}
+
+private:
+	// Writes data to a temporary file next to the INI and renames it over the old one, so a
+	// crash mid-write never leaves a truncated config behind
+	bool writeFile(const ConfigData& data) const {
+		try
+		{
+			std::filesystem::path target(configFilePath);
+			std::filesystem::path temporary = target;
+			temporary += L".tmp";
+
+			{
+				std::ofstream file(temporary, std::ios::trunc);
+				if (!file.is_open())
+				{
+					return false;
+				}
+
+				file << "; Manga Reader Configuration File\n";
+				file << "; Auto-generated - modify with care\n\n";
+
+				// Group by sections
+				std::map<std::string, std::map<std::string, std::string>> sections;
+
+				for (const auto& pair : data)
+				{
+					size_t dotPos = pair.first.find('.');
+					if (dotPos != std::string::npos)
+					{
+						std::string section = pair.first.substr(0, dotPos);
+						std::string key = pair.first.substr(dotPos + 1);
+						sections[section][key] = pair.second;
+					}
+					else
+					{
+						sections[""][pair.first] = pair.second;
+					}
+				}
+
+				// Write sections
+				for (const auto& section : sections)
+				{
+					if (!section.first.empty())
+					{
+						file << "[" << section.first << "]\n";
+					}
+
+					for (const auto& keyValue : section.second)
+					{
+						file << keyValue.first << "=" << keyValue.second << "\n";
+					}
+
+					file << "\n";
+				}
+
+				file.flush();
+				if (!file.good())
+				{
+					return false;
+				}
+			}
+
+			std::error_code ec;
+			std::filesystem::rename(temporary, target, ec);
+			if (ec)
+			{
+				return false;
+			}
+
+			return true;
+
+		} catch (const std::exception& e)
+		{
+			return false;
+		}
+	}
+};